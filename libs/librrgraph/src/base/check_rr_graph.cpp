@@ -1,5 +1,6 @@
 #include "physical_types.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 #include "vtr_util.h"
 
 #include "vpr_error.h"
@@ -10,6 +11,12 @@
 
 #include "describe_rr_node.h"
 
+#include <atomic>
+
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 /*********************** Subroutines local to this module *******************/
 
 static bool rr_node_is_global_clb_ipin(const RRGraphView& rr_graph, const DeviceGrid& grid, RRNodeId inode);
@@ -26,6 +33,21 @@ static void check_rr_edge(const RRGraphView& rr_graph,
                           int to_node,
                           bool is_flat);
 
+/* Number of nodes checked by a single (possibly concurrent) task */
+constexpr size_t CHECK_RR_GRAPH_CHUNK_SIZE = 4096;
+
+/* A problem found while checking the fan-in of the nodes. Only the first fringe
+ * warning found is reported. */
+enum class e_fan_in_message_type {
+    ERROR,
+    FRINGE_WARNING
+};
+
+struct t_fan_in_message {
+    e_fan_in_message_type type;
+    std::string text;
+};
+
 /************************ Subroutine definitions ****************************/
 
 class node_edge_sorter {
@@ -47,178 +69,304 @@ class node_edge_sorter {
     }
 };
 
-void check_rr_graph(const RRGraphView& rr_graph,
-                    const std::vector<t_physical_tile_type>& types,
-                    const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
-                    const DeviceGrid& grid,
-                    const VibDeviceGrid& vib_grid,
-                    const t_chan_width& chan_width,
-                    const e_graph_type graph_type,
-                    bool is_flat) {
-    e_route_type route_type = e_route_type::DETAILED;
-    if (graph_type == e_graph_type::GLOBAL) {
-        route_type = e_route_type::GLOBAL;
-    }
-
-    std::vector<int> total_edges_to_node(rr_graph.num_nodes());
-    std::vector<unsigned char> switch_types_from_current_to_node(rr_graph.num_nodes());
+/* Checks rr_node and its fan-out edges, and counts its edges into total_edges_to_node.
+ * edges is scratch space, passed in to avoid re-allocating it for every node. */
+static void check_rr_node_connectivity(const RRGraphView& rr_graph,
+                                       const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                                       const DeviceGrid& grid,
+                                       const VibDeviceGrid& vib_grid,
+                                       const t_chan_width& chan_width,
+                                       const e_route_type route_type,
+                                       bool is_flat,
+                                       const RRNodeId rr_node,
+                                       std::vector<std::pair<int, int>>& edges,
+                                       std::vector<int>& total_edges_to_node) {
     const int num_rr_switches = rr_graph.num_rr_switches();
 
-    std::vector<std::pair<int, int>> edges;
+    size_t inode = (size_t)rr_node;
+    rr_graph.validate_node(rr_node);
 
-    for (const RRNodeId rr_node : rr_graph.nodes()) {
-        size_t inode = (size_t)rr_node;
-        rr_graph.validate_node(rr_node);
+    /* Ignore any uninitialized rr_graph nodes */
+    if (!rr_graph.node_is_initialized(rr_node)) {
+        return;
+    }
 
-        /* Ignore any uninitialized rr_graph nodes */
-        if (!rr_graph.node_is_initialized(rr_node)) {
-            continue;
-        }
+    // Virtual clock network sink is special, ignore.
+    if (rr_graph.is_virtual_clock_network_root(rr_node)) {
+        return;
+    }
 
-        // Virtual clock network sink is special, ignore.
-        if (rr_graph.is_virtual_clock_network_root(rr_node)) {
-            continue;
-        }
+    e_rr_type rr_type = rr_graph.node_type(rr_node);
+    int num_edges = rr_graph.num_edges(RRNodeId(inode));
 
-        e_rr_type rr_type = rr_graph.node_type(rr_node);
-        int num_edges = rr_graph.num_edges(RRNodeId(inode));
+    check_rr_node(rr_graph, rr_indexed_data, grid, vib_grid, chan_width, route_type, inode, is_flat);
 
-        check_rr_node(rr_graph, rr_indexed_data, grid, vib_grid, chan_width, route_type, inode, is_flat);
+    // Check all the connectivity (edges, etc.) information.
+    edges.resize(0);
+    edges.reserve(num_edges);
 
-        // Check all the connectivity (edges, etc.) information.
-        edges.resize(0);
-        edges.reserve(num_edges);
+    for (int iedge = 0; iedge < num_edges; iedge++) {
+        int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
 
-        for (int iedge = 0; iedge < num_edges; iedge++) {
-            int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
+        if (to_node < 0 || to_node >= (int)rr_graph.num_nodes()) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_rr_graph: node %d has an edge %d.\n"
+                            "\tEdge is out of range.\n",
+                            inode, to_node);
+        }
 
-            if (to_node < 0 || to_node >= (int)rr_graph.num_nodes()) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_rr_graph: node %d has an edge %d.\n"
-                                "\tEdge is out of range.\n",
-                                inode, to_node);
-            }
+        check_rr_edge(rr_graph,
+                      grid,
+                      rr_indexed_data,
+                      inode,
+                      iedge,
+                      to_node,
+                      is_flat);
 
-            check_rr_edge(rr_graph,
-                          grid,
-                          rr_indexed_data,
-                          inode,
-                          iedge,
-                          to_node,
-                          is_flat);
+        edges.emplace_back(to_node, iedge);
+        // Nodes are checked concurrently, so several of them may count edges to the same node
+        std::atomic_ref<int>(total_edges_to_node[to_node]).fetch_add(1, std::memory_order_relaxed);
 
-            edges.emplace_back(to_node, iedge);
-            total_edges_to_node[to_node]++;
+        auto switch_type = rr_graph.edge_switch(rr_node, iedge);
 
-            auto switch_type = rr_graph.edge_switch(rr_node, iedge);
+        if (switch_type < 0 || switch_type >= num_rr_switches) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_rr_graph: node %d has a switch type %d.\n"
+                            "\tSwitch type is out of range.\n",
+                            inode, switch_type);
+        }
+    } /* End for all edges of node. */
 
-            if (switch_type < 0 || switch_type >= num_rr_switches) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_rr_graph: node %d has a switch type %d.\n"
-                                "\tSwitch type is out of range.\n",
-                                inode, switch_type);
-            }
-        } /* End for all edges of node. */
+    std::sort(edges.begin(), edges.end(), [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    //Check that multiple edges between the same from/to nodes make sense
+    for (int iedge = 0; iedge < num_edges; iedge++) {
+        int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
+
+        auto range = std::equal_range(edges.begin(), edges.end(),
+                                      to_node, node_edge_sorter());
+
+        size_t num_edges_to_node = std::distance(range.first, range.second);
+
+        if (num_edges_to_node == 1) continue; //Single edges are always OK
+
+        VTR_ASSERT_MSG(num_edges_to_node > 1, "Expect multiple edges");
+
+        e_rr_type to_rr_type = rr_graph.node_type(RRNodeId(to_node));
+
+        /* It is unusual to have more than one programmable switch (in the same direction) between a from_node and a to_node,
+         * as the duplicate switch doesn't add more routing flexibility.
+         *
+         * However, such duplicate switches can occur for some types of nodes, which we allow below.
+         * Reasons one could have duplicate switches between two nodes include:
+         *      - The two switches have different electrical characteristics.
+         *      - Wires near the edges of an FPGA are often cut off, and the stubs connected together.
+         *        A regular switch pattern could then result in one physical wire connecting multiple
+         *        times to other wires, IPINs or OPINs.
+         *
+         * Only expect the following cases to have multiple edges
+         * - CHAN <-> CHAN connections
+         * - CHAN  -> IPIN connections (unique rr_node for IPIN nodes on multiple sides)
+         * - OPIN  -> CHAN connections (unique rr_node for OPIN nodes on multiple sides)
+         */
+        bool is_chan_to_chan = (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY) && (to_rr_type == e_rr_type::CHANY || to_rr_type == e_rr_type::CHANX);
+        bool is_chan_to_ipin = (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY) && to_rr_type == e_rr_type::IPIN;
+        bool is_opin_to_chan = rr_type == e_rr_type::OPIN && (to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY);
+        bool is_internal_edge = false;
+        if (is_flat) {
+            is_internal_edge = (rr_type == e_rr_type::IPIN && to_rr_type == e_rr_type::IPIN) || (rr_type == e_rr_type::OPIN && to_rr_type == e_rr_type::OPIN);
+        }
+        if (!(is_chan_to_chan || is_chan_to_ipin || is_opin_to_chan || is_internal_edge)) {
+            VPR_ERROR(VPR_ERROR_ROUTE,
+                      "in check_rr_graph: node %d (%s) connects to node %d (%s) %zu times - multi-connections only expected for CHAN<->CHAN, CHAN->IPIN, OPIN->CHAN.\n",
+                      inode, rr_node_typename[rr_type], to_node, rr_node_typename[to_rr_type], num_edges_to_node);
+        }
 
-        std::sort(edges.begin(), edges.end(), [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
-            return lhs.first < rhs.first;
-        });
+        // Between two wire segments
+        VTR_ASSERT_MSG(to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY || to_rr_type == e_rr_type::IPIN, "Expect channel type or input pin type");
+        VTR_ASSERT_MSG(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY || rr_type == e_rr_type::OPIN, "Expect channel type or output pin type");
 
-        //Check that multiple edges between the same from/to nodes make sense
-        for (int iedge = 0; iedge < num_edges; iedge++) {
-            int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
+        //While multiple connections between the same wires can be electrically legal,
+        //they are redundant if they are of the same switch type.
+        //
+        //Identify any such edges with identical switches
+        std::map<short, int> switch_counts;
+        for (const auto& to_edge : vtr::Range<std::vector<std::pair<int, int>>::const_iterator>(range.first, range.second)) {
+            auto edge = to_edge.second;
+            auto edge_switch = rr_graph.edge_switch(rr_node, edge);
 
-            auto range = std::equal_range(edges.begin(), edges.end(),
-                                          to_node, node_edge_sorter());
+            switch_counts[edge_switch]++;
+        }
 
-            size_t num_edges_to_node = std::distance(range.first, range.second);
+        //Tell the user about any redundant edges
+        for (auto kv : switch_counts) {
+            if (kv.second <= 1) continue;
 
-            if (num_edges_to_node == 1) continue; //Single edges are always OK
+            /* Redundant edges are not allowed for chan <-> chan connections
+             * but allowed for input pin <-> chan or output pin <-> chan connections 
+             */
+            if ((to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY)
+                && (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY)) {
+                e_switch_type switch_type = rr_graph.rr_switch_inf(RRSwitchId(kv.first)).type();
 
-            VTR_ASSERT_MSG(num_edges_to_node > 1, "Expect multiple edges");
+                VPR_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d has %d redundant connections to node %d of switch type %d (%s)",
+                          inode, kv.second, to_node, kv.first, SWITCH_TYPE_STRINGS[size_t(switch_type)]);
+            }
+        }
+    }
 
-            e_rr_type to_rr_type = rr_graph.node_type(RRNodeId(to_node));
+    /* Slow test could leave commented out most of the time. */
+    check_unbuffered_edges(rr_graph, inode);
 
-            /* It is unusual to have more than one programmable switch (in the same direction) between a from_node and a to_node,
-             * as the duplicate switch doesn't add more routing flexibility.
-             *
-             * However, such duplicate switches can occur for some types of nodes, which we allow below.
-             * Reasons one could have duplicate switches between two nodes include:
-             *      - The two switches have different electrical characteristics.
-             *      - Wires near the edges of an FPGA are often cut off, and the stubs connected together.
-             *        A regular switch pattern could then result in one physical wire connecting multiple
-             *        times to other wires, IPINs or OPINs.
-             *
-             * Only expect the following cases to have multiple edges
-             * - CHAN <-> CHAN connections
-             * - CHAN  -> IPIN connections (unique rr_node for IPIN nodes on multiple sides)
-             * - OPIN  -> CHAN connections (unique rr_node for OPIN nodes on multiple sides)
-             */
-            bool is_chan_to_chan = (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY) && (to_rr_type == e_rr_type::CHANY || to_rr_type == e_rr_type::CHANX);
-            bool is_chan_to_ipin = (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY) && to_rr_type == e_rr_type::IPIN;
-            bool is_opin_to_chan = rr_type == e_rr_type::OPIN && (to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY);
-            bool is_internal_edge = false;
-            if (is_flat) {
-                is_internal_edge = (rr_type == e_rr_type::IPIN && to_rr_type == e_rr_type::IPIN) || (rr_type == e_rr_type::OPIN && to_rr_type == e_rr_type::OPIN);
-            }
-            if (!(is_chan_to_chan || is_chan_to_ipin || is_opin_to_chan || is_internal_edge)) {
-                VPR_ERROR(VPR_ERROR_ROUTE,
-                          "in check_rr_graph: node %d (%s) connects to node %d (%s) %zu times - multi-connections only expected for CHAN<->CHAN, CHAN->IPIN, OPIN->CHAN.\n",
-                          inode, rr_node_typename[rr_type], to_node, rr_node_typename[to_rr_type], num_edges_to_node);
-            }
+    //Check that all config/non-config edges are appropriately organized
+    for (t_edge_size edge : rr_graph.configurable_edges(RRNodeId(inode))) {
+        if (!rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is non-configurable, but in configurable edges",
+                            inode, edge);
+        }
+    }
 
-            // Between two wire segments
-            VTR_ASSERT_MSG(to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY || to_rr_type == e_rr_type::IPIN, "Expect channel type or input pin type");
-            VTR_ASSERT_MSG(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY || rr_type == e_rr_type::OPIN, "Expect channel type or output pin type");
+    for (t_edge_size edge : rr_graph.non_configurable_edges(RRNodeId(inode))) {
+        if (rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is configurable, but in non-configurable edges",
+                            inode, edge);
+        }
+    }
+}
 
-            //While multiple connections between the same wires can be electrically legal,
-            //they are redundant if they are of the same switch type.
-            //
-            //Identify any such edges with identical switches
-            std::map<short, int> switch_counts;
-            for (const auto& to_edge : vtr::Range<decltype(edges)::const_iterator>(range.first, range.second)) {
-                auto edge = to_edge.second;
-                auto edge_switch = rr_graph.edge_switch(rr_node, edge);
+/* Checks that rr_node is reachable, given the number of edges to each node,
+ * appending any problem found to messages. Only one fringe warning is recorded
+ * (tracked by is_fringe_warning_found). */
+static void check_rr_node_fan_in(const RRGraphView& rr_graph,
+                                 const std::vector<t_physical_tile_type>& types,
+                                 const DeviceGrid& grid,
+                                 const std::vector<int>& total_edges_to_node,
+                                 bool is_flat,
+                                 const RRNodeId rr_node,
+                                 std::vector<t_fan_in_message>& messages,
+                                 bool& is_fringe_warning_found) {
+    size_t inode = (size_t)rr_node;
+    e_rr_type rr_type = rr_graph.node_type(rr_node);
+    int ptc_num = rr_graph.node_ptc_num(rr_node);
+    int layer_num = rr_graph.node_layer(rr_node);
+    int xlow = rr_graph.node_xlow(rr_node);
+    int ylow = rr_graph.node_ylow(rr_node);
 
-                switch_counts[edge_switch]++;
-            }
+    t_physical_tile_type_ptr type = grid.get_physical_type({xlow, ylow, layer_num});
 
-            //Tell the user about any redundant edges
-            for (auto kv : switch_counts) {
-                if (kv.second <= 1) continue;
+    if (rr_type == e_rr_type::IPIN || rr_type == e_rr_type::OPIN) {
+        // #TODO: No edges are added for internal pins. However, they need to be checked somehow!
+        if (ptc_num >= type->num_pins) {
+            messages.push_back({e_fan_in_message_type::ERROR,
+                                vtr::string_fmt("in check_rr_graph: node %d (%s) type: %s is internal node.\n",
+                                                inode, rr_graph.node_type_string(rr_node), rr_node_typename[rr_type])});
+        }
+    }
 
-                /* Redundant edges are not allowed for chan <-> chan connections
-                 * but allowed for input pin <-> chan or output pin <-> chan connections 
-                 */
-                if ((to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY)
-                    && (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY)) {
-                    e_switch_type switch_type = rr_graph.rr_switch_inf(RRSwitchId(kv.first)).type();
+    if (rr_type != e_rr_type::SOURCE) {
+        if (total_edges_to_node[inode] < 1 && !rr_node_is_global_clb_ipin(rr_graph, grid, rr_node)) {
+            /* A global CLB input pin will not have any edges, and neither will  *
+             * a SOURCE or the start of a carry-chain.  Anything else is an error.
+             * For simplicity, carry-chain input pin are entirely ignored in this test
+             */
+            bool is_chain = false;
+            if (rr_type == e_rr_type::IPIN) {
+                for (const t_fc_specification& fc_spec : types[type->index].fc_specs) {
+                    if (fc_spec.fc_value == 0 && fc_spec.seg_index == 0) {
+                        is_chain = true;
+                    }
+                }
+            }
 
-                    VPR_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d has %d redundant connections to node %d of switch type %d (%s)",
-                              inode, kv.second, to_node, kv.first, SWITCH_TYPE_STRINGS[size_t(switch_type)]);
+            const t_rr_node& node = rr_graph.rr_nodes()[inode];
+
+            bool is_fringe = ((rr_graph.node_xlow(rr_node) == 1)
+                              || (rr_graph.node_ylow(rr_node) == 1)
+                              || (rr_graph.node_xhigh(rr_node) == int(grid.width()) - 2)
+                              || (rr_graph.node_yhigh(rr_node) == int(grid.height()) - 2));
+            bool is_wire = (rr_graph.node_type(rr_node) == e_rr_type::CHANX
+                            || rr_graph.node_type(rr_node) == e_rr_type::CHANY
+                            || rr_graph.node_type(rr_node) == e_rr_type::MUX);
+
+            if (!is_chain && !is_fringe && !is_wire) {
+                if (rr_graph.node_type(rr_node) == e_rr_type::IPIN || rr_graph.node_type(rr_node) == e_rr_type::OPIN) {
+                    if (has_adjacent_channel(rr_graph, grid, node)) {
+                        auto block_type = grid.get_physical_type({rr_graph.node_xlow(rr_node),
+                                                                  rr_graph.node_ylow(rr_node),
+                                                                  rr_graph.node_layer(rr_node)});
+                        std::string pin_name = block_type_pin_index_to_name(block_type, rr_graph.node_pin_num(rr_node), is_flat);
+                        /* Print error messages for all the sides that a node may appear */
+                        for (const e_side& node_side : TOTAL_2D_SIDES) {
+                            if (!rr_graph.is_node_on_specific_side(rr_node, node_side)) {
+                                continue;
+                            }
+                            messages.push_back({e_fan_in_message_type::ERROR,
+                                                vtr::string_fmt("in check_rr_graph: node %d (%s) at (%d,%d) block=%s side=%s pin=%s has no fanin.\n",
+                                                                inode, rr_graph.node_type_string(rr_node), rr_graph.node_xlow(rr_node), rr_graph.node_ylow(rr_node), block_type->name.c_str(), TOTAL_2D_SIDE_STRINGS[node_side], pin_name.c_str())});
+                        }
+                    }
+                } else {
+                    messages.push_back({e_fan_in_message_type::ERROR,
+                                        vtr::string_fmt("in check_rr_graph: node %d (%s) has no fanin.\n",
+                                                        inode, rr_graph.node_type_string(rr_node))});
                 }
+            } else if (!is_chain && !is_fringe_warning_found) {
+                messages.push_back({e_fan_in_message_type::FRINGE_WARNING,
+                                    vtr::string_fmt("in check_rr_graph: fringe node %d %s at (%d,%d) has no fanin.\n"
+                                                    "\t This is possible on a fringe node based on low Fc_out, N, and certain lengths.\n",
+                                                    inode, rr_graph.node_type_string(rr_node), rr_graph.node_xlow(rr_node), rr_graph.node_ylow(rr_node))});
+                is_fringe_warning_found = true;
             }
         }
+    } else { /* SOURCE.  No fanin for now; change if feedthroughs allowed. */
+        if (total_edges_to_node[inode] != 0) {
+            messages.push_back({e_fan_in_message_type::ERROR,
+                                vtr::string_fmt("in check_rr_graph: SOURCE node %d has a fanin of %d, expected 0.\n",
+                                                inode, total_edges_to_node[inode])});
+        }
+    }
+}
+
+void check_rr_graph(const RRGraphView& rr_graph,
+                    const std::vector<t_physical_tile_type>& types,
+                    const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                    const DeviceGrid& grid,
+                    const VibDeviceGrid& vib_grid,
+                    const t_chan_width& chan_width,
+                    const e_graph_type graph_type,
+                    bool is_flat) {
+    e_route_type route_type = e_route_type::DETAILED;
+    if (graph_type == e_graph_type::GLOBAL) {
+        route_type = e_route_type::GLOBAL;
+    }
 
-        /* Slow test could leave commented out most of the time. */
-        check_unbuffered_edges(rr_graph, inode);
+    std::vector<int> total_edges_to_node(rr_graph.num_nodes());
 
-        //Check that all config/non-config edges are appropriately organized
-        for (t_edge_size edge : rr_graph.configurable_edges(RRNodeId(inode))) {
-            if (!rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is non-configurable, but in configurable edges",
-                                inode, edge);
-            }
+    // The nodes are checked in fixed size chunks. With TBB the chunks are checked
+    // concurrently, and the error of the lowest failing node is reported, which is
+    // the error a serial check would have stopped at.
+    const size_t num_nodes = rr_graph.num_nodes();
+    const size_t num_chunks = (num_nodes + CHECK_RR_GRAPH_CHUNK_SIZE - 1) / CHECK_RR_GRAPH_CHUNK_SIZE;
+
+    auto check_chunk_connectivity = [&](size_t ichunk) {
+        std::vector<std::pair<int, int>> edges;
+        size_t chunk_end = std::min(num_nodes, (ichunk + 1) * CHECK_RR_GRAPH_CHUNK_SIZE);
+        for (size_t inode = ichunk * CHECK_RR_GRAPH_CHUNK_SIZE; inode < chunk_end; ++inode) {
+            check_rr_node_connectivity(rr_graph, rr_indexed_data, grid, vib_grid, chan_width, route_type, is_flat,
+                                       RRNodeId(inode), edges, total_edges_to_node);
         }
+    };
 
-        for (t_edge_size edge : rr_graph.non_configurable_edges(RRNodeId(inode))) {
-            if (rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is configurable, but in non-configurable edges",
-                                inode, edge);
-            }
+    // Demoted errors are logged as warnings as they are found, so keep them in order
+    if (has_demoted_errors()) {
+        for (size_t ichunk = 0; ichunk < num_chunks; ++ichunk) {
+            check_chunk_connectivity(ichunk);
         }
-
-    } /* End for all rr_nodes */
+    } else {
+        vtr::parallel_for_first_error(num_chunks, check_chunk_connectivity);
+    }
 
     // AM: For the time being, if is_flat is enabled, we don't have proper tests to check whether a node should have an incoming
     // edge or not
@@ -227,88 +375,37 @@ void check_rr_graph(const RRGraphView& rr_graph,
     }
 
     /* I built a list of how many edges went to everything in the code above -- *
-     * now I check that everything is reachable.                                */
-    bool is_fringe_warning_sent = false;
-
-    for (const RRNodeId rr_node : rr_graph.nodes()) {
-        size_t inode = (size_t)rr_node;
-        e_rr_type rr_type = rr_graph.node_type(rr_node);
-        int ptc_num = rr_graph.node_ptc_num(rr_node);
-        int layer_num = rr_graph.node_layer(rr_node);
-        int xlow = rr_graph.node_xlow(rr_node);
-        int ylow = rr_graph.node_ylow(rr_node);
-
-        t_physical_tile_type_ptr type = grid.get_physical_type({xlow, ylow, layer_num});
-
-        if (rr_type == e_rr_type::IPIN || rr_type == e_rr_type::OPIN) {
-            // #TODO: No edges are added for internal pins. However, they need to be checked somehow!
-            if (ptc_num >= type->num_pins) {
-                VTR_LOG_ERROR("in check_rr_graph: node %d (%s) type: %s is internal node.\n",
-                              inode, rr_graph.node_type_string(rr_node), rr_node_typename[rr_type]);
-            }
+     * now I check that everything is reachable.                                 *
+     * The problems found in each chunk are collected and reported in node order. */
+    std::vector<std::vector<t_fan_in_message>> chunk_messages(num_chunks);
+    auto check_chunk_fan_in = [&](size_t ichunk) {
+        bool is_fringe_warning_found = false;
+        size_t chunk_end = std::min(num_nodes, (ichunk + 1) * CHECK_RR_GRAPH_CHUNK_SIZE);
+        for (size_t inode = ichunk * CHECK_RR_GRAPH_CHUNK_SIZE; inode < chunk_end; ++inode) {
+            check_rr_node_fan_in(rr_graph, types, grid, total_edges_to_node, is_flat, RRNodeId(inode),
+                                 chunk_messages[ichunk], is_fringe_warning_found);
         }
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_chunks, check_chunk_fan_in);
+#else
+    for (size_t ichunk = 0; ichunk < num_chunks; ++ichunk) {
+        check_chunk_fan_in(ichunk);
+    }
+#endif
 
-        if (rr_type != e_rr_type::SOURCE) {
-            if (total_edges_to_node[inode] < 1 && !rr_node_is_global_clb_ipin(rr_graph, grid, rr_node)) {
-                /* A global CLB input pin will not have any edges, and neither will  *
-                 * a SOURCE or the start of a carry-chain.  Anything else is an error.
-                 * For simplicity, carry-chain input pin are entirely ignored in this test
-                 */
-                bool is_chain = false;
-                if (rr_type == e_rr_type::IPIN) {
-                    for (const t_fc_specification& fc_spec : types[type->index].fc_specs) {
-                        if (fc_spec.fc_value == 0 && fc_spec.seg_index == 0) {
-                            is_chain = true;
-                        }
-                    }
-                }
-
-                const t_rr_node& node = rr_graph.rr_nodes()[inode];
-
-                bool is_fringe = ((rr_graph.node_xlow(rr_node) == 1)
-                                  || (rr_graph.node_ylow(rr_node) == 1)
-                                  || (rr_graph.node_xhigh(rr_node) == int(grid.width()) - 2)
-                                  || (rr_graph.node_yhigh(rr_node) == int(grid.height()) - 2));
-                bool is_wire = (rr_graph.node_type(rr_node) == e_rr_type::CHANX
-                                || rr_graph.node_type(rr_node) == e_rr_type::CHANY
-                                || rr_graph.node_type(rr_node) == e_rr_type::MUX);
-
-                if (!is_chain && !is_fringe && !is_wire) {
-                    if (rr_graph.node_type(rr_node) == e_rr_type::IPIN || rr_graph.node_type(rr_node) == e_rr_type::OPIN) {
-                        if (has_adjacent_channel(rr_graph, grid, node)) {
-                            auto block_type = grid.get_physical_type({rr_graph.node_xlow(rr_node),
-                                                                      rr_graph.node_ylow(rr_node),
-                                                                      rr_graph.node_layer(rr_node)});
-                            std::string pin_name = block_type_pin_index_to_name(block_type, rr_graph.node_pin_num(rr_node), is_flat);
-                            /* Print error messages for all the sides that a node may appear */
-                            for (const e_side& node_side : TOTAL_2D_SIDES) {
-                                if (!rr_graph.is_node_on_specific_side(rr_node, node_side)) {
-                                    continue;
-                                }
-                                VTR_LOG_ERROR("in check_rr_graph: node %d (%s) at (%d,%d) block=%s side=%s pin=%s has no fanin.\n",
-                                              inode, rr_graph.node_type_string(rr_node), rr_graph.node_xlow(rr_node), rr_graph.node_ylow(rr_node), block_type->name.c_str(), TOTAL_2D_SIDE_STRINGS[node_side], pin_name.c_str());
-                            }
-                        }
-                    } else {
-                        VTR_LOG_ERROR("in check_rr_graph: node %d (%s) has no fanin.\n",
-                                      inode, rr_graph.node_type_string(rr_node));
-                    }
-                } else if (!is_chain && !is_fringe_warning_sent) {
-                    VTR_LOG_WARN(
-                        "in check_rr_graph: fringe node %d %s at (%d,%d) has no fanin.\n"
-                        "\t This is possible on a fringe node based on low Fc_out, N, and certain lengths.\n",
-                        inode, rr_graph.node_type_string(rr_node), rr_graph.node_xlow(rr_node), rr_graph.node_ylow(rr_node));
-                    is_fringe_warning_sent = true;
-                }
-            }
-        } else { /* SOURCE.  No fanin for now; change if feedthroughs allowed. */
-            if (total_edges_to_node[inode] != 0) {
-                VTR_LOG_ERROR("in check_rr_graph: SOURCE node %d has a fanin of %d, expected 0.\n",
-                              inode, total_edges_to_node[inode]);
+    bool is_fringe_warning_sent = false;
+    for (const std::vector<t_fan_in_message>& messages : chunk_messages) {
+        for (const t_fan_in_message& message : messages) {
+            if (message.type == e_fan_in_message_type::ERROR) {
+                VTR_LOG_ERROR("%s", message.text.c_str());
+            } else if (!is_fringe_warning_sent) {
+                VTR_ASSERT(message.type == e_fan_in_message_type::FRINGE_WARNING);
+                VTR_LOG_WARN("%s", message.text.c_str());
+                is_fringe_warning_sent = true;
             }
         }
     }
-
 }
 
 static bool rr_node_is_global_clb_ipin(const RRGraphView& rr_graph, const DeviceGrid& grid, RRNodeId inode) {
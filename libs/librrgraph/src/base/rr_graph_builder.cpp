@@ -194,6 +194,12 @@ void RRGraphBuilder::create_edge(RRNodeId src, RRNodeId dest, RRSwitchId edge_sw
     is_incoming_edge_dirty_ = true;
 }
 
+void RRGraphBuilder::create_edges_in_cache(const t_rr_edge_info_set& edges) {
+    edges_to_build_.insert(edges_to_build_.end(), edges.begin(), edges.end());
+    is_edge_dirty_ = true;
+    is_incoming_edge_dirty_ = true;
+}
+
 void RRGraphBuilder::build_edges(const bool& uniquify) {
     if (uniquify) {
         std::sort(edges_to_build_.begin(), edges_to_build_.end());
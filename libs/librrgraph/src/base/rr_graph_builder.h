@@ -302,6 +302,10 @@ class RRGraphBuilder {
      *  @note This will not add an edge to storage! You need to call build_edges() after all the edges are cached! */
     void create_edge(RRNodeId src, RRNodeId dest, RRSwitchId edge_switch, bool remapped);
 
+    /** @brief Append a set of edges, in order, to the cache of edges to be built
+     *  @note This will not add the edges to storage. You need to call build_edges() after all the edges are cached. */
+    void create_edges_in_cache(const t_rr_edge_info_set& edges);
+
     /** @brief Allocate and build actual edges in storage. 
      * Once called, the cached edges will be uniquified and added to routing resource nodes, 
      * while the cache will be empty once build-up is accomplished 
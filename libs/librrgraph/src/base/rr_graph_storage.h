@@ -851,10 +851,12 @@ class t_rr_graph_storage {
     }
 
   private:
-    friend struct edge_swapper;
-    friend class edge_sort_iterator;
-    friend class edge_compare_dest_node;
-    friend class edge_compare_src_node_and_configurable_first;
+    /** @brief
+     * Sorts the edge data arrays according to edge_less, a strict weak ordering
+     * of RREdgeIds. Equivalent edges keep their relative order, as with std::stable_sort.
+     */
+    template<typename EdgeLess>
+    void stable_sort_edges(EdgeLess edge_less);
 
     /** @brief
      * Take allocated edges in edge_src_node_/ edge_dest_node_ / edge_switch_
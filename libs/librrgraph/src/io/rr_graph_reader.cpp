@@ -17,6 +17,7 @@
 
 #include "rr_graph_uxsdcxx_serializer.h"
 #include "rr_graph_uxsdcxx.h"
+#include "rr_graph_xml_stream.h"
 
 #include <fstream>
 #include <utility>
@@ -112,9 +113,10 @@ void load_rr_file(RRGraphBuilder* rr_graph_builder,
 
     if (vtr::check_file_name_extension(read_rr_graph_name, ".xml")) {
         try {
-            std::ifstream file(read_rr_graph_name);
+            // Stream the file rather than building a DOM of it, so that memory
+            // usage does not grow with the size of the file.
             void* context;
-            uxsd::load_rr_graph_xml(reader, context, read_rr_graph_name, file);
+            load_rr_graph_xml_stream(reader, context, read_rr_graph_name);
         } catch (pugiutil::XmlError& e) {
             vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, e.line(), "%s", e.what());
         }
@@ -887,6 +887,11 @@ class RrGraphSerializer final : public uxsd::RrGraphBase<RrGraphContextTypes> {
         // amoritized O(1).
         const auto& rr_graph = (*rr_graph_);
         rr_nodes_->make_room_for_node(RRNodeId(id));
+        // The ptc nums are also only sized by preallocate_rr_nodes_node, so
+        // grow them along with the nodes.
+        if (rr_graph_builder_->node_ptc_storage().size() < rr_nodes_->size()) {
+            rr_graph_builder_->resize_node_ptc_nums(rr_nodes_->size());
+        }
         auto node = (*rr_nodes_)[id];
         RRNodeId node_id = node.id();
 
@@ -10,6 +10,7 @@
 #include <cstdio>
 #include <fstream>
 #include <limits>
+#include <vector>
 #include "rr_graph_uxsdcxx_serializer.h"
 #include "rr_graph_uxsdcxx.h"
 #ifdef VTR_ENABLE_CAPNPROTO
@@ -67,7 +68,11 @@ void write_rr_graph(RRGraphBuilder* rr_graph_builder,
         is_flat);
 
     if (vtr::check_file_name_extension(file_name, ".xml")) {
+        // Use a large output buffer; the graph is written as a long stream of
+        // small formatted writes.
+        std::vector<char> write_buffer(1 << 20);
         std::fstream fp;
+        fp.rdbuf()->pubsetbuf(write_buffer.data(), write_buffer.size());
         fp.open(file_name, std::fstream::out | std::fstream::trunc);
         fp.precision(std::numeric_limits<float>::max_digits10);
         void* context;
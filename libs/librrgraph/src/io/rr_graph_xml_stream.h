@@ -0,0 +1,530 @@
+#pragma once
+/**
+ * @file
+ * @brief Streaming loader for RR graph XML files.
+ *
+ * The loader drives the same uxsdcxx interface (e.g. RrGraphSerializer) as
+ * the generated uxsd::load_rr_graph_xml, but does not build a pugixml DOM of
+ * the whole file:
+ *  - <rr_nodes> and <rr_edges>, which make up nearly all of a large RR graph
+ *    file, are parsed element by element from an XmlStreamTokenizer.
+ *  - The remaining top-level sections (channels, switches, segments,
+ *    block_types, grid) and any <metadata> blocks are small; each of them is
+ *    captured on its own and handed to the generated DOM loader, so they keep
+ *    exactly the generated validation.
+ *
+ * Peak memory is therefore bounded by the largest of the small sections
+ * instead of several times the file size.
+ */
+
+#include <bitset>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "pugixml.hpp"
+#include "rr_graph_uxsdcxx.h"
+#include "xml_stream_tokenizer.h"
+
+namespace rr_graph_xml_stream_impl {
+
+/**
+ * @brief Parses xml (the raw text of a single element) into doc and returns
+ *        its root element. base_offset is the file offset of the element, used
+ *        to report parse errors at the right line.
+ */
+inline pugi::xml_node parse_captured_element(pugi::xml_document& doc,
+                                             const std::string& xml,
+                                             std::ptrdiff_t base_offset,
+                                             std::ptrdiff_t* offset_debug,
+                                             const std::function<void(const char*)>* report_error) {
+    pugi::xml_parse_result result = doc.load_buffer(xml.data(), xml.size());
+    if (!result) {
+        *offset_debug = base_offset + result.offset;
+        uxsd::noreturn_report(report_error, (std::string("Unable to parse XML: ") + result.description()).c_str());
+    }
+    return doc.first_child();
+}
+
+/**
+ * @brief Calls the generated DOM loader load_fn on the element whose start tag
+ *        was just returned by tokens, after capturing it on its own.
+ */
+template<typename LoadFn>
+inline void load_captured_element(XmlStreamTokenizer& tokens,
+                                  std::ptrdiff_t* offset_debug,
+                                  std::ptrdiff_t* base_offset,
+                                  const std::function<void(const char*)>* report_error,
+                                  LoadFn load_fn) {
+    std::ptrdiff_t element_offset = tokens.offset();
+    std::string xml = tokens.capture_element();
+
+    pugi::xml_document doc;
+    pugi::xml_node root = parse_captured_element(doc, xml, element_offset, offset_debug, report_error);
+
+    //Offsets reported by pugixml are relative to the captured text
+    *base_offset = element_offset;
+    load_fn(root);
+    *base_offset = 0;
+}
+
+/**
+ * @brief Consumes the end of an element which may not have child elements
+ *        (i.e. <a/> or <a>text</a>), reporting an error otherwise.
+ */
+inline void expect_no_child_element(XmlStreamTokenizer& tokens, const char* element_name, const std::function<void(const char*)>* report_error) {
+    while (true) {
+        switch (tokens.next()) {
+            case XmlStreamTokenizer::e_token::END_ELEMENT:
+                return;
+            case XmlStreamTokenizer::e_token::TEXT:
+                break;
+            default:
+                uxsd::noreturn_report(report_error, ("Unexpected child element in <" + std::string(element_name) + ">.").c_str());
+        }
+    }
+}
+
+/**
+ * @brief Checks that the tokenizer is positioned on a TEXT token which is
+ *        only whitespace (as pugixml would drop it).
+ */
+inline void expect_whitespace(XmlStreamTokenizer& tokens, const char* element_name, const std::function<void(const char*)>* report_error) {
+    if (!tokens.text_is_whitespace()) {
+        uxsd::noreturn_report(report_error, ("Unexpected text in <" + std::string(element_name) + ">.").c_str());
+    }
+}
+
+template<class T, typename Context>
+inline void load_node_loc(XmlStreamTokenizer& tokens, T& out, Context& context, const std::function<void(const char*)>* report_error) {
+    using namespace uxsd;
+    int xhigh = 0;
+    int xlow = 0;
+    int yhigh = 0;
+    int ylow = 0;
+
+    std::bitset<7> astate = 0;
+    for (size_t i = 0; i < tokens.num_attributes(); ++i) {
+        atok_t_node_loc in = lex_attr_t_node_loc(tokens.attribute_name(i), report_error);
+        if (astate[(int)in] == 0) astate[(int)in] = 1;
+        else noreturn_report(report_error, ("Duplicate attribute " + std::string(tokens.attribute_name(i)) + " in <node_loc>.").c_str());
+        switch (in) {
+            case atok_t_node_loc::XHIGH:
+                xhigh = load_int(tokens.attribute_value(i), report_error);
+                break;
+            case atok_t_node_loc::XLOW:
+                xlow = load_int(tokens.attribute_value(i), report_error);
+                break;
+            case atok_t_node_loc::YHIGH:
+                yhigh = load_int(tokens.attribute_value(i), report_error);
+                break;
+            case atok_t_node_loc::YLOW:
+                ylow = load_int(tokens.attribute_value(i), report_error);
+                break;
+            default:
+                break; /* Set after element init */
+        }
+    }
+    std::bitset<7> test_astate = astate | std::bitset<7>(0b0000101);
+    if (!test_astate.all()) attr_error(test_astate, atok_lookup_t_node_loc, report_error);
+
+    auto child_context = out.init_node_loc(context, xhigh, xlow, yhigh, ylow);
+    for (size_t i = 0; i < tokens.num_attributes(); ++i) {
+        switch (lex_attr_t_node_loc(tokens.attribute_name(i), report_error)) {
+            case atok_t_node_loc::LAYER:
+                out.set_node_loc_layer(load_int(tokens.attribute_value(i), report_error), child_context);
+                break;
+            case atok_t_node_loc::PTC:
+                out.set_node_loc_ptc(tokens.attribute_value(i), child_context);
+                break;
+            case atok_t_node_loc::SIDE:
+                out.set_node_loc_side(lex_enum_loc_side(tokens.attribute_value(i), true, report_error), child_context);
+                break;
+            default:
+                break; /* Already set */
+        }
+    }
+    expect_no_child_element(tokens, "node_loc", report_error);
+    out.finish_node_loc(child_context);
+}
+
+template<class T, typename Context>
+inline void load_node_timing(XmlStreamTokenizer& tokens, T& out, Context& context, const std::function<void(const char*)>* report_error) {
+    using namespace uxsd;
+    float C = 0;
+    float R = 0;
+
+    std::bitset<2> astate = 0;
+    for (size_t i = 0; i < tokens.num_attributes(); ++i) {
+        atok_t_node_timing in = lex_attr_t_node_timing(tokens.attribute_name(i), report_error);
+        if (astate[(int)in] == 0) astate[(int)in] = 1;
+        else noreturn_report(report_error, ("Duplicate attribute " + std::string(tokens.attribute_name(i)) + " in <node_timing>.").c_str());
+        switch (in) {
+            case atok_t_node_timing::C:
+                C = load_float(tokens.attribute_value(i), report_error);
+                break;
+            case atok_t_node_timing::R:
+                R = load_float(tokens.attribute_value(i), report_error);
+                break;
+            default:
+                break; /* Not possible. */
+        }
+    }
+    if (!astate.all()) attr_error(astate, atok_lookup_t_node_timing, report_error);
+
+    auto child_context = out.init_node_timing(context, C, R);
+    expect_no_child_element(tokens, "node_timing", report_error);
+    out.finish_node_timing(child_context);
+}
+
+template<class T, typename Context>
+inline void load_node_segment(XmlStreamTokenizer& tokens, T& out, Context& context, const std::function<void(const char*)>* report_error) {
+    using namespace uxsd;
+    int segment_id = 0;
+
+    std::bitset<1> astate = 0;
+    for (size_t i = 0; i < tokens.num_attributes(); ++i) {
+        atok_t_node_segment in = lex_attr_t_node_segment(tokens.attribute_name(i), report_error);
+        if (astate[(int)in] == 0) astate[(int)in] = 1;
+        else noreturn_report(report_error, ("Duplicate attribute " + std::string(tokens.attribute_name(i)) + " in <node_segment>.").c_str());
+        segment_id = load_int(tokens.attribute_value(i), report_error);
+    }
+    if (!astate.all()) attr_error(astate, atok_lookup_t_node_segment, report_error);
+
+    auto child_context = out.init_node_segment(context, segment_id);
+    expect_no_child_element(tokens, "node_segment", report_error);
+    out.finish_node_segment(child_context);
+}
+
+template<class T, typename Context>
+inline void load_node(XmlStreamTokenizer& tokens, T& out, Context& context, const std::function<void(const char*)>* report_error, std::ptrdiff_t* offset_debug, std::ptrdiff_t* base_offset) {
+    using namespace uxsd;
+    std::ptrdiff_t node_offset = tokens.offset();
+    unsigned int capacity = 0;
+    unsigned int id = 0;
+    enum_node_type type = enum_node_type::UXSD_INVALID;
+
+    std::bitset<6> astate = 0;
+    for (size_t i = 0; i < tokens.num_attributes(); ++i) {
+        atok_t_node in = lex_attr_t_node(tokens.attribute_name(i), report_error);
+        if (astate[(int)in] == 0) astate[(int)in] = 1;
+        else noreturn_report(report_error, ("Duplicate attribute " + std::string(tokens.attribute_name(i)) + " in <node>.").c_str());
+        switch (in) {
+            case atok_t_node::CAPACITY:
+                capacity = load_unsigned_int(tokens.attribute_value(i), report_error);
+                break;
+            case atok_t_node::ID:
+                id = load_unsigned_int(tokens.attribute_value(i), report_error);
+                break;
+            case atok_t_node::TYPE:
+                type = lex_enum_node_type(tokens.attribute_value(i), true, report_error);
+                break;
+            default:
+                break; /* Set after element init */
+        }
+    }
+    std::bitset<6> test_astate = astate | std::bitset<6>(0b010110);
+    if (!test_astate.all()) attr_error(test_astate, atok_lookup_t_node, report_error);
+
+    auto child_context = out.add_rr_nodes_node(context, capacity, id, type);
+    for (size_t i = 0; i < tokens.num_attributes(); ++i) {
+        switch (lex_attr_t_node(tokens.attribute_name(i), report_error)) {
+            case atok_t_node::CLK_RES_TYPE:
+                out.set_node_clk_res_type(lex_enum_node_clk_res_type(tokens.attribute_value(i), true, report_error), child_context);
+                break;
+            case atok_t_node::DIRECTION:
+                out.set_node_direction(lex_enum_node_direction(tokens.attribute_value(i), true, report_error), child_context);
+                break;
+            case atok_t_node::NAME:
+                out.set_node_name(tokens.attribute_value(i), child_context);
+                break;
+            default:
+                break; /* Already set */
+        }
+    }
+
+    std::bitset<4> gstate = 0;
+    bool done = false;
+    while (!done) {
+        switch (tokens.next()) {
+            case XmlStreamTokenizer::e_token::START_ELEMENT: {
+                gtok_t_node in = lex_node_t_node(tokens.name(), report_error);
+                if (gstate[(int)in] == 0) gstate[(int)in] = 1;
+                else noreturn_report(report_error, ("Duplicate element " + std::string(tokens.name()) + " in <node>.").c_str());
+                switch (in) {
+                    case gtok_t_node::LOC:
+                        load_node_loc(tokens, out, child_context, report_error);
+                        break;
+                    case gtok_t_node::TIMING:
+                        load_node_timing(tokens, out, child_context, report_error);
+                        break;
+                    case gtok_t_node::SEGMENT:
+                        load_node_segment(tokens, out, child_context, report_error);
+                        break;
+                    case gtok_t_node::METADATA:
+                        load_captured_element(tokens, offset_debug, base_offset, report_error, [&](const pugi::xml_node& root) {
+                            auto metadata_context = out.init_node_metadata(child_context);
+                            uxsd::load_metadata(root, out, metadata_context, report_error, offset_debug);
+                            out.finish_node_metadata(metadata_context);
+                        });
+                        break;
+                    default:
+                        break; /* Not possible. */
+                }
+                break;
+            }
+            case XmlStreamTokenizer::e_token::TEXT:
+                expect_whitespace(tokens, "node", report_error);
+                break;
+            case XmlStreamTokenizer::e_token::END_ELEMENT:
+                done = true;
+                break;
+            case XmlStreamTokenizer::e_token::END_OF_DOCUMENT:
+                noreturn_report(report_error, "Unexpected end of document in <node>.");
+        }
+    }
+    std::bitset<4> test_gstate = gstate | std::bitset<4>(0b1110);
+    *offset_debug = node_offset;
+    if (!test_gstate.all()) all_error(test_gstate, gtok_lookup_t_node, report_error);
+
+    out.finish_rr_nodes_node(child_context);
+}
+
+template<class T, typename Context>
+inline void load_edge(XmlStreamTokenizer& tokens, T& out, Context& context, const std::function<void(const char*)>* report_error, std::ptrdiff_t* offset_debug, std::ptrdiff_t* base_offset) {
+    using namespace uxsd;
+    unsigned int sink_node = 0;
+    unsigned int src_node = 0;
+    unsigned int switch_id = 0;
+
+    std::bitset<3> astate = 0;
+    for (size_t i = 0; i < tokens.num_attributes(); ++i) {
+        atok_t_edge in = lex_attr_t_edge(tokens.attribute_name(i), report_error);
+        if (astate[(int)in] == 0) astate[(int)in] = 1;
+        else noreturn_report(report_error, ("Duplicate attribute " + std::string(tokens.attribute_name(i)) + " in <edge>.").c_str());
+        switch (in) {
+            case atok_t_edge::SINK_NODE:
+                sink_node = load_unsigned_int(tokens.attribute_value(i), report_error);
+                break;
+            case atok_t_edge::SRC_NODE:
+                src_node = load_unsigned_int(tokens.attribute_value(i), report_error);
+                break;
+            case atok_t_edge::SWITCH_ID:
+                switch_id = load_unsigned_int(tokens.attribute_value(i), report_error);
+                break;
+            default:
+                break; /* Not possible. */
+        }
+    }
+    if (!astate.all()) attr_error(astate, atok_lookup_t_edge, report_error);
+
+    auto child_context = out.add_rr_edges_edge(context, sink_node, src_node, switch_id);
+
+    std::bitset<1> gstate = 0;
+    bool done = false;
+    while (!done) {
+        switch (tokens.next()) {
+            case XmlStreamTokenizer::e_token::START_ELEMENT: {
+                gtok_t_edge in = lex_node_t_edge(tokens.name(), report_error);
+                if (gstate[(int)in] == 0) gstate[(int)in] = 1;
+                else noreturn_report(report_error, ("Duplicate element " + std::string(tokens.name()) + " in <edge>.").c_str());
+                load_captured_element(tokens, offset_debug, base_offset, report_error, [&](const pugi::xml_node& root) {
+                    auto metadata_context = out.init_edge_metadata(child_context);
+                    uxsd::load_metadata(root, out, metadata_context, report_error, offset_debug);
+                    out.finish_edge_metadata(metadata_context);
+                });
+                break;
+            }
+            case XmlStreamTokenizer::e_token::TEXT:
+                expect_whitespace(tokens, "edge", report_error);
+                break;
+            case XmlStreamTokenizer::e_token::END_ELEMENT:
+                done = true;
+                break;
+            case XmlStreamTokenizer::e_token::END_OF_DOCUMENT:
+                noreturn_report(report_error, "Unexpected end of document in <edge>.");
+        }
+    }
+
+    out.finish_rr_edges_edge(child_context);
+}
+
+/**
+ * @brief Streams the children of <rr_nodes> or <rr_edges>, calling
+ *        load_child for each start tag after checking it with lex_child.
+ */
+template<typename LexFn, typename LoadFn>
+inline void load_streamed_list(XmlStreamTokenizer& tokens, const char* element_name, const std::function<void(const char*)>* report_error, LexFn lex_child, LoadFn load_child) {
+    if (tokens.num_attributes() != 0) {
+        uxsd::noreturn_report(report_error, ("Unexpected attribute in <" + std::string(element_name) + ">.").c_str());
+    }
+
+    while (true) {
+        switch (tokens.next()) {
+            case XmlStreamTokenizer::e_token::START_ELEMENT:
+                lex_child(tokens.name(), report_error);
+                load_child();
+                break;
+            case XmlStreamTokenizer::e_token::TEXT:
+                expect_whitespace(tokens, element_name, report_error);
+                break;
+            case XmlStreamTokenizer::e_token::END_ELEMENT:
+                return;
+            case XmlStreamTokenizer::e_token::END_OF_DOCUMENT:
+                uxsd::noreturn_report(report_error, ("Unexpected end of document in <" + std::string(element_name) + ">.").c_str());
+        }
+    }
+}
+
+template<class T, typename Context>
+inline void load_rr_graph(XmlStreamTokenizer& tokens, T& out, Context& context, const std::function<void(const char*)>* report_error, std::ptrdiff_t* offset_debug, std::ptrdiff_t* base_offset) {
+    using namespace uxsd;
+
+    for (size_t i = 0; i < tokens.num_attributes(); ++i) {
+        switch (lex_attr_t_rr_graph(tokens.attribute_name(i), report_error)) {
+            case atok_t_rr_graph::TOOL_COMMENT:
+                out.set_rr_graph_tool_comment(tokens.attribute_value(i), context);
+                break;
+            case atok_t_rr_graph::TOOL_NAME:
+                out.set_rr_graph_tool_name(tokens.attribute_value(i), context);
+                break;
+            case atok_t_rr_graph::TOOL_VERSION:
+                out.set_rr_graph_tool_version(tokens.attribute_value(i), context);
+                break;
+            default:
+                break; /* Not possible. */
+        }
+    }
+
+    std::bitset<7> gstate = 0;
+    bool done = false;
+    while (!done) {
+        switch (tokens.next()) {
+            case XmlStreamTokenizer::e_token::START_ELEMENT: {
+                gtok_t_rr_graph in = lex_node_t_rr_graph(tokens.name(), report_error);
+                if (gstate[(int)in] == 0) gstate[(int)in] = 1;
+                else noreturn_report(report_error, ("Duplicate element " + std::string(tokens.name()) + " in <rr_graph>.").c_str());
+                switch (in) {
+                    case gtok_t_rr_graph::CHANNELS:
+                        load_captured_element(tokens, offset_debug, base_offset, report_error, [&](const pugi::xml_node& root) {
+                            auto child_context = out.init_rr_graph_channels(context);
+                            uxsd::load_channels(root, out, child_context, report_error, offset_debug);
+                            out.finish_rr_graph_channels(child_context);
+                        });
+                        break;
+                    case gtok_t_rr_graph::SWITCHES:
+                        load_captured_element(tokens, offset_debug, base_offset, report_error, [&](const pugi::xml_node& root) {
+                            auto child_context = out.init_rr_graph_switches(context);
+                            uxsd::load_switches(root, out, child_context, report_error, offset_debug);
+                            out.finish_rr_graph_switches(child_context);
+                        });
+                        break;
+                    case gtok_t_rr_graph::SEGMENTS:
+                        load_captured_element(tokens, offset_debug, base_offset, report_error, [&](const pugi::xml_node& root) {
+                            auto child_context = out.init_rr_graph_segments(context);
+                            uxsd::load_segments(root, out, child_context, report_error, offset_debug);
+                            out.finish_rr_graph_segments(child_context);
+                        });
+                        break;
+                    case gtok_t_rr_graph::BLOCK_TYPES:
+                        load_captured_element(tokens, offset_debug, base_offset, report_error, [&](const pugi::xml_node& root) {
+                            auto child_context = out.init_rr_graph_block_types(context);
+                            uxsd::load_block_types(root, out, child_context, report_error, offset_debug);
+                            out.finish_rr_graph_block_types(child_context);
+                        });
+                        break;
+                    case gtok_t_rr_graph::GRID:
+                        load_captured_element(tokens, offset_debug, base_offset, report_error, [&](const pugi::xml_node& root) {
+                            auto child_context = out.init_rr_graph_grid(context);
+                            uxsd::load_grid_locs(root, out, child_context, report_error, offset_debug);
+                            out.finish_rr_graph_grid(child_context);
+                        });
+                        break;
+                    case gtok_t_rr_graph::RR_NODES: {
+                        auto child_context = out.init_rr_graph_rr_nodes(context);
+                        load_streamed_list(tokens, "rr_nodes", report_error, lex_node_t_rr_nodes, [&]() {
+                            load_node(tokens, out, child_context, report_error, offset_debug, base_offset);
+                        });
+                        out.finish_rr_graph_rr_nodes(child_context);
+                        break;
+                    }
+                    case gtok_t_rr_graph::RR_EDGES: {
+                        auto child_context = out.init_rr_graph_rr_edges(context);
+                        load_streamed_list(tokens, "rr_edges", report_error, lex_node_t_rr_edges, [&]() {
+                            load_edge(tokens, out, child_context, report_error, offset_debug, base_offset);
+                        });
+                        out.finish_rr_graph_rr_edges(child_context);
+                        break;
+                    }
+                    default:
+                        break; /* Not possible. */
+                }
+                break;
+            }
+            case XmlStreamTokenizer::e_token::TEXT:
+                expect_whitespace(tokens, "rr_graph", report_error);
+                break;
+            case XmlStreamTokenizer::e_token::END_ELEMENT:
+                done = true;
+                break;
+            case XmlStreamTokenizer::e_token::END_OF_DOCUMENT:
+                noreturn_report(report_error, "Unexpected end of document in <rr_graph>.");
+        }
+    }
+    if (!gstate.all()) all_error(gstate, gtok_lookup_t_rr_graph, report_error);
+}
+
+} // namespace rr_graph_xml_stream_impl
+
+/**
+ * @brief Streaming equivalent of uxsd::load_rr_graph_xml.
+ *
+ * Issues the same sequence of callbacks on out as the generated DOM loader,
+ * except that preallocate_rr_nodes_node and preallocate_rr_edges_edge are
+ * not called: the number of nodes and edges is not known until they have
+ * been read, and the file is only read once. The storage grows as elements
+ * are added instead, as it does for other formats which lack the size on
+ * read.
+ */
+template<class T, typename Context>
+inline void load_rr_graph_xml_stream(T& out, Context& context, const char* filename) {
+    //Offset of the token being processed. While a captured sub-tree is being
+    //loaded, it is relative to base_offset.
+    std::ptrdiff_t offset_debug = 0;
+    std::ptrdiff_t base_offset = 0;
+    std::function<void(const char*)> report_error = [filename, &out, &offset_debug, &base_offset](const char* message) {
+        int line = 0, col = 0;
+        uxsd::get_line_number(filename, base_offset + offset_debug, &line, &col);
+        out.error_encountered(filename, line, message);
+        // If error_encountered didn't throw, throw now to unwind.
+        throw std::runtime_error(message);
+    };
+
+    XmlStreamTokenizer tokens(filename, &report_error, &offset_debug);
+
+    out.start_load(&report_error);
+
+    bool found_root = false;
+    while (true) {
+        XmlStreamTokenizer::e_token token = tokens.next();
+        if (token == XmlStreamTokenizer::e_token::END_OF_DOCUMENT) {
+            break;
+        } else if (token == XmlStreamTokenizer::e_token::TEXT) {
+            rr_graph_xml_stream_impl::expect_whitespace(tokens, "document", &report_error);
+        } else if (token == XmlStreamTokenizer::e_token::START_ELEMENT && !found_root && std::strcmp(tokens.name(), "rr_graph") == 0) {
+            found_root = true;
+            /* If errno is set up to this point, it messes with strtol errno checking. */
+            errno = 0;
+            rr_graph_xml_stream_impl::load_rr_graph(tokens, out, context, &report_error, &offset_debug, &base_offset);
+        } else {
+            report_error(("Invalid root-level element " + std::string(tokens.name())).c_str());
+        }
+    }
+    if (!found_root) {
+        report_error("No root element found");
+    }
+
+    out.finish_load();
+}
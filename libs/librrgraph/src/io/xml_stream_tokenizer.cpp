@@ -0,0 +1,406 @@
+#include "xml_stream_tokenizer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+static bool is_xml_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool is_name_end(char c) {
+    return is_xml_space(c) || c == '/' || c == '>' || c == '=';
+}
+
+XmlStreamTokenizer::XmlStreamTokenizer(const char* filename,
+                                       const std::function<void(const char*)>* report_error,
+                                       std::ptrdiff_t* offset_debug,
+                                       size_t buffer_size)
+    : filename_(filename)
+    , report_error_(report_error)
+    , offset_debug_(offset_debug)
+    , buffer_(std::max<size_t>(buffer_size, 64)) {
+    file_ = std::fopen(filename, "rb");
+    if (!file_) {
+        error("Unable to open XML file '" + filename_ + "'");
+    }
+}
+
+XmlStreamTokenizer::~XmlStreamTokenizer() {
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+bool XmlStreamTokenizer::fill() {
+    if (eof_) {
+        return false;
+    }
+
+    //Move the unconsumed bytes to the front of the window
+    if (begin_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        buffer_offset_ += begin_;
+        end_ -= begin_;
+        begin_ = 0;
+    }
+
+    //A single token does not fit in the window, grow it
+    if (end_ == buffer_.size()) {
+        buffer_.resize(2 * buffer_.size());
+    }
+
+    size_t num_read = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+    if (num_read == 0) {
+        if (std::ferror(file_)) {
+            error("Error while reading XML file '" + filename_ + "'");
+        }
+        eof_ = true;
+        return false;
+    }
+    end_ += num_read;
+    return true;
+}
+
+bool XmlStreamTokenizer::ensure(size_t n) {
+    while (end_ - begin_ < n) {
+        if (!fill()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t XmlStreamTokenizer::find(std::string_view needle, size_t pos) {
+    while (true) {
+        std::string_view window(buffer_.data() + begin_, end_ - begin_);
+        size_t found = window.find(needle, pos);
+        if (found != std::string_view::npos) {
+            return found;
+        }
+        //Restart the search where a partial match could begin
+        if (window.size() >= needle.size()) {
+            pos = std::max(pos, window.size() - needle.size() + 1);
+        }
+        if (!fill()) {
+            return std::string_view::npos;
+        }
+    }
+}
+
+size_t XmlStreamTokenizer::find_tag_end() {
+    char quote = '\0';
+    size_t pos = 1;
+    while (true) {
+        for (; begin_ + pos < end_; ++pos) {
+            char c = buffer_[begin_ + pos];
+            if (quote != '\0') {
+                if (c == quote) {
+                    quote = '\0';
+                }
+            } else if (c == '"' || c == '\'') {
+                quote = c;
+            } else if (c == '>') {
+                return pos;
+            }
+        }
+        if (!fill()) {
+            return std::string_view::npos;
+        }
+    }
+}
+
+void XmlStreamTokenizer::consume(size_t n) {
+    raw_token_ = std::string_view(buffer_.data() + begin_, n);
+    begin_ += n;
+}
+
+XmlStreamTokenizer::e_token XmlStreamTokenizer::next() {
+    if (pending_end_) {
+        //Second half of an empty element; its raw text was part of the start tag
+        pending_end_ = false;
+        raw_token_ = std::string_view();
+        --depth_;
+        return e_token::END_ELEMENT;
+    }
+
+    while (true) {
+        if (!ensure(1)) {
+            token_offset_ = buffer_offset_ + begin_;
+            *offset_debug_ = token_offset_;
+            raw_token_ = std::string_view();
+            if (depth_ > 0) {
+                error("Unexpected end of document, <" + open_elements_[depth_ - 1] + "> is not closed");
+            }
+            return e_token::END_OF_DOCUMENT;
+        }
+
+        token_offset_ = buffer_offset_ + begin_;
+        *offset_debug_ = token_offset_;
+
+        if (buffer_[begin_] != '<') {
+            size_t text_end = find("<", 0);
+            if (text_end == std::string_view::npos) {
+                text_end = end_ - begin_;
+            }
+            decode(buffer_.data() + begin_, buffer_.data() + begin_ + text_end, text_, false);
+            consume(text_end);
+            return e_token::TEXT;
+        }
+
+        if (!ensure(2)) {
+            error("Unexpected end of document");
+        }
+
+        char second = buffer_[begin_ + 1];
+        if (second == '?') {
+            //Processing instruction or XML declaration
+            size_t pi_end = find("?>", 2);
+            if (pi_end == std::string_view::npos) {
+                error("Unterminated processing instruction");
+            }
+            consume(pi_end + 2);
+            continue;
+        }
+
+        if (second == '!') {
+            if (ensure(4) && std::memcmp(buffer_.data() + begin_, "<!--", 4) == 0) {
+                size_t comment_end = find("-->", 4);
+                if (comment_end == std::string_view::npos) {
+                    error("Unterminated comment");
+                }
+                consume(comment_end + 3);
+                continue;
+            }
+            if (ensure(9) && std::memcmp(buffer_.data() + begin_, "<![CDATA[", 9) == 0) {
+                size_t cdata_end = find("]]>", 9);
+                if (cdata_end == std::string_view::npos) {
+                    error("Unterminated CDATA section");
+                }
+                text_.assign(buffer_.data() + begin_ + 9, cdata_end - 9);
+                consume(cdata_end + 3);
+                return e_token::TEXT;
+            }
+            //DOCTYPE (internal subsets are not supported)
+            size_t decl_end = find(">", 2);
+            if (decl_end == std::string_view::npos) {
+                error("Unterminated declaration");
+            }
+            consume(decl_end + 1);
+            continue;
+        }
+
+        size_t tag_end = find_tag_end();
+        if (tag_end == std::string_view::npos) {
+            error("Unterminated tag");
+        }
+
+        if (second == '/') {
+            parse_end_tag(tag_end);
+            consume(tag_end + 1);
+            return e_token::END_ELEMENT;
+        }
+
+        parse_start_tag(tag_end);
+        consume(tag_end + 1);
+        return e_token::START_ELEMENT;
+    }
+}
+
+void XmlStreamTokenizer::parse_end_tag(size_t tag_end) {
+    const char* first = buffer_.data() + begin_ + 2;
+    const char* last = buffer_.data() + begin_ + tag_end;
+    while (last > first && is_xml_space(last[-1])) {
+        --last;
+    }
+    if (first == last) {
+        error("Empty end tag");
+    }
+
+    std::string_view end_name(first, last - first);
+    if (depth_ == 0) {
+        error("Unexpected end tag </" + std::string(end_name) + ">");
+    }
+    if (end_name != open_elements_[depth_ - 1]) {
+        error("End tag </" + std::string(end_name) + "> does not match start tag <" + open_elements_[depth_ - 1] + ">");
+    }
+    --depth_;
+    name_.assign(first, last);
+}
+
+void XmlStreamTokenizer::parse_start_tag(size_t tag_end) {
+    const char* p = buffer_.data() + begin_ + 1;
+    const char* last = buffer_.data() + begin_ + tag_end;
+
+    pending_end_ = (last[-1] == '/');
+    if (pending_end_) {
+        --last;
+    }
+
+    const char* name_begin = p;
+    while (p < last && !is_name_end(*p)) {
+        ++p;
+    }
+    if (p == name_begin) {
+        error("Empty start tag");
+    }
+    name_.assign(name_begin, p);
+
+    if (depth_ == open_elements_.size()) {
+        open_elements_.emplace_back();
+    }
+    open_elements_[depth_++] = name_;
+
+    num_attributes_ = 0;
+    while (true) {
+        while (p < last && is_xml_space(*p)) {
+            ++p;
+        }
+        if (p == last) {
+            break;
+        }
+
+        const char* attr_name_begin = p;
+        while (p < last && !is_name_end(*p)) {
+            ++p;
+        }
+        const char* attr_name_end = p;
+        while (p < last && is_xml_space(*p)) {
+            ++p;
+        }
+        if (attr_name_begin == attr_name_end || p == last || *p != '=') {
+            error("Malformed attribute in <" + name_ + ">");
+        }
+        ++p;
+        while (p < last && is_xml_space(*p)) {
+            ++p;
+        }
+        if (p == last || (*p != '"' && *p != '\'')) {
+            error("Expected quoted attribute value in <" + name_ + ">");
+        }
+        char quote = *p++;
+        const char* value_begin = p;
+        while (p < last && *p != quote) {
+            ++p;
+        }
+        if (p == last) {
+            error("Unterminated attribute value in <" + name_ + ">");
+        }
+
+        if (num_attributes_ == attribute_names_.size()) {
+            attribute_names_.emplace_back();
+            attribute_values_.emplace_back();
+        }
+        attribute_names_[num_attributes_].assign(attr_name_begin, attr_name_end);
+        decode(value_begin, p, attribute_values_[num_attributes_], true);
+        ++num_attributes_;
+        ++p;
+    }
+}
+
+static void append_utf8(unsigned long code_point, std::string& out) {
+    if (code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+void XmlStreamTokenizer::decode(const char* first, const char* last, std::string& out, bool normalize_whitespace) {
+    out.clear();
+
+    //Fast path: nothing to decode
+    const char* amp = std::find(first, last, '&');
+    if (amp == last && !normalize_whitespace) {
+        out.assign(first, last);
+        return;
+    }
+
+    for (const char* p = first; p < last; ++p) {
+        char c = *p;
+        if (c == '&') {
+            const char* semi = std::find(p, last, ';');
+            if (semi != last) {
+                std::string_view entity(p + 1, semi - p - 1);
+                bool decoded = true;
+                if (entity == "lt") {
+                    out.push_back('<');
+                } else if (entity == "gt") {
+                    out.push_back('>');
+                } else if (entity == "amp") {
+                    out.push_back('&');
+                } else if (entity == "quot") {
+                    out.push_back('"');
+                } else if (entity == "apos") {
+                    out.push_back('\'');
+                } else if (entity.size() > 1 && entity[0] == '#') {
+                    bool hex = (entity[1] == 'x');
+                    std::string digits(entity.substr(hex ? 2 : 1));
+                    char* digits_end = nullptr;
+                    unsigned long code_point = std::strtoul(digits.c_str(), &digits_end, hex ? 16 : 10);
+                    if (digits.empty() || *digits_end != '\0') {
+                        decoded = false;
+                    } else {
+                        append_utf8(code_point, out);
+                    }
+                } else {
+                    decoded = false;
+                }
+                if (decoded) {
+                    p = semi;
+                    continue;
+                }
+            }
+            //Unknown entities are kept verbatim
+            out.push_back(c);
+        } else if (normalize_whitespace && (c == '\t' || c == '\n' || c == '\r')) {
+            out.push_back(' ');
+        } else {
+            out.push_back(c);
+        }
+    }
+}
+
+bool XmlStreamTokenizer::text_is_whitespace() const {
+    return std::all_of(text_.begin(), text_.end(), is_xml_space);
+}
+
+std::string XmlStreamTokenizer::capture_element() {
+    std::string xml(raw_token_);
+
+    int depth = 1;
+    while (depth > 0) {
+        switch (next()) {
+            case e_token::START_ELEMENT:
+                ++depth;
+                break;
+            case e_token::END_ELEMENT:
+                --depth;
+                break;
+            case e_token::TEXT:
+                break;
+            case e_token::END_OF_DOCUMENT:
+                error("Unexpected end of document inside <" + name_ + ">");
+        }
+        xml.append(raw_token_);
+    }
+
+    return xml;
+}
+
+void XmlStreamTokenizer::error(const std::string& msg) {
+    (*report_error_)(msg.c_str());
+    //report_error is not expected to return
+    throw std::runtime_error(msg);
+}
@@ -0,0 +1,127 @@
+#pragma once
+/**
+ * @file
+ * @brief A small pull-style (SAX-like) XML tokenizer used to stream large
+ *        RR graph files without materializing a DOM.
+ *
+ * The tokenizer reads the file through a fixed-size window which is only
+ * grown if a single token (e.g. a very long start tag) does not fit in it,
+ * so memory usage is independent of the file size.
+ *
+ * Only the subset of XML used by the RR graph format is supported: elements,
+ * attributes, character data, CDATA sections, comments, processing
+ * instructions and a DOCTYPE declaration without an internal subset. The
+ * predefined entities and numeric character references are decoded.
+ *
+ * The document must be well-formed: every end tag must match the innermost
+ * open start tag and all elements must be closed at the end of the file.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class XmlStreamTokenizer {
+  public:
+    enum class e_token {
+        START_ELEMENT, ///<A start tag. Empty elements (<a/>) are reported as a START_ELEMENT followed by an END_ELEMENT.
+        END_ELEMENT,   ///<An end tag.
+        TEXT,          ///<Character data (entities decoded) or the content of a CDATA section.
+        END_OF_DOCUMENT
+    };
+
+    /**
+     * @brief Opens filename for streaming.
+     *
+     *   @param filename      The XML file to read.
+     *   @param report_error  Invoked (and expected not to return) on I/O or syntax errors.
+     *   @param offset_debug  Updated with the file offset of every token, so that
+     *                        report_error can compute a line number.
+     *   @param buffer_size   Initial size of the read window in bytes.
+     */
+    XmlStreamTokenizer(const char* filename,
+                       const std::function<void(const char*)>* report_error,
+                       std::ptrdiff_t* offset_debug,
+                       size_t buffer_size = 1 << 20);
+    ~XmlStreamTokenizer();
+
+    XmlStreamTokenizer(const XmlStreamTokenizer&) = delete;
+    XmlStreamTokenizer& operator=(const XmlStreamTokenizer&) = delete;
+
+    ///@brief Advances to the next token and returns its kind.
+    e_token next();
+
+    ///@brief Name of the current START_ELEMENT/END_ELEMENT token.
+    const char* name() const { return name_.c_str(); }
+
+    ///@brief Number of attributes of the current START_ELEMENT token.
+    size_t num_attributes() const { return num_attributes_; }
+    ///@brief Name of the i'th attribute of the current START_ELEMENT token.
+    const char* attribute_name(size_t i) const { return attribute_names_[i].c_str(); }
+    ///@brief Value (entities decoded) of the i'th attribute of the current START_ELEMENT token.
+    const char* attribute_value(size_t i) const { return attribute_values_[i].c_str(); }
+
+    ///@brief Decoded content of the current TEXT token.
+    const std::string& text() const { return text_; }
+    ///@brief True if the current TEXT token only holds whitespace.
+    bool text_is_whitespace() const;
+
+    ///@brief File offset of the current token.
+    std::ptrdiff_t offset() const { return token_offset_; }
+
+    /**
+     * @brief Returns the raw XML of the element whose START_ELEMENT token was
+     *        just returned by next(), including all of its children, and
+     *        consumes the tokenizer up to and including its END_ELEMENT.
+     *
+     * This is used to hand small, bounded sub-trees to a DOM based loader.
+     */
+    std::string capture_element();
+
+  private:
+    ///@brief Compacts the window and reads more data. Returns false at end of file.
+    bool fill();
+    ///@brief Returns the position of needle at or after pos (relative to begin_), filling the window as needed, or npos.
+    size_t find(std::string_view needle, size_t pos);
+    ///@brief Makes sure at least n bytes are available after begin_. Returns false if the file is shorter.
+    bool ensure(size_t n);
+    ///@brief Returns the position of the '>' closing the tag starting at begin_, honouring quoted attribute values.
+    size_t find_tag_end();
+
+    void parse_start_tag(size_t tag_end);
+    void parse_end_tag(size_t tag_end);
+    void consume(size_t n);
+
+    static void decode(const char* first, const char* last, std::string& out, bool normalize_whitespace);
+
+    [[noreturn]] void error(const std::string& msg);
+
+    std::FILE* file_ = nullptr;
+    std::string filename_;
+    const std::function<void(const char*)>* report_error_;
+    std::ptrdiff_t* offset_debug_;
+
+    std::vector<char> buffer_;
+    size_t begin_ = 0;               ///<First unconsumed byte in buffer_
+    size_t end_ = 0;                 ///<One past the last valid byte in buffer_
+    std::ptrdiff_t buffer_offset_ = 0; ///<File offset of buffer_[0]
+    bool eof_ = false;
+
+    std::ptrdiff_t token_offset_ = 0;
+    std::string_view raw_token_; ///<Raw bytes of the current token (valid until the next call to next())
+    bool pending_end_ = false;   ///<The current start tag was an empty element (<a/>)
+
+    ///@brief Names of the currently open elements; only the first depth_ entries are valid.
+    ///       Entries are reused so that tracking them does not allocate per tag.
+    std::vector<std::string> open_elements_;
+    size_t depth_ = 0;
+
+    std::string name_;
+    size_t num_attributes_ = 0;
+    std::vector<std::string> attribute_names_;
+    std::vector<std::string> attribute_values_;
+    std::string text_;
+};
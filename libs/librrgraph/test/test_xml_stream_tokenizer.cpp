@@ -0,0 +1,93 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "xml_stream_tokenizer.h"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+const char* kXmlFile = "test_xml_stream_tokenizer.xml";
+
+using e_token = XmlStreamTokenizer::e_token;
+
+/**
+ * @brief Writes xml to a file and returns its tokens in a compact textual form:
+ *        <name a="v"> for start tags, </name> for end tags and [text] for
+ *        non-whitespace text.
+ *
+ * A small window is used so that tokens straddle window refills.
+ */
+std::string tokenize(const std::string& xml) {
+    {
+        std::ofstream os(kXmlFile, std::ios::binary);
+        os << xml;
+    }
+
+    std::function<void(const char*)> report_error = [](const char* msg) {
+        throw std::runtime_error(msg);
+    };
+    std::ptrdiff_t offset = 0;
+    XmlStreamTokenizer tokenizer(kXmlFile, &report_error, &offset, 16);
+
+    std::string tokens;
+    for (e_token token = tokenizer.next(); token != e_token::END_OF_DOCUMENT; token = tokenizer.next()) {
+        if (token == e_token::START_ELEMENT) {
+            tokens += "<" + std::string(tokenizer.name());
+            for (size_t i = 0; i < tokenizer.num_attributes(); ++i) {
+                tokens += " " + std::string(tokenizer.attribute_name(i)) + "=\"" + tokenizer.attribute_value(i) + "\"";
+            }
+            tokens += ">";
+        } else if (token == e_token::END_ELEMENT) {
+            tokens += "</" + std::string(tokenizer.name()) + ">";
+        } else if (!tokenizer.text_is_whitespace()) {
+            tokens += "[" + tokenizer.text() + "]";
+        }
+    }
+    return tokens;
+}
+
+} // namespace
+
+TEST_CASE("Elements and attributes", "[xml_stream_tokenizer]") {
+    REQUIRE(tokenize("<rr_graph tool_name='vpr'>\n  <node id=\"0\" type=\"CHANX\"/>\n  <node id=\"1\"></node>\n</rr_graph>\n")
+            == "<rr_graph tool_name=\"vpr\"><node id=\"0\" type=\"CHANX\"></node><node id=\"1\"></node></rr_graph>");
+}
+
+TEST_CASE("Entities and character references", "[xml_stream_tokenizer]") {
+    REQUIRE(tokenize("<a x=\"1 &amp; 2\" y='&lt;&gt;&quot;&apos;'>&#65;&#x42;&amp;c</a>")
+            == "<a x=\"1 & 2\" y=\"<>\"'\">[AB&c]</a>");
+}
+
+TEST_CASE("Attribute whitespace is normalized", "[xml_stream_tokenizer]") {
+    REQUIRE(tokenize("<a x=\"1\t2\n3\"/>") == "<a x=\"1 2 3\"></a>");
+}
+
+TEST_CASE("CDATA, comments, processing instructions and DOCTYPE", "[xml_stream_tokenizer]") {
+    REQUIRE(tokenize("<?xml version=\"1.0\"?>\n<!DOCTYPE rr_graph>\n<!-- <b> is not an element -->\n"
+                     "<a><![CDATA[<b>&amp;</b>]]><!-- </a> --></a>")
+            == "<a>[<b>&amp;</b>]</a>");
+}
+
+TEST_CASE("Malformed documents are rejected", "[xml_stream_tokenizer]") {
+    SECTION("Mismatched end tag") {
+        REQUIRE_THROWS_AS(tokenize("<node></edge>"), std::runtime_error);
+    }
+    SECTION("Unclosed element") {
+        REQUIRE_THROWS_AS(tokenize("<rr_graph><nodes>"), std::runtime_error);
+    }
+    SECTION("Stray end tag") {
+        REQUIRE_THROWS_AS(tokenize("</rr_graph>"), std::runtime_error);
+    }
+    SECTION("Unterminated tag") {
+        REQUIRE_THROWS_AS(tokenize("<a><b x=\"1\""), std::runtime_error);
+    }
+    SECTION("Unterminated comment") {
+        REQUIRE_THROWS_AS(tokenize("<a><!-- </a>"), std::runtime_error);
+    }
+
+    std::remove(kXmlFile);
+}
@@ -21,6 +21,10 @@ void map_error_activation_status(std::string function_name) {
     functions_to_demote.insert(function_name);
 }
 
+bool has_demoted_errors() {
+    return !functions_to_demote.empty();
+}
+
 void vpr_throw(enum e_vpr_error type,
                const char* psz_file_name,
                unsigned int line_num,
@@ -58,6 +58,11 @@ class VprError : public vtr::VtrError {
 // going to be demoted to be VTR_LOG_WARN
 void map_error_activation_status(std::string function_name);
 
+//Returns true if the VPR_ERROR()s of some functions have been demoted to warnings
+//(see map_error_activation_status()). Code which checks in parallel uses this to
+//fall back to serial checking, so that the warnings are reported in order.
+bool has_demoted_errors();
+
 //VPR error reporting routines
 //
 //Note that we mark these functions with the C++11 attribute 'noreturn'
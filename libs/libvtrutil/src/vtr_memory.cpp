@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <math.h>
@@ -14,6 +16,15 @@
 #include <malloc.h>
 #endif
 
+#ifdef __linux__
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace vtr {
 
 #ifndef __GLIBC__
@@ -26,6 +37,115 @@ int malloc_trim(size_t pad) {
 }
 #endif
 
+static e_numa_policy numa_policy = e_numa_policy::FIRST_TOUCH;
+
+//Updated by apply_numa_policy(), which may be called from several threads
+static std::atomic<size_t> numa_num_applied(0);
+static std::atomic<size_t> numa_num_bytes_applied(0);
+static std::atomic<size_t> numa_num_failed(0);
+
+e_numa_policy set_numa_policy(e_numa_policy policy) {
+    if (policy == e_numa_policy::INTERLEAVE && get_num_numa_nodes() < 2) {
+        policy = e_numa_policy::FIRST_TOUCH;
+    }
+    numa_policy = policy;
+    return numa_policy;
+}
+
+e_numa_policy get_numa_policy() {
+    return numa_policy;
+}
+
+t_numa_policy_stats get_numa_policy_stats() {
+    t_numa_policy_stats stats;
+    stats.num_applied = numa_num_applied.load(std::memory_order_relaxed);
+    stats.num_bytes_applied = numa_num_bytes_applied.load(std::memory_order_relaxed);
+    stats.num_failed = numa_num_failed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+#ifdef __linux__
+//Values of the Linux mbind() interface (see linux/mempolicy.h), which are not part of the libc headers
+constexpr int LINUX_MPOL_INTERLEAVE = 3;
+constexpr unsigned LINUX_MPOL_MF_MOVE = 1 << 1;
+
+/**
+ * @brief Returns the mask of the online memory nodes, as used by mbind()
+ *
+ * Parses /sys/devices/system/node/online, which lists ranges of node ids (e.g. "0-1,4").
+ */
+static const std::vector<unsigned long>& online_numa_node_mask() {
+    static const std::vector<unsigned long> node_mask = []() {
+        constexpr size_t BITS_PER_WORD = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> mask;
+
+        std::ifstream node_file("/sys/devices/system/node/online");
+        std::string node_ranges;
+        if (!std::getline(node_file, node_ranges)) {
+            return mask;
+        }
+
+        std::stringstream node_stream(node_ranges);
+        std::string node_range;
+        while (std::getline(node_stream, node_range, ',')) {
+            size_t dash = node_range.find('-');
+            size_t first = std::stoul(node_range.substr(0, dash));
+            size_t last = (dash == std::string::npos) ? first : std::stoul(node_range.substr(dash + 1));
+            for (size_t node = first; node <= last; node++) {
+                if (node / BITS_PER_WORD >= mask.size()) {
+                    mask.resize(node / BITS_PER_WORD + 1, 0);
+                }
+                mask[node / BITS_PER_WORD] |= 1UL << (node % BITS_PER_WORD);
+            }
+        }
+        return mask;
+    }();
+    return node_mask;
+}
+
+int get_num_numa_nodes() {
+    int num_nodes = 0;
+    for (unsigned long word : online_numa_node_mask()) {
+        num_nodes += __builtin_popcountl(word);
+    }
+    return std::max(num_nodes, 1);
+}
+
+bool apply_numa_policy(void* data, size_t num_bytes) {
+    if (numa_policy == e_numa_policy::FIRST_TOUCH || get_num_numa_nodes() < 2) {
+        return false;
+    }
+
+    //mbind() only works on whole pages
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t begin = ((size_t)data + page_size - 1) / page_size * page_size;
+    const size_t end = ((size_t)data + num_bytes) / page_size * page_size;
+    if (end <= begin) {
+        return false;
+    }
+
+    const std::vector<unsigned long>& node_mask = online_numa_node_mask();
+    long ret = syscall(SYS_mbind, begin, end - begin, LINUX_MPOL_INTERLEAVE,
+                       node_mask.data(), 8 * sizeof(unsigned long) * node_mask.size() + 1,
+                       LINUX_MPOL_MF_MOVE);
+    if (ret != 0) {
+        numa_num_failed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    numa_num_applied.fetch_add(1, std::memory_order_relaxed);
+    numa_num_bytes_applied.fetch_add(end - begin, std::memory_order_relaxed);
+    return true;
+}
+#else
+int get_num_numa_nodes() {
+    return 1;
+}
+
+bool apply_numa_policy(void* /*data*/, size_t /*num_bytes*/) {
+    return false;
+}
+#endif
+
 void* free(void* some) {
     if (some) {
         std::free(some);
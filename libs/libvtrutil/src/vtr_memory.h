@@ -90,6 +90,67 @@ inline int memalign(void** ptr_out, size_t align, size_t size) {
 #endif
 }
 
+/**
+ * @brief How the pages of large allocations are placed on the memory nodes of NUMA machines
+ */
+enum class e_numa_policy {
+    FIRST_TOUCH, ///<Pages are placed on the node of the thread which first writes to them (the OS default)
+    INTERLEAVE   ///<Pages are spread round-robin over all the memory nodes
+};
+
+///@brief Allocations smaller than this are left to the OS default policy by aligned_allocator
+constexpr size_t NUMA_POLICY_MIN_BYTES = 1 << 20;
+
+/**
+ * @brief Sets the page placement policy applied by apply_numa_policy()
+ *
+ * Should be set once, before the data structures it applies to are allocated.
+ * INTERLEAVE has no effect on hosts with a single memory node, so the policy is
+ * left as FIRST_TOUCH there.
+ *
+ * @return The policy in effect
+ */
+e_numa_policy set_numa_policy(e_numa_policy policy);
+
+///@brief Returns the page placement policy applied by apply_numa_policy()
+e_numa_policy get_numa_policy();
+
+///@brief Returns the number of memory nodes of the host (1 if it is not a NUMA machine or this is not supported)
+int get_num_numa_nodes();
+
+///@brief What apply_numa_policy() did since the program started
+struct t_numa_policy_stats {
+    size_t num_applied = 0;       ///<Number of ranges the policy was applied to
+    size_t num_bytes_applied = 0; ///<Total size of the ranges the policy was applied to
+    size_t num_failed = 0;        ///<Number of ranges the operating system failed to apply the policy to
+};
+
+///@brief Returns what apply_numa_policy() did since the program started
+t_numa_policy_stats get_numa_policy_stats();
+
+/**
+ * @brief Applies the current NUMA policy to the whole pages in [data, data + num_bytes)
+ *
+ * Pages which were already touched are migrated. This is a no-op with the FIRST_TOUCH policy
+ * or on hosts with a single memory node.
+ *
+ * With a single thread allocating and initializing the large routing and placement data structures,
+ * FIRST_TOUCH puts all their pages on one node, and threads running on the other nodes pay the remote
+ * memory latency on every access. INTERLEAVE spreads the accesses (and bandwidth) over all the nodes.
+ *
+ * @return true if the policy was applied
+ */
+bool apply_numa_policy(void* data, size_t num_bytes);
+
+///@brief Applies the current NUMA policy to the storage of a contiguous container
+template<typename Container>
+bool apply_numa_policy(Container& container) {
+    if (container.empty()) {
+        return false;
+    }
+    return apply_numa_policy((void*)&*container.begin(), container.size() * sizeof(*container.begin()));
+}
+
 /**
  * @brief A macro generates a prefetch instruction on all architectures that include it.
  * 
@@ -103,7 +164,7 @@ inline int memalign(void** ptr_out, size_t align, size_t size) {
 /**
  * @brief aligned_allocator is a STL allocator that allocates memory in an aligned fashion
  *
- * works if supported by the platform
+ * works if supported by the platform. The NUMA policy (see set_numa_policy()) is applied to large allocations.
  * 
  * It is worth noting the C++20 std::allocator does aligned allocations, but
  * C++20 has poor support.
@@ -124,6 +185,10 @@ struct aligned_allocator {
         if (ret != 0) {
             throw std::bad_alloc();
         }
+        // Large allocations are usually fresh pages, so setting the policy now avoids migrating them later
+        if (sizeof(T) * n >= NUMA_POLICY_MIN_BYTES) {
+            vtr::apply_numa_policy(data, sizeof(T) * n);
+        }
         return static_cast<pointer>(data);
     }
 
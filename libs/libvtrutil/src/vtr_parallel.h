@@ -0,0 +1,78 @@
+#pragma once
+/**
+ * @file
+ * @brief Helpers to run independent loop iterations in parallel.
+ *
+ * The loops run in parallel in the translation units compiled with
+ * VTR_PARALLEL_USE_TBB defined, whose target must then also link against
+ * TBB, and serially otherwise.
+ */
+
+#include <cstddef>
+
+#ifdef VTR_PARALLEL_USE_TBB
+#include <atomic>
+#include <exception>
+#include <vector>
+
+#include <tbb/parallel_for.h>
+#endif
+
+namespace vtr {
+
+/**
+ * @brief Calls fn(i) for every i in [0, num_indices), where calls for
+ *        different indices may run concurrently.
+ */
+template<typename Fn>
+void parallel_for(size_t num_indices, const Fn& fn) {
+#ifdef VTR_PARALLEL_USE_TBB
+    tbb::parallel_for(size_t(0), num_indices, fn);
+#else
+    for (size_t i = 0; i < num_indices; i++) {
+        fn(i);
+    }
+#endif
+}
+
+/**
+ * @brief Calls fn(i) for every i in [0, num_indices), where calls for
+ *        different indices may run concurrently, and stops at the first
+ *        exception.
+ *
+ * If any call throws, the exception thrown for the lowest index is
+ * rethrown. This is the exception a serial loop would have stopped at, so
+ * the reported error does not depend on the number of threads. Calls for
+ * indices after a failed one may be skipped.
+ */
+template<typename Fn>
+void parallel_for_first_error(size_t num_indices, const Fn& fn) {
+#ifdef VTR_PARALLEL_USE_TBB
+    std::vector<std::exception_ptr> errors(num_indices);
+    std::atomic<size_t> first_failed_index(num_indices);
+    tbb::parallel_for(size_t(0), num_indices, [&](size_t i) {
+        if (i > first_failed_index.load(std::memory_order_relaxed)) {
+            return; //A preceding index has already failed
+        }
+        try {
+            fn(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+            size_t failed_index = first_failed_index.load(std::memory_order_relaxed);
+            while (i < failed_index && !first_failed_index.compare_exchange_weak(failed_index, i, std::memory_order_relaxed)) {
+            }
+        }
+    });
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+#else
+    for (size_t i = 0; i < num_indices; i++) {
+        fn(i);
+    }
+#endif
+}
+
+} // namespace vtr
@@ -0,0 +1,43 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_memory.h"
+
+#include <vector>
+
+TEST_CASE("NUMA policy", "[vtr_memory]") {
+    REQUIRE(vtr::get_num_numa_nodes() >= 1);
+
+    // Large enough to span whole pages
+    std::vector<char> data(4 * vtr::NUMA_POLICY_MIN_BYTES, 0);
+    const vtr::t_numa_policy_stats stats_before = vtr::get_numa_policy_stats();
+
+    SECTION("First touch is a no-op") {
+        REQUIRE(vtr::set_numa_policy(vtr::e_numa_policy::FIRST_TOUCH) == vtr::e_numa_policy::FIRST_TOUCH);
+        REQUIRE(!vtr::apply_numa_policy(data));
+
+        const vtr::t_numa_policy_stats stats = vtr::get_numa_policy_stats();
+        REQUIRE(stats.num_applied == stats_before.num_applied);
+        REQUIRE(stats.num_failed == stats_before.num_failed);
+    }
+
+    SECTION("Interleave is a no-op on hosts with a single memory node") {
+        const vtr::e_numa_policy policy = vtr::set_numa_policy(vtr::e_numa_policy::INTERLEAVE);
+        REQUIRE(policy == vtr::get_numa_policy());
+
+        bool is_applied = vtr::apply_numa_policy(data);
+        const vtr::t_numa_policy_stats stats = vtr::get_numa_policy_stats();
+        if (vtr::get_num_numa_nodes() == 1) {
+            REQUIRE(policy == vtr::e_numa_policy::FIRST_TOUCH);
+            REQUIRE(!is_applied);
+            REQUIRE(stats.num_applied == stats_before.num_applied);
+            REQUIRE(stats.num_failed == stats_before.num_failed);
+        } else {
+            // Each attempt is either applied or reported as failed
+            REQUIRE(policy == vtr::e_numa_policy::INTERLEAVE);
+            REQUIRE(stats.num_applied + stats.num_failed == stats_before.num_applied + stats_before.num_failed + 1);
+            REQUIRE(is_applied == (stats.num_applied == stats_before.num_applied + 1));
+        }
+
+        vtr::set_numa_policy(vtr::e_numa_policy::FIRST_TOUCH);
+    }
+}
@@ -0,0 +1,32 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_parallel.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("Parallel loop visits every index", "[vtr_parallel]") {
+    std::vector<std::atomic<int>> visits(1000);
+    vtr::parallel_for_first_error(visits.size(), [&](size_t i) {
+        visits[i]++;
+    });
+    for (const std::atomic<int>& num_visits : visits) {
+        REQUIRE(num_visits == 1);
+    }
+}
+
+TEST_CASE("Parallel loop rethrows the error of the lowest index", "[vtr_parallel]") {
+    std::string error;
+    try {
+        vtr::parallel_for_first_error(1000, [](size_t i) {
+            if (i % 100 == 37) {
+                throw std::runtime_error(std::to_string(i));
+            }
+        });
+    } catch (const std::runtime_error& e) {
+        error = e.what();
+    }
+    REQUIRE(error == "37");
+}
@@ -7,6 +7,7 @@
  */
 
 #include "analytical_solver.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <limits>
@@ -26,9 +27,14 @@
 #include "vpr_error.h"
 #include "vtr_assert.h"
 #include "vtr_math.h"
+#include "vtr_parallel.h"
 #include "vtr_time.h"
 #include "vtr_vector.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_invoke.h>
+#endif
+
 #ifdef EIGEN_INSTALLED
 // The eigen library contains a warning in GCC13 for a null dereference. This
 // causes the CI build to fail due to the warning. Ignoring the warning for
@@ -48,6 +54,7 @@
 #endif // EIGEN_INSTALLED
 
 std::unique_ptr<AnalyticalSolver> make_analytical_solver(e_ap_analytical_solver solver_type,
+                                                         e_ap_solver_preconditioner preconditioner_type,
                                                          const APNetlist& netlist,
                                                          const DeviceGrid& device_grid,
                                                          const AtomNetlist& atom_netlist,
@@ -84,9 +91,11 @@ std::unique_ptr<AnalyticalSolver> make_analytical_solver(e_ap_analytical_solver
                                                     device_grid,
                                                     atom_netlist,
                                                     pre_cluster_timing_manager,
+                                                    preconditioner_type,
                                                     ap_timing_tradeoff,
                                                     log_verbosity);
 #else
+            (void)preconditioner_type;
             (void)netlist;
             (void)device_grid;
             (void)atom_netlist;
@@ -105,6 +114,7 @@ std::unique_ptr<AnalyticalSolver> make_analytical_solver(e_ap_analytical_solver
                                                atom_netlist,
                                                pre_cluster_timing_manager,
                                                place_delay_model,
+                                               preconditioner_type,
                                                ap_timing_tradeoff,
                                                log_verbosity);
 #else
@@ -208,6 +218,309 @@ void IdentityAnalyticalSolver::print_statistics() {
 
 #ifdef EIGEN_INSTALLED
 
+namespace {
+/**
+ * @brief The result of solving one dimension of a linear system with CG.
+ */
+struct CGSolveResult {
+    /// @brief The solution found by the solver.
+    Eigen::VectorXd soln;
+    /// @brief The number of CG iterations performed.
+    size_t num_iterations = 0;
+    /// @brief Whether the solve succeeded (may be NoConvergence if the
+    ///        maximum number of iterations was reached).
+    Eigen::ComputationInfo info = Eigen::Success;
+};
+
+/**
+ * @brief A CG preconditioner which uses a preconditioner built elsewhere.
+ *
+ * Eigen's solvers can not be copied and build their own preconditioner when
+ * computed. This lets several solvers of the same matrix share one built
+ * preconditioner instead, which is safe to do concurrently since solving
+ * with a preconditioner only reads it.
+ */
+template<typename Preconditioner>
+class SharedPreconditioner {
+  public:
+    /// @brief Shares the given built preconditioner, which must outlive this
+    ///        object.
+    void share(Preconditioner& preconditioner) {
+        preconditioner_ = &preconditioner;
+        info_ = preconditioner.info();
+    }
+
+    /// @brief The shared preconditioner has already been built, so the
+    ///        solver computing its preconditioner does nothing.
+    template<typename MatrixType>
+    SharedPreconditioner& analyzePattern(const MatrixType&) { return *this; }
+    template<typename MatrixType>
+    SharedPreconditioner& factorize(const MatrixType&) { return *this; }
+    template<typename MatrixType>
+    SharedPreconditioner& compute(const MatrixType&) { return *this; }
+
+    template<typename Rhs>
+    auto solve(const Eigen::MatrixBase<Rhs>& b) const {
+        return preconditioner_->solve(b);
+    }
+
+    Eigen::ComputationInfo info() const { return info_; }
+
+  private:
+    const Preconditioner* preconditioner_ = nullptr;
+    Eigen::ComputationInfo info_ = Eigen::InvalidInput;
+};
+
+} // namespace
+
+/// @brief The CG solver used for the symmetric linear systems of the solvers.
+template<typename Preconditioner>
+using CGSolver = Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper, Preconditioner>;
+
+/**
+ * @brief Helper method to set up a CG solver for the matrix A, which builds
+ *        the preconditioner of A.
+ *
+ * If max_iterations is not positive, Eigen's default maximum is used.
+ */
+template<typename Preconditioner>
+static void compute_cg(CGSolver<Preconditioner>& cg,
+                       const Eigen::SparseMatrix<double>& A,
+                       int max_iterations) {
+    cg.compute(A);
+    VTR_ASSERT_MSG(cg.info() == Eigen::Success, "Conjugate Gradient failed at compute!");
+    if (max_iterations > 0)
+        cg.setMaxIterations(max_iterations);
+}
+
+/**
+ * @brief Helper method to solve A * soln = b using a CG solver which has
+ *        already been set up for A, starting from the given guess.
+ *
+ * The solver records the state of its last solve, so a solver must not be
+ * used by two solves at the same time.
+ */
+template<typename Preconditioner>
+static CGSolveResult solve_with_cg(const CGSolver<Preconditioner>& cg,
+                                   const Eigen::VectorXd& b,
+                                   const Eigen::VectorXd& guess) {
+    CGSolveResult result;
+    result.soln = cg.solveWithGuess(b, guess);
+    result.num_iterations = cg.iterations();
+    result.info = cg.info();
+    return result;
+}
+
+/**
+ * @brief Helper method to run the x and y solves of a linear system, which
+ *        are independent, concurrently when VPR is built with TBB.
+ */
+template<typename SolveX, typename SolveY>
+static void solve_xy(const SolveX& solve_x, const SolveY& solve_y) {
+#ifdef VPR_USE_TBB
+    tbb::parallel_invoke(solve_x, solve_y);
+#else
+    solve_x();
+    solve_y();
+#endif
+}
+
+/**
+ * @brief Helper method to solve the x and y dimensions of a linear system,
+ *        where each dimension has its own matrix.
+ *
+ * Each dimension builds the preconditioner of its own matrix, so
+ * preconditioners which are expensive to build are built concurrently too.
+ */
+template<typename Preconditioner>
+static void solve_xy_with_cg(const Eigen::SparseMatrix<double>& A_x,
+                             const Eigen::VectorXd& b_x,
+                             const Eigen::VectorXd& guess_x,
+                             CGSolveResult& result_x,
+                             const Eigen::SparseMatrix<double>& A_y,
+                             const Eigen::VectorXd& b_y,
+                             const Eigen::VectorXd& guess_y,
+                             CGSolveResult& result_y,
+                             int max_iterations) {
+    solve_xy(
+        [&]() {
+            CGSolver<Preconditioner> cg_x;
+            compute_cg(cg_x, A_x, max_iterations);
+            result_x = solve_with_cg(cg_x, b_x, guess_x);
+        },
+        [&]() {
+            CGSolver<Preconditioner> cg_y;
+            compute_cg(cg_y, A_y, max_iterations);
+            result_y = solve_with_cg(cg_y, b_y, guess_y);
+        });
+}
+
+static void solve_xy_with_cg(const Eigen::SparseMatrix<double>& A_x,
+                             const Eigen::VectorXd& b_x,
+                             const Eigen::VectorXd& guess_x,
+                             CGSolveResult& result_x,
+                             const Eigen::SparseMatrix<double>& A_y,
+                             const Eigen::VectorXd& b_y,
+                             const Eigen::VectorXd& guess_y,
+                             CGSolveResult& result_y,
+                             int max_iterations,
+                             e_ap_solver_preconditioner preconditioner_type) {
+    switch (preconditioner_type) {
+        case e_ap_solver_preconditioner::Jacobi:
+            solve_xy_with_cg<Eigen::DiagonalPreconditioner<double>>(A_x, b_x, guess_x, result_x,
+                                                                    A_y, b_y, guess_y, result_y,
+                                                                    max_iterations);
+            break;
+        case e_ap_solver_preconditioner::IncompleteCholesky:
+            solve_xy_with_cg<Eigen::IncompleteCholesky<double>>(A_x, b_x, guess_x, result_x,
+                                                                A_y, b_y, guess_y, result_y,
+                                                                max_iterations);
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_AP,
+                            "Unrecognized analytical solver preconditioner type");
+    }
+}
+
+/**
+ * @brief Helper method to solve the x and y dimensions of a linear system,
+ *        where both dimensions share the matrix A.
+ *
+ * The preconditioner of A is built once and shared by the solvers of both
+ * dimensions.
+ */
+template<typename Preconditioner>
+static void solve_xy_with_shared_cg(const Eigen::SparseMatrix<double>& A,
+                                    const Eigen::VectorXd& b_x,
+                                    const Eigen::VectorXd& guess_x,
+                                    CGSolveResult& result_x,
+                                    const Eigen::VectorXd& b_y,
+                                    const Eigen::VectorXd& guess_y,
+                                    CGSolveResult& result_y,
+                                    int max_iterations) {
+    Preconditioner preconditioner;
+    preconditioner.compute(A);
+    VTR_ASSERT_MSG(preconditioner.info() == Eigen::Success, "Conjugate Gradient failed at compute!");
+
+    solve_xy(
+        [&]() {
+            CGSolver<SharedPreconditioner<Preconditioner>> cg_x;
+            cg_x.preconditioner().share(preconditioner);
+            compute_cg(cg_x, A, max_iterations);
+            result_x = solve_with_cg(cg_x, b_x, guess_x);
+        },
+        [&]() {
+            CGSolver<SharedPreconditioner<Preconditioner>> cg_y;
+            cg_y.preconditioner().share(preconditioner);
+            compute_cg(cg_y, A, max_iterations);
+            result_y = solve_with_cg(cg_y, b_y, guess_y);
+        });
+}
+
+static void solve_xy_with_shared_cg(const Eigen::SparseMatrix<double>& A,
+                                    const Eigen::VectorXd& b_x,
+                                    const Eigen::VectorXd& guess_x,
+                                    CGSolveResult& result_x,
+                                    const Eigen::VectorXd& b_y,
+                                    const Eigen::VectorXd& guess_y,
+                                    CGSolveResult& result_y,
+                                    int max_iterations,
+                                    e_ap_solver_preconditioner preconditioner_type) {
+    switch (preconditioner_type) {
+        case e_ap_solver_preconditioner::Jacobi:
+            solve_xy_with_shared_cg<Eigen::DiagonalPreconditioner<double>>(A, b_x, guess_x, result_x,
+                                                                           b_y, guess_y, result_y,
+                                                                           max_iterations);
+            break;
+        case e_ap_solver_preconditioner::IncompleteCholesky:
+            solve_xy_with_shared_cg<Eigen::IncompleteCholesky<double>>(A, b_x, guess_x, result_x,
+                                                                       b_y, guess_y, result_y,
+                                                                       max_iterations);
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_AP,
+                            "Unrecognized analytical solver preconditioner type");
+    }
+}
+
+/**
+ * @brief Helper method to build a square sparse matrix from a list of triplets,
+ *        where triplets at the same position are summed together.
+ *
+ * This gives the same matrix as Eigen's setFromTriplets, except that every
+ * diagonal entry is stored (even if no triplet touches it) so that the
+ * diagonal can later be updated in place without changing the sparsity
+ * pattern. The triplets are bucketed by column with a counting sort, then the
+ * entries of each column are sorted and summed independently, so the
+ * columns are processed in parallel.
+ */
+static void assemble_sparse_matrix(const std::vector<Eigen::Triplet<double>>& triplets,
+                                   Eigen::SparseMatrix<double>& A_sparse) {
+    using StorageIndex = Eigen::SparseMatrix<double>::StorageIndex;
+    VTR_ASSERT_DEBUG(A_sparse.rows() == A_sparse.cols());
+    const size_t num_cols = A_sparse.cols();
+
+    // Bucket the entries by column. The diagonal entry is the first entry of
+    // each column.
+    std::vector<size_t> col_start(num_cols + 1, 0);
+    for (size_t col = 0; col < num_cols; col++)
+        col_start[col + 1]++;
+    for (const Eigen::Triplet<double>& triplet : triplets)
+        col_start[triplet.col() + 1]++;
+    for (size_t col = 0; col < num_cols; col++)
+        col_start[col + 1] += col_start[col];
+
+    std::vector<std::pair<StorageIndex, double>> entries(col_start[num_cols]);
+    std::vector<size_t> col_fill(col_start.begin(), col_start.end() - 1);
+    for (size_t col = 0; col < num_cols; col++)
+        entries[col_fill[col]++] = {static_cast<StorageIndex>(col), 0.0};
+    for (const Eigen::Triplet<double>& triplet : triplets)
+        entries[col_fill[triplet.col()]++] = {triplet.row(), triplet.value()};
+
+    // Sort each column by row and sum the duplicate entries, compacting each
+    // column to the front of its bucket.
+    std::vector<StorageIndex> col_nnz(num_cols, 0);
+    auto compress_col = [&](size_t col) {
+        auto col_begin = entries.begin() + col_start[col];
+        auto col_end = entries.begin() + col_start[col + 1];
+        std::sort(col_begin, col_end, [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        auto last = col_begin;
+        for (auto it = col_begin + 1; it != col_end; ++it) {
+            if (it->first == last->first) {
+                last->second += it->second;
+            } else {
+                ++last;
+                *last = *it;
+            }
+        }
+        col_nnz[col] = static_cast<StorageIndex>(last - col_begin + 1);
+    };
+    vtr::parallel_for(num_cols, compress_col);
+
+    // Lay the compressed columns out in Eigen's compressed column storage.
+    std::vector<StorageIndex> outer_index(num_cols + 1, 0);
+    for (size_t col = 0; col < num_cols; col++)
+        outer_index[col + 1] = outer_index[col] + col_nnz[col];
+    const size_t nnz = outer_index[num_cols];
+    std::vector<StorageIndex> inner_index(nnz);
+    std::vector<double> values(nnz);
+    auto copy_col = [&](size_t col) {
+        for (StorageIndex i = 0; i < col_nnz[col]; i++) {
+            const auto& [row, value] = entries[col_start[col] + i];
+            inner_index[outer_index[col] + i] = row;
+            values[outer_index[col] + i] = value;
+        }
+    };
+    vtr::parallel_for(num_cols, copy_col);
+
+    A_sparse = Eigen::Map<const Eigen::SparseMatrix<double>>(num_cols, num_cols, nnz,
+                                                             outer_index.data(),
+                                                             inner_index.data(),
+                                                             values.data());
+}
+
 /**
  * @brief Helper method to add a connection between a src moveable node and a
  *        target APBlock with the given weight. This updates the tripleList and
@@ -371,24 +684,40 @@ void QPHybridSolver::init_linear_system() {
     VTR_ASSERT_SAFE(num_star_nodes == star_node_offset);
 
     // Populate the A_sparse matrix using the triplets.
-    A_sparse.setFromTriplets(tripletList.begin(), tripletList.end());
+    assemble_sparse_matrix(tripletList, A_sparse);
+
+    // Only the diagonal of the coefficient matrix changes when anchors are
+    // added. Save where each diagonal entry is stored and its un-anchored
+    // value so it can be updated in place every iteration.
+    diag_value_idx_.resize(num_moveable_blocks_);
+    A_sparse_diag_.resize(num_moveable_blocks_);
+    for (size_t row_id_idx = 0; row_id_idx < num_moveable_blocks_; row_id_idx++) {
+        const auto* col_begin = A_sparse.innerIndexPtr() + A_sparse.outerIndexPtr()[row_id_idx];
+        const auto* col_end = A_sparse.innerIndexPtr() + A_sparse.outerIndexPtr()[row_id_idx + 1];
+        const auto* diag_it = std::lower_bound(col_begin, col_end, static_cast<int>(row_id_idx));
+        VTR_ASSERT(diag_it != col_end && *diag_it == static_cast<int>(row_id_idx));
+        diag_value_idx_[row_id_idx] = diag_it - A_sparse.innerIndexPtr();
+        A_sparse_diag_[row_id_idx] = A_sparse.valuePtr()[diag_value_idx_[row_id_idx]];
+    }
+    b_x_anchored_ = b_x;
+    b_y_anchored_ = b_y;
 }
 
-void QPHybridSolver::update_linear_system_with_anchors(
-    Eigen::SparseMatrix<double>& A_sparse_diff,
-    Eigen::VectorXd& b_x_diff,
-    Eigen::VectorXd& b_y_diff,
-    PartialPlacement& p_placement,
-    unsigned iteration) {
-    // Anchor weights grow exponentially with iteration.
-    double coeff_pseudo_anchor = anchor_weight_mult_ * std::exp((double)iteration / anchor_weight_exp_fac_);
+void QPHybridSolver::update_linear_system_with_anchors(PartialPlacement& p_placement,
+                                                       unsigned iteration) {
+    // Anchor weights grow exponentially with iteration. The first iteration
+    // uses the un-anchored system.
+    double coeff_pseudo_anchor = 0.0;
+    if (iteration != 0)
+        coeff_pseudo_anchor = anchor_weight_mult_ * std::exp((double)iteration / anchor_weight_exp_fac_);
+    double* A_values = A_sparse.valuePtr();
     for (size_t row_id_idx = 0; row_id_idx < num_moveable_blocks_; row_id_idx++) {
         APRowId row_id = APRowId(row_id_idx);
         APBlockId blk_id = row_id_to_blk_id_[row_id];
         double pseudo_w = coeff_pseudo_anchor;
-        A_sparse_diff.coeffRef(row_id_idx, row_id_idx) += pseudo_w;
-        b_x_diff(row_id_idx) += pseudo_w * p_placement.block_x_locs[blk_id];
-        b_y_diff(row_id_idx) += pseudo_w * p_placement.block_y_locs[blk_id];
+        A_values[diag_value_idx_[row_id_idx]] = A_sparse_diag_[row_id_idx] + pseudo_w;
+        b_x_anchored_(row_id_idx) = b_x(row_id_idx) + pseudo_w * p_placement.block_x_locs[blk_id];
+        b_y_anchored_(row_id_idx) = b_y(row_id_idx) + pseudo_w * p_placement.block_y_locs[blk_id];
     }
 }
 
@@ -449,37 +778,31 @@ void QPHybridSolver::solve(unsigned iteration, PartialPlacement& p_placement) {
         return;
     }
 
-    // Create a temporary linear system which will contain the original linear
-    // system which may be updated to include the anchor points.
-    Eigen::SparseMatrix<double> A_sparse_diff = Eigen::SparseMatrix<double>(A_sparse);
-    Eigen::VectorXd b_x_diff = Eigen::VectorXd(b_x);
-    Eigen::VectorXd b_y_diff = Eigen::VectorXd(b_y);
+    // Update the diagonal and the constant vectors of the linear system in
+    // place with the anchor-points for this iteration.
     // In the first iteration, the orginal linear system is used.
     // In any other iteration, use the moveable APBlocks current placement as
     //                         anchor-points (fixed block positions).
-    if (iteration != 0) {
-        update_linear_system_with_anchors(A_sparse_diff, b_x_diff, b_y_diff,
-                                          p_placement, iteration);
-    }
+    update_linear_system_with_anchors(p_placement, iteration);
     // Verify that the constant vectors are valid.
-    VTR_ASSERT_SAFE_MSG(!b_x_diff.hasNaN(), "b_x has NaN!");
-    VTR_ASSERT_SAFE_MSG(!b_y_diff.hasNaN(), "b_y has NaN!");
+    VTR_ASSERT_SAFE_MSG(!b_x_anchored_.hasNaN(), "b_x has NaN!");
+    VTR_ASSERT_SAFE_MSG(!b_y_anchored_.hasNaN(), "b_y has NaN!");
 
-    // Set up the ConjugateGradient Solver using the coefficient matrix.
+    // Solve for x and y using the ConjugateGradient solver. Both dimensions
+    // share the coefficient matrix, so its preconditioner is only built once.
     // TODO: can change cg.tolerance to increase performance when needed
     //  - This tolerance may need to be a function of the number of nets.
     //  - Instead of normalizing the fixed blocks, the tolerance can be scaled
     //    by the size of the device.
-    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> cg;
-    cg.compute(A_sparse_diff);
-    VTR_ASSERT(cg.info() == Eigen::Success && "Conjugate Gradient failed at compute!");
-    // Use the solver to solve for x and y using the constant vectors
-    Eigen::VectorXd x = cg.solveWithGuess(b_x_diff, guess_x);
-    total_num_cg_iters_ += cg.iterations();
-    VTR_ASSERT(cg.info() == Eigen::Success && "Conjugate Gradient failed at solving b_x!");
-    Eigen::VectorXd y = cg.solveWithGuess(b_y_diff, guess_y);
-    total_num_cg_iters_ += cg.iterations();
-    VTR_ASSERT(cg.info() == Eigen::Success && "Conjugate Gradient failed at solving b_y!");
+    CGSolveResult result_x, result_y;
+    solve_xy_with_shared_cg(A_sparse, b_x_anchored_, guess_x, result_x,
+                            b_y_anchored_, guess_y, result_y,
+                            0 /*max_iterations*/, preconditioner_type_);
+    total_num_cg_iters_ += result_x.num_iterations + result_y.num_iterations;
+    VTR_ASSERT(result_x.info == Eigen::Success && "Conjugate Gradient failed at solving b_x!");
+    VTR_ASSERT(result_y.info == Eigen::Success && "Conjugate Gradient failed at solving b_y!");
+    const Eigen::VectorXd& x = result_x.soln;
+    const Eigen::VectorXd& y = result_y.soln;
 
     // Write the results back into the partial placement object.
     store_solution_into_placement(x, y, p_placement);
@@ -705,26 +1028,20 @@ void B2BSolver::b2b_solve_loop(unsigned iteration, PartialPlacement& p_placement
         // Build the solvers for each dimension.
         // Note: Since we have two different connectivity matrices, we need to
         //       different CG solver objects.
+        // The x and y dimensions are independent, so they are solved
+        // concurrently.
         float solve_linear_system_start_time = runtime_timer.elapsed_sec();
-        Eigen::VectorXd x, y;
-        Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> cg_x;
-        Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> cg_y;
-        cg_x.compute(A_sparse_x);
-        cg_y.compute(A_sparse_y);
-        VTR_ASSERT_SAFE_MSG(cg_x.info() == Eigen::Success, "Conjugate Gradient failed at compute for A_x!");
-        VTR_ASSERT_SAFE_MSG(cg_y.info() == Eigen::Success, "Conjugate Gradient failed at compute for A_y!");
-        cg_x.setMaxIterations(max_cg_iterations_);
-        cg_y.setMaxIterations(max_cg_iterations_);
-
-        // Solve the x dimension.
-        x = cg_x.solveWithGuess(b_x, x_guess);
-        total_num_cg_iters_ += cg_x.iterations();
-        VTR_LOGV(log_verbosity_ >= 20, "\t\tNum CG-x iter: %zu\n", cg_x.iterations());
-
-        // Solve the y dimension.
-        y = cg_y.solveWithGuess(b_y, y_guess);
-        total_num_cg_iters_ += cg_y.iterations();
-        VTR_LOGV(log_verbosity_ >= 20, "\t\tNum CG-y iter: %zu\n", cg_y.iterations());
+        CGSolveResult result_x, result_y;
+        solve_xy_with_cg(A_sparse_x, b_x, x_guess, result_x,
+                         A_sparse_y, b_y, y_guess, result_y,
+                         max_cg_iterations_, preconditioner_type_);
+        Eigen::VectorXd& x = result_x.soln;
+        Eigen::VectorXd& y = result_y.soln;
+
+        total_num_cg_iters_ += result_x.num_iterations;
+        VTR_LOGV(log_verbosity_ >= 20, "\t\tNum CG-x iter: %zu\n", result_x.num_iterations);
+        total_num_cg_iters_ += result_y.num_iterations;
+        VTR_LOGV(log_verbosity_ >= 20, "\t\tNum CG-y iter: %zu\n", result_y.num_iterations);
 
         total_time_spent_solving_linear_system_ += runtime_timer.elapsed_sec() - solve_linear_system_start_time;
 
@@ -1199,8 +1516,8 @@ void B2BSolver::init_linear_system(PartialPlacement& p_placement, unsigned itera
     }
 
     // Build the sparse connectivity matrices from the triplets.
-    A_sparse_x.setFromTriplets(triplet_list_x.begin(), triplet_list_x.end());
-    A_sparse_y.setFromTriplets(triplet_list_y.begin(), triplet_list_y.end());
+    assemble_sparse_matrix(triplet_list_x, A_sparse_x);
+    assemble_sparse_matrix(triplet_list_y, A_sparse_y);
 }
 
 // This function adds anchors for legalized solution. Anchors are treated as fixed node,
@@ -168,6 +168,7 @@ class AnalyticalSolver {
  * @brief A factory method which creates an Analytical Solver of the given type.
  */
 std::unique_ptr<AnalyticalSolver> make_analytical_solver(e_ap_analytical_solver solver_type,
+                                                         e_ap_solver_preconditioner preconditioner_type,
                                                          const APNetlist& netlist,
                                                          const DeviceGrid& device_grid,
                                                          const AtomNetlist& atom_netlist,
@@ -307,28 +308,23 @@ class QPHybridSolver : public AnalyticalSolver {
      *        current partial placement.
      *
      * For each moveable block (with row = i) in the netlist:
-     *      A[i][i] = A[i][i] + coeff_pseudo_anchor;
-     *      b[i] = b[i] + pos[block(i)] * coeff_pseudo_anchor;
-     * Where coeff_pseudo_anchor grows with each iteration.
+     *      A[i][i] = A_unanchored[i][i] + coeff_pseudo_anchor;
+     *      b_anchored[i] = b[i] + pos[block(i)] * coeff_pseudo_anchor;
+     * Where coeff_pseudo_anchor grows with each iteration (and is 0 in the
+     * first iteration).
      *
      * This is basically a fast way of adding a connection between all moveable
-     * blocks in the netlist and their target fixed placement location.
+     * blocks in the netlist and their target fixed placement location. The
+     * diagonal of A_sparse is overwritten in place, so the matrix does not need
+     * to be copied or rebuilt every iteration.
      *
      * See add_connection_to_system.
      *
-     *  @param A_sparse_diff    The ceofficient matrix to update.
-     *  @param b_x_diff         The x-dimension constant vector to update.
-     *  @param b_y_diff         The y-dimension constant vector to update.
      *  @param p_placement      The location the moveable blocks should be
      *                          anchored to.
-     *  @param num_moveable_blocks  The number of moveable blocks in the netlist.
-     *  @param row_id_to_blk_id     Lookup for the row id from the APBlock Id.
      *  @param iteration        The current iteration of the Global Placer.
      */
-    void update_linear_system_with_anchors(Eigen::SparseMatrix<double>& A_sparse_diff,
-                                           Eigen::VectorXd& b_x_diff,
-                                           Eigen::VectorXd& b_y_diff,
-                                           PartialPlacement& p_placement,
+    void update_linear_system_with_anchors(PartialPlacement& p_placement,
                                            unsigned iteration);
 
     /**
@@ -340,20 +336,31 @@ class QPHybridSolver : public AnalyticalSolver {
                                        PartialPlacement& p_placement);
 
     // The following variables represent the linear system without any anchor
-    // points. These are filled in the constructor and never modified.
+    // points. These are filled in the constructor.
     // When the anchor-points are taken into consideration, the diagonal of the
-    // coefficient matrix and the elements of the constant vectors are updated
-    // and used in the solver. These are stored to prevent re-computing each
-    // iteration.
-
-    /// @brief The coefficient matrix for the un-anchored linear system
-    /// This is expected to be sparse. This is shared between the x and y
-    /// dimensions.
+    // coefficient matrix is overwritten in place and the anchored constant
+    // vectors are recomputed from the un-anchored ones. The sparsity pattern
+    // of the coefficient matrix never changes.
+
+    /// @brief The coefficient matrix for the linear system. Off of the
+    /// diagonal, this is the un-anchored system; the diagonal holds the
+    /// anchors of the last iteration solved. This is expected to be sparse.
+    /// This is shared between the x and y dimensions.
     Eigen::SparseMatrix<double> A_sparse;
+    /// @brief The diagonal of the coefficient matrix for the un-anchored
+    ///        linear system, for each moveable block row.
+    std::vector<double> A_sparse_diag_;
+    /// @brief The index into the values of A_sparse of the diagonal entry of
+    ///        each moveable block row.
+    std::vector<Eigen::Index> diag_value_idx_;
     /// @brief The constant vector in the x dimension for the linear system.
     Eigen::VectorXd b_x;
     /// @brief The constant vector in the y dimension for the linear system.
     Eigen::VectorXd b_y;
+    /// @brief The constant vector in the x dimension including the anchors.
+    Eigen::VectorXd b_x_anchored_;
+    /// @brief The constant vector in the y dimension including the anchors.
+    Eigen::VectorXd b_y_anchored_;
     /// @brief The number of variables in the solver. This is the sum of the
     ///        number of moveable blocks in the netlist and the number of star
     ///        nodes that exist.
@@ -367,6 +374,9 @@ class QPHybridSolver : public AnalyticalSolver {
     /// @brief The total number of CG iterations this solver has performed so far.
     unsigned total_num_cg_iters_ = 0;
 
+    /// @brief The preconditioner used by the CG solves.
+    e_ap_solver_preconditioner preconditioner_type_;
+
   public:
     /**
      * @brief Constructor of the QPHybridSolver
@@ -377,13 +387,15 @@ class QPHybridSolver : public AnalyticalSolver {
                    const DeviceGrid& device_grid,
                    const AtomNetlist& atom_netlist,
                    const PreClusterTimingManager& pre_cluster_timing_manager,
+                   e_ap_solver_preconditioner preconditioner_type,
                    float ap_timing_tradeoff,
                    int log_verbosity)
         : AnalyticalSolver(netlist,
                            atom_netlist,
                            device_grid,
                            ap_timing_tradeoff,
-                           log_verbosity) {
+                           log_verbosity)
+        , preconditioner_type_(preconditioner_type) {
         // Update the net weights. These net weights are used when the linear
         // system is initialized.
         update_net_weights(pre_cluster_timing_manager);
@@ -537,6 +549,7 @@ class B2BSolver : public AnalyticalSolver {
               const AtomNetlist& atom_netlist,
               const PreClusterTimingManager& pre_cluster_timing_manager,
               std::shared_ptr<PlaceDelayModel> place_delay_model,
+              e_ap_solver_preconditioner preconditioner_type,
               float ap_timing_tradeoff,
               int log_verbosity)
         : AnalyticalSolver(ap_netlist,
@@ -545,7 +558,8 @@ class B2BSolver : public AnalyticalSolver {
                            ap_timing_tradeoff,
                            log_verbosity)
         , pre_cluster_timing_manager_(pre_cluster_timing_manager)
-        , place_delay_model_(place_delay_model) {}
+        , place_delay_model_(place_delay_model)
+        , preconditioner_type_(preconditioner_type) {}
 
     /**
      * @brief Perform an iteration of the B2B solver, storing the result into
@@ -760,6 +774,9 @@ class B2BSolver : public AnalyticalSolver {
     /// @brief The place delay model used for calculating the delay between
     ///        two tiles on the FPGA. Used for computing the timing terms.
     std::shared_ptr<PlaceDelayModel> place_delay_model_;
+
+    /// @brief The preconditioner used by the CG solves.
+    e_ap_solver_preconditioner preconditioner_type_;
 };
 
 #endif // EIGEN_INSTALLED
@@ -6,6 +6,17 @@
  * @brief   Enumerations used by the Analytical Placement Flow.
  */
 
+/**
+ * @brief The type of the Global Placer.
+ *
+ * The Analytical Placement flow may implement different Global Placers. This
+ * enum can select between these different Global Placers.
+ */
+enum class e_ap_global_placer {
+    SimPL,        ///< Global Placer which alternates the Analytical Solver and the Partial Legalizer until their solutions converge.
+    Electrostatic ///< Global Placer which spreads blocks with an FFT-based electrostatic density penalty, optimized with Nesterov's method.
+};
+
 /**
  * @brief The type of an Analytical Solver.
  *
@@ -19,6 +30,18 @@ enum class e_ap_analytical_solver {
     LP_B2B     ///< Analytical Solver which uses the B2B net model to optimize the linear HPWL objective.
 };
 
+/**
+ * @brief The preconditioner used by the Conjugate Gradient solves of the
+ *        Analytical Solvers.
+ *
+ * A stronger preconditioner takes longer to build but reduces the number of
+ * CG iterations needed to solve the linear systems.
+ */
+enum class e_ap_solver_preconditioner {
+    Jacobi,            ///< Scales the system by the inverse of its diagonal. Cheap to build, but does little for poorly conditioned systems.
+    IncompleteCholesky ///< Uses an incomplete Cholesky factorization of the coefficient matrix, which usually cuts the number of CG iterations significantly.
+};
+
 /**
  * @brief The type of a Partial Legalizer.
  *
@@ -0,0 +1,272 @@
+/**
+ * @file
+ * @date    October 2026
+ * @brief   The definition of the Electrostatic Field Solver.
+ */
+
+#include "electrostatic_field_solver.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+#include "vtr_assert.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_parallel.h"
+
+/**
+ * @brief Precomputed tables used to compute the spectral transforms of a
+ *        sequence of length n.
+ *
+ * The cosine (and sine) transforms of length n are computed using a complex
+ * FFT of length 2n over the zero-padded sequence. This is twice as much work
+ * as the most efficient formulations, but both the cosine and sine sums come
+ * out of a single inverse transform.
+ */
+struct t_spectral_transform_plan {
+    /// @brief The length of the sequences being transformed.
+    size_t n;
+    /// @brief The length of the FFT (2n).
+    size_t fft_size;
+    /// @brief The bit-reversed index of each FFT element.
+    std::vector<size_t> bit_reverse;
+    /// @brief The FFT twiddle factors, e^(-2*pi*i*k / fft_size).
+    std::vector<std::complex<double>> twiddles;
+    /// @brief The half-sample shifts of the cosine basis, e^(-i*pi*k / (2n)).
+    std::vector<std::complex<double>> shifts;
+};
+
+/**
+ * @brief Build the transform plan for sequences of length n.
+ */
+static t_spectral_transform_plan make_transform_plan(size_t n) {
+    VTR_ASSERT_MSG(n > 0 && (n & (n - 1)) == 0,
+                   "Spectral transform length must be a power of two");
+    t_spectral_transform_plan plan;
+    plan.n = n;
+    plan.fft_size = 2 * n;
+
+    size_t num_bits = 0;
+    while ((size_t(1) << num_bits) < plan.fft_size)
+        num_bits++;
+    plan.bit_reverse.resize(plan.fft_size);
+    for (size_t i = 0; i < plan.fft_size; i++) {
+        size_t rev = 0;
+        for (size_t b = 0; b < num_bits; b++) {
+            if (i & (size_t(1) << b))
+                rev |= size_t(1) << (num_bits - 1 - b);
+        }
+        plan.bit_reverse[i] = rev;
+    }
+
+    plan.twiddles.resize(plan.fft_size / 2);
+    for (size_t k = 0; k < plan.fft_size / 2; k++)
+        plan.twiddles[k] = std::polar(1.0, -2.0 * std::numbers::pi * k / plan.fft_size);
+
+    plan.shifts.resize(n);
+    for (size_t k = 0; k < n; k++)
+        plan.shifts[k] = std::polar(1.0, -std::numbers::pi * k / (2.0 * n));
+
+    return plan;
+}
+
+/**
+ * @brief In-place radix-2 FFT of the given buffer (of length plan.fft_size).
+ *
+ * The inverse transform is not normalized.
+ */
+static void fft(std::vector<std::complex<double>>& buf,
+                const t_spectral_transform_plan& plan,
+                bool inverse) {
+    const size_t size = plan.fft_size;
+    for (size_t i = 0; i < size; i++) {
+        size_t j = plan.bit_reverse[i];
+        if (i < j)
+            std::swap(buf[i], buf[j]);
+    }
+
+    for (size_t len = 2; len <= size; len <<= 1) {
+        size_t half_len = len / 2;
+        size_t twiddle_stride = size / len;
+        for (size_t start = 0; start < size; start += len) {
+            for (size_t k = 0; k < half_len; k++) {
+                std::complex<double> w = plan.twiddles[k * twiddle_stride];
+                if (inverse)
+                    w = std::conj(w);
+                std::complex<double> even = buf[start + k];
+                std::complex<double> odd = buf[start + k + half_len] * w;
+                buf[start + k] = even + odd;
+                buf[start + k + half_len] = even - odd;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes the DCT-II of the given sequence:
+ *          out[k] = sum_n in[n] * cos(pi * k * (2n + 1) / (2N))
+ */
+static void dct(const double* in,
+                double* out,
+                const t_spectral_transform_plan& plan,
+                std::vector<std::complex<double>>& buf) {
+    buf.assign(plan.fft_size, 0.0);
+    for (size_t i = 0; i < plan.n; i++)
+        buf[i] = in[i];
+    fft(buf, plan, false /*inverse*/);
+    for (size_t k = 0; k < plan.n; k++)
+        out[k] = (plan.shifts[k] * buf[k]).real();
+}
+
+/**
+ * @brief Evaluates the cosine and sine series with the given coefficients at
+ *        the center of each bin:
+ *          cos_out[n] = sum_k coeffs[k] * cos(pi * k * (2n + 1) / (2N))
+ *          sin_out[n] = sum_k coeffs[k] * sin(pi * k * (2n + 1) / (2N))
+ *
+ * Either output may be nullptr if it is not needed.
+ */
+static void inverse_cos_sin(const double* coeffs,
+                            double* cos_out,
+                            double* sin_out,
+                            const t_spectral_transform_plan& plan,
+                            std::vector<std::complex<double>>& buf) {
+    buf.assign(plan.fft_size, 0.0);
+    for (size_t k = 0; k < plan.n; k++)
+        buf[k] = coeffs[k] * std::conj(plan.shifts[k]);
+    fft(buf, plan, true /*inverse*/);
+    for (size_t i = 0; i < plan.n; i++) {
+        if (cos_out)
+            cos_out[i] = buf[i].real();
+        if (sin_out)
+            sin_out[i] = buf[i].imag();
+    }
+}
+
+/**
+ * @brief Calls row_fn(begin, end) over consecutive chunks of rows covering
+ *        [0, num_rows), where different chunks may be processed
+ *        concurrently. Each call reuses its scratch buffers across its chunk.
+ */
+template<typename RowFn>
+static void for_each_row_range(size_t num_rows, const RowFn& row_fn) {
+    constexpr size_t rows_per_chunk = 16;
+    const size_t num_chunks = (num_rows + rows_per_chunk - 1) / rows_per_chunk;
+    vtr::parallel_for(num_chunks, [&](size_t chunk) {
+        size_t begin = chunk * rows_per_chunk;
+        row_fn(begin, std::min(begin + rows_per_chunk, num_rows));
+    });
+}
+
+ElectrostaticFieldSolver::ElectrostaticFieldSolver(size_t num_bins_x,
+                                                   size_t num_bins_y,
+                                                   double width,
+                                                   double height)
+    : num_bins_x_(num_bins_x)
+    , num_bins_y_(num_bins_y)
+    , bin_width_(width / num_bins_x)
+    , bin_height_(height / num_bins_y)
+    , plan_x_(std::make_unique<t_spectral_transform_plan>(make_transform_plan(num_bins_x)))
+    , plan_y_(std::make_unique<t_spectral_transform_plan>(make_transform_plan(num_bins_y))) {
+    VTR_ASSERT(width > 0.0 && height > 0.0);
+    // The potential is a sum of cos(w_u * x) * cos(w_v * y), where the
+    // frequencies are chosen such that the derivatives vanish on the boundary.
+    freq_x_.resize(num_bins_x_);
+    for (size_t u = 0; u < num_bins_x_; u++)
+        freq_x_[u] = std::numbers::pi * u / width;
+    freq_y_.resize(num_bins_y_);
+    for (size_t v = 0; v < num_bins_y_; v++)
+        freq_y_[v] = std::numbers::pi * v / height;
+}
+
+ElectrostaticFieldSolver::~ElectrostaticFieldSolver() = default;
+
+void ElectrostaticFieldSolver::compute_field(const vtr::NdMatrix<double, 2>& density,
+                                             vtr::NdMatrix<double, 2>& field_x,
+                                             vtr::NdMatrix<double, 2>& field_y) const {
+    const size_t nx = num_bins_x_;
+    const size_t ny = num_bins_y_;
+    VTR_ASSERT(density.dim_size(0) == nx && density.dim_size(1) == ny);
+    if (field_x.dim_size(0) != nx || field_x.dim_size(1) != ny)
+        field_x.resize({nx, ny});
+    if (field_y.dim_size(0) != nx || field_y.dim_size(1) != ny)
+        field_y.resize({nx, ny});
+
+    // The 2D transforms are separable, so they are computed as 1D transforms
+    // of the rows followed by 1D transforms of the columns. Intermediate
+    // results are stored transposed ([v][x] or [y][u]) so that every 1D
+    // transform reads and writes contiguous memory.
+    std::vector<double> rows_y(nx * ny);    // [x][v]
+    std::vector<double> coeffs(nx * ny);    // [v][u]
+    std::vector<double> phi_cos_y(nx * ny); // [u][y]
+    std::vector<double> phi_sin_y(nx * ny); // [u][y]
+
+    // DCT of the density along y.
+    for_each_row_range(nx, [&](size_t begin, size_t end) {
+        std::vector<std::complex<double>> buf;
+        for (size_t i = begin; i < end; i++)
+            dct(density[i].data(), &rows_y[i * ny], *plan_y_, buf);
+    });
+
+    // DCT along x, then convert the density coefficients into the potential
+    // coefficients by solving Poisson's equation (laplacian(phi) = -rho) in
+    // the frequency domain.
+    for_each_row_range(ny, [&](size_t begin, size_t end) {
+        std::vector<std::complex<double>> buf;
+        std::vector<double> col(nx);
+        for (size_t v = begin; v < end; v++) {
+            for (size_t i = 0; i < nx; i++)
+                col[i] = rows_y[i * ny + v];
+            double* coeff_row = &coeffs[v * nx];
+            dct(col.data(), coeff_row, *plan_x_, buf);
+            double scale_v = (v == 0 ? 1.0 : 2.0) / ny;
+            for (size_t u = 0; u < nx; u++) {
+                double scale_u = (u == 0 ? 1.0 : 2.0) / nx;
+                double freq_sq = freq_x_[u] * freq_x_[u] + freq_y_[v] * freq_y_[v];
+                // The DC term has no solution and is dropped.
+                if (freq_sq == 0.0)
+                    coeff_row[u] = 0.0;
+                else
+                    coeff_row[u] *= scale_u * scale_v / freq_sq;
+            }
+        }
+    });
+
+    // Evaluate the potential coefficients along y. The x component of the
+    // field needs the cosine sums and the y component needs the derivative
+    // of the cosine basis (a sine sum scaled by the frequency).
+    for_each_row_range(nx, [&](size_t begin, size_t end) {
+        std::vector<std::complex<double>> buf;
+        std::vector<double> row(ny);
+        for (size_t u = begin; u < end; u++) {
+            for (size_t v = 0; v < ny; v++)
+                row[v] = coeffs[v * nx + u];
+            inverse_cos_sin(row.data(), &phi_cos_y[u * ny], nullptr, *plan_y_, buf);
+            for (size_t v = 0; v < ny; v++)
+                row[v] *= freq_y_[v];
+            inverse_cos_sin(row.data(), nullptr, &phi_sin_y[u * ny], *plan_y_, buf);
+        }
+    });
+
+    // Evaluate along x. The field is the negative gradient of the potential:
+    //  E_x = sum phi_uv * w_u * sin(w_u x) * cos(w_v y)
+    //  E_y = sum phi_uv * w_v * cos(w_u x) * sin(w_v y)
+    for_each_row_range(ny, [&](size_t begin, size_t end) {
+        std::vector<std::complex<double>> buf;
+        std::vector<double> col(nx);
+        std::vector<double> out(nx);
+        for (size_t j = begin; j < end; j++) {
+            for (size_t u = 0; u < nx; u++)
+                col[u] = phi_cos_y[u * ny + j] * freq_x_[u];
+            inverse_cos_sin(col.data(), nullptr, out.data(), *plan_x_, buf);
+            for (size_t i = 0; i < nx; i++)
+                field_x[i][j] = out[i];
+
+            for (size_t u = 0; u < nx; u++)
+                col[u] = phi_sin_y[u * ny + j];
+            inverse_cos_sin(col.data(), out.data(), nullptr, *plan_x_, buf);
+            for (size_t i = 0; i < nx; i++)
+                field_y[i][j] = out[i];
+        }
+    });
+}
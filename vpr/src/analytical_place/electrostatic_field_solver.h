@@ -0,0 +1,115 @@
+#pragma once
+/**
+ * @file
+ * @date    October 2026
+ * @brief   The declaration of the Electrostatic Field Solver, which computes
+ *          the electric field of a charge density map over a rectangular
+ *          region using FFT-based spectral methods.
+ *
+ * This is the density model of electrostatics-based global placement (ePlace):
+ * every block is modeled as a positive charge and the density of the placement
+ * is modeled as the potential energy of the system. Moving blocks along the
+ * electric field reduces the potential energy, which spreads blocks out of
+ * dense regions.
+ *
+ * The potential is found by solving Poisson's equation with Neumann boundary
+ * conditions, whose solution can be written as a cosine series. The series
+ * coefficients of the density and the field are computed with the Discrete
+ * Cosine Transform, which is evaluated using the FFT.
+ *      https://doi.org/10.1145/2699873
+ */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "vtr_ndmatrix.h"
+
+// Forward declarations
+struct t_spectral_transform_plan;
+
+/**
+ * @brief Solver for the electric field of a charge density map.
+ *
+ * The region [0, width) x [0, height) is split into num_bins_x by num_bins_y
+ * bins of uniform size. The charge density is given as the charge per unit
+ * area of each bin, and the field is computed at the center of each bin.
+ *
+ * The number of bins in each dimension must be a power of two.
+ *
+ * The DC component of the density is removed before solving (the Neumann
+ * boundary conditions only have a solution for a charge-neutral system), so
+ * a uniform density produces no field.
+ */
+class ElectrostaticFieldSolver {
+  public:
+    /**
+     * @brief Constructor of the Electrostatic Field Solver.
+     *
+     * Precomputes the transform plans for the given bin grid.
+     *
+     *  @param num_bins_x   The number of bins in the x dimension.
+     *  @param num_bins_y   The number of bins in the y dimension.
+     *  @param width        The width of the region the bins cover.
+     *  @param height       The height of the region the bins cover.
+     */
+    ElectrostaticFieldSolver(size_t num_bins_x,
+                             size_t num_bins_y,
+                             double width,
+                             double height);
+
+    ~ElectrostaticFieldSolver();
+
+    /**
+     * @brief Compute the electric field of the given charge density.
+     *
+     * All matrices are indexed [0..num_bins_x-1][0..num_bins_y-1]. The field
+     * matrices are resized if needed.
+     *
+     * When VPR is built with TBB, the transforms of the rows and columns of
+     * the bin grid are computed in parallel.
+     *
+     *  @param density  The charge per unit area of each bin.
+     *  @param field_x  Output: the x component of the field at each bin.
+     *  @param field_y  Output: the y component of the field at each bin.
+     */
+    void compute_field(const vtr::NdMatrix<double, 2>& density,
+                       vtr::NdMatrix<double, 2>& field_x,
+                       vtr::NdMatrix<double, 2>& field_y) const;
+
+    /// @brief The number of bins in the x dimension.
+    inline size_t num_bins_x() const { return num_bins_x_; }
+
+    /// @brief The number of bins in the y dimension.
+    inline size_t num_bins_y() const { return num_bins_y_; }
+
+    /// @brief The width of each bin.
+    inline double bin_width() const { return bin_width_; }
+
+    /// @brief The height of each bin.
+    inline double bin_height() const { return bin_height_; }
+
+  private:
+    /// @brief The number of bins in the x dimension.
+    size_t num_bins_x_;
+
+    /// @brief The number of bins in the y dimension.
+    size_t num_bins_y_;
+
+    /// @brief The width of each bin.
+    double bin_width_;
+
+    /// @brief The height of each bin.
+    double bin_height_;
+
+    /// @brief The frequency of each cosine basis function in the x dimension.
+    std::vector<double> freq_x_;
+
+    /// @brief The frequency of each cosine basis function in the y dimension.
+    std::vector<double> freq_y_;
+
+    /// @brief The transform plan for the rows of length num_bins_x.
+    std::unique_ptr<t_spectral_transform_plan> plan_x_;
+
+    /// @brief The transform plan for the columns of length num_bins_y.
+    std::unique_ptr<t_spectral_transform_plan> plan_y_;
+};
@@ -9,6 +9,8 @@
 
 #include "full_legalizer.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <list>
 #include <memory>
@@ -429,47 +431,79 @@ void FlatRecon::self_clustering(ClusterLegalizer& cluster_legalizer,
                                 const vtr::vector<LogicalModelId, std::vector<t_logical_block_type_ptr>>& primitive_candidate_block_types,
                                 std::unordered_map<t_physical_tile_loc, std::vector<PackMoleculeId>>& tile_blocks) {
     vtr::ScopedStartFinishTimer reconstruction_pass_clustering("Reconstruction Pass Clustering");
-    for (const auto& [tile_loc, tile_molecules] : tile_blocks) {
-        // Get tile type of current tile location.
-        const t_physical_tile_type_ptr tile_type = device_grid.get_physical_type(tile_loc);
+
+    // The clusters of each tile only contain the molecules of that tile, so
+    // the intra-lb routes of the clusters in different tiles can be checked
+    // independently. The tiles are processed in batches: the clusters of every
+    // tile in the batch are created with the fast strategy, then all of them
+    // are checked for legality at once, in parallel. The batches bound the
+    // number of clusters waiting to be checked, which still hold their
+    // intra-lb router data.
+    constexpr size_t tile_batch_size = 1024;
+    std::vector<const std::pair<const t_physical_tile_loc, std::vector<PackMoleculeId>>*> tiles;
+    tiles.reserve(tile_blocks.size());
+    for (const auto& tile_entry : tile_blocks) {
+        tiles.push_back(&tile_entry);
+    }
+
+    for (size_t batch_begin = 0; batch_begin < tiles.size(); batch_begin += tile_batch_size) {
+        size_t batch_end = std::min(batch_begin + tile_batch_size, tiles.size());
 
         // Try to create clusters with fast strategy checking the compatibility
         // with tile and its capacity. Store the cluster ids to check their legality.
         cluster_legalizer.set_legalization_strategy(ClusterLegalizationStrategy::SKIP_INTRA_LB_ROUTE);
-        std::unordered_set<LegalizationClusterId> created_clusters = cluster_molecules_in_tile(tile_loc,
-                                                                                               tile_type,
-                                                                                               tile_molecules,
-                                                                                               cluster_legalizer,
-                                                                                               primitive_candidate_block_types);
-        // Check legality of clusters created with fast pass. Store the
-        // illegal cluster molecules for full strategy pass.
-        std::vector<PackMoleculeId> illegal_cluster_mols;
-        for (LegalizationClusterId cluster_id : created_clusters) {
-            if (!cluster_legalizer.check_cluster_legality(cluster_id)) {
-                for (PackMoleculeId mol_id : cluster_legalizer.get_cluster_molecules(cluster_id)) {
-                    illegal_cluster_mols.push_back(mol_id);
+        std::vector<LegalizationClusterId> clusters_to_check;
+        std::vector<size_t> tile_clusters_offset = {0};
+        for (size_t tile_idx = batch_begin; tile_idx < batch_end; tile_idx++) {
+            const auto& [tile_loc, tile_molecules] = *tiles[tile_idx];
+            const t_physical_tile_type_ptr tile_type = device_grid.get_physical_type(tile_loc);
+            std::unordered_set<LegalizationClusterId> created_clusters = cluster_molecules_in_tile(tile_loc,
+                                                                                                   tile_type,
+                                                                                                   tile_molecules,
+                                                                                                   cluster_legalizer,
+                                                                                                   primitive_candidate_block_types);
+            clusters_to_check.insert(clusters_to_check.end(), created_clusters.begin(), created_clusters.end());
+            tile_clusters_offset.push_back(clusters_to_check.size());
+        }
+
+        // Check legality of clusters created with fast pass.
+        std::vector<bool> is_cluster_legal = cluster_legalizer.check_clusters_legality(clusters_to_check);
+
+        for (size_t tile_idx = batch_begin; tile_idx < batch_end; tile_idx++) {
+            const auto& [tile_loc, tile_molecules] = *tiles[tile_idx];
+            const t_physical_tile_type_ptr tile_type = device_grid.get_physical_type(tile_loc);
+
+            // Store the illegal cluster molecules for full strategy pass.
+            std::vector<PackMoleculeId> illegal_cluster_mols;
+            size_t batch_tile_idx = tile_idx - batch_begin;
+            for (size_t i = tile_clusters_offset[batch_tile_idx]; i < tile_clusters_offset[batch_tile_idx + 1]; i++) {
+                LegalizationClusterId cluster_id = clusters_to_check[i];
+                if (!is_cluster_legal[i]) {
+                    for (PackMoleculeId mol_id : cluster_legalizer.get_cluster_molecules(cluster_id)) {
+                        illegal_cluster_mols.push_back(mol_id);
+                    }
+                    // Erase related data of illegal cluster
+                    loc_to_cluster_id_placed.erase(cluster_locs[cluster_id]);
+                    cluster_legalizer.destroy_cluster(cluster_id);
+                    tile_clusters_matrix[tile_loc.layer_num][tile_loc.x][tile_loc.y].erase(cluster_id);
+                } else {
+                    cluster_legalizer.clean_cluster(cluster_id);
                 }
-                // Erase related data of illegal cluster
-                loc_to_cluster_id_placed.erase(cluster_locs[cluster_id]);
-                cluster_legalizer.destroy_cluster(cluster_id);
-                tile_clusters_matrix[tile_loc.layer_num][tile_loc.x][tile_loc.y].erase(cluster_id);
-            } else {
-                cluster_legalizer.clean_cluster(cluster_id);
             }
-        }
 
-        // If there are any illegal molecules, set the legalization strategy to
-        // full and try to cluster the unclustered molecules in same tile again.
-        if (!illegal_cluster_mols.empty()) {
-            cluster_legalizer.set_legalization_strategy(ClusterLegalizationStrategy::FULL);
-            created_clusters = cluster_molecules_in_tile(tile_loc,
-                                                         tile_type,
-                                                         illegal_cluster_mols,
-                                                         cluster_legalizer,
-                                                         primitive_candidate_block_types);
-            // Clean clusters created with full strategy not to increase memory footprint.
-            for (LegalizationClusterId cluster_id : created_clusters) {
-                cluster_legalizer.clean_cluster(cluster_id);
+            // If there are any illegal molecules, set the legalization strategy to
+            // full and try to cluster the unclustered molecules in same tile again.
+            if (!illegal_cluster_mols.empty()) {
+                cluster_legalizer.set_legalization_strategy(ClusterLegalizationStrategy::FULL);
+                std::unordered_set<LegalizationClusterId> created_clusters = cluster_molecules_in_tile(tile_loc,
+                                                                                                       tile_type,
+                                                                                                       illegal_cluster_mols,
+                                                                                                       cluster_legalizer,
+                                                                                                       primitive_candidate_block_types);
+                // Clean clusters created with full strategy not to increase memory footprint.
+                for (LegalizationClusterId cluster_id : created_clusters) {
+                    cluster_legalizer.clean_cluster(cluster_id);
+                }
             }
         }
     }
@@ -214,7 +214,12 @@ class FlatRecon : public FullLegalizer {
      * Iterates over each tile and first tries to create the fewest clusters
      * in that tile with SKIP_INTRA_LB_ROUTE strategy. If the resulting
      * cluster is found to be unroutable when fully checked, retry adding the
-     * molecules with the FULL strategy before going to next tile.
+     * molecules with the FULL strategy.
+     *
+     * The tiles are processed in batches. The clusters created by the fast
+     * pass in every tile of a batch are fully checked together, in parallel
+     * when VPR is built with TBB, since each only contains molecules of its
+     * own tile.
      *
      *  @param cluster_legalizer               The cluster legalizer which is used to create and grow clusters. The result of
      *                                         this pass is an updated cluster_legalizer.
@@ -7,6 +7,8 @@
  */
 
 #include "global_placer.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <limits>
 #include <memory>
@@ -18,6 +20,7 @@
 #include "ap_netlist_fwd.h"
 #include "atom_netlist.h"
 #include "device_grid.h"
+#include "electrostatic_field_solver.h"
 #include "flat_placement_bins.h"
 #include "flat_placement_density_manager.h"
 #include "globals.h"
@@ -28,10 +31,14 @@
 #include "place_delay_model.h"
 #include "primitive_vector.h"
 #include "timing_info.h"
+#include "vpr_error.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 #include "vtr_time.h"
 
-std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_analytical_solver analytical_solver_type,
+std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_global_placer global_placer_type,
+                                                 e_ap_analytical_solver analytical_solver_type,
+                                                 e_ap_solver_preconditioner solver_preconditioner_type,
                                                  e_ap_partial_legalizer partial_legalizer_type,
                                                  const APNetlist& ap_netlist,
                                                  const Prepacker& prepacker,
@@ -47,25 +54,51 @@ std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_analytical_solver analytic
                                                  const std::vector<std::string>& target_density_arg_strs,
                                                  unsigned num_threads,
                                                  int log_verbosity) {
-    return std::make_unique<SimPLGlobalPlacer>(analytical_solver_type,
-                                               partial_legalizer_type,
-                                               ap_netlist,
-                                               prepacker,
-                                               atom_netlist,
-                                               device_grid,
-                                               logical_block_types,
-                                               physical_tile_types,
-                                               models,
-                                               pre_cluster_timing_manager,
-                                               place_delay_model,
-                                               ap_timing_tradeoff,
-                                               generate_mass_report,
-                                               target_density_arg_strs,
-                                               num_threads,
-                                               log_verbosity);
+    switch (global_placer_type) {
+        case e_ap_global_placer::SimPL:
+            return std::make_unique<SimPLGlobalPlacer>(analytical_solver_type,
+                                                       solver_preconditioner_type,
+                                                       partial_legalizer_type,
+                                                       ap_netlist,
+                                                       prepacker,
+                                                       atom_netlist,
+                                                       device_grid,
+                                                       logical_block_types,
+                                                       physical_tile_types,
+                                                       models,
+                                                       pre_cluster_timing_manager,
+                                                       place_delay_model,
+                                                       ap_timing_tradeoff,
+                                                       generate_mass_report,
+                                                       target_density_arg_strs,
+                                                       num_threads,
+                                                       log_verbosity);
+        case e_ap_global_placer::Electrostatic:
+            return std::make_unique<ElectrostaticGlobalPlacer>(analytical_solver_type,
+                                                               solver_preconditioner_type,
+                                                               partial_legalizer_type,
+                                                               ap_netlist,
+                                                               prepacker,
+                                                               atom_netlist,
+                                                               device_grid,
+                                                               logical_block_types,
+                                                               physical_tile_types,
+                                                               models,
+                                                               pre_cluster_timing_manager,
+                                                               place_delay_model,
+                                                               ap_timing_tradeoff,
+                                                               generate_mass_report,
+                                                               target_density_arg_strs,
+                                                               num_threads,
+                                                               log_verbosity);
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_AP,
+                            "Unrecognized global placer type");
+    }
 }
 
 SimPLGlobalPlacer::SimPLGlobalPlacer(e_ap_analytical_solver analytical_solver_type,
+                                     e_ap_solver_preconditioner solver_preconditioner_type,
                                      e_ap_partial_legalizer partial_legalizer_type,
                                      const APNetlist& ap_netlist,
                                      const Prepacker& prepacker,
@@ -91,6 +124,7 @@ SimPLGlobalPlacer::SimPLGlobalPlacer(e_ap_analytical_solver analytical_solver_ty
     // Build the solver.
     VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the solver...\n");
     solver_ = make_analytical_solver(analytical_solver_type,
+                                     solver_preconditioner_type,
                                      ap_netlist_,
                                      device_grid,
                                      atom_netlist,
@@ -453,3 +487,619 @@ PartialPlacement SimPLGlobalPlacer::place() {
     // Return the placement from the final iteration.
     return best_p_placement;
 }
+
+/**
+ * @brief Helper method to call fn(bin, overlap) for every bin of a uniform
+ *        1D bin grid which overlaps the interval [lo, hi), where overlap is
+ *        the length of the interval inside of the bin.
+ */
+template<typename Fn>
+static void for_each_bin_overlap(double lo,
+                                 double hi,
+                                 double bin_size,
+                                 size_t num_bins,
+                                 const Fn& fn) {
+    lo = std::max(lo, 0.0);
+    hi = std::min(hi, bin_size * num_bins);
+    if (hi <= lo)
+        return;
+    size_t first_bin = std::min(static_cast<size_t>(lo / bin_size), num_bins - 1);
+    for (size_t bin = first_bin; bin < num_bins; bin++) {
+        double bin_lo = bin * bin_size;
+        if (bin_lo >= hi)
+            break;
+        double overlap = std::min(hi, bin_lo + bin_size) - std::max(lo, bin_lo);
+        if (overlap > 0.0)
+            fn(bin, overlap);
+    }
+}
+
+/**
+ * @brief Returns the smallest power of two which is at least n.
+ */
+static size_t next_power_of_two(size_t n) {
+    size_t pow = 1;
+    while (pow < n)
+        pow <<= 1;
+    return pow;
+}
+
+/**
+ * @brief Helper method to clamp a position to just inside of the region
+ *        [0, size).
+ */
+static double clamp_to_region(double pos, double size) {
+    constexpr double epsilon = 0.0001;
+    return std::clamp(pos, epsilon, size - epsilon);
+}
+
+/**
+ * @brief Every block is modeled as a square of this size (in tiles) when its
+ *        charge is spread over the density bins.
+ */
+static constexpr double block_footprint_size = 1.0;
+
+/**
+ * @brief The maximum number of density bins in each dimension.
+ */
+static constexpr size_t max_num_density_bins = 1024;
+
+ElectrostaticGlobalPlacer::ElectrostaticGlobalPlacer(e_ap_analytical_solver analytical_solver_type,
+                                                     e_ap_solver_preconditioner solver_preconditioner_type,
+                                                     e_ap_partial_legalizer partial_legalizer_type,
+                                                     const APNetlist& ap_netlist,
+                                                     const Prepacker& prepacker,
+                                                     const AtomNetlist& atom_netlist,
+                                                     const DeviceGrid& device_grid,
+                                                     const std::vector<t_logical_block_type>& logical_block_types,
+                                                     const std::vector<t_physical_tile_type>& physical_tile_types,
+                                                     const LogicalModels& models,
+                                                     PreClusterTimingManager& pre_cluster_timing_manager,
+                                                     std::shared_ptr<PlaceDelayModel> place_delay_model,
+                                                     float ap_timing_tradeoff,
+                                                     bool generate_mass_report,
+                                                     const std::vector<std::string>& target_density_arg_strs,
+                                                     unsigned num_threads,
+                                                     int log_verbosity)
+    : GlobalPlacer(ap_netlist, log_verbosity)
+    , pre_cluster_timing_manager_(pre_cluster_timing_manager)
+    , place_delay_model_(place_delay_model) {
+    vtr::ScopedStartFinishTimer global_placer_building_timer("Constructing Global Placer");
+
+    // Build the solver used for the initial placement.
+    VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the solver...\n");
+    solver_ = make_analytical_solver(analytical_solver_type,
+                                     solver_preconditioner_type,
+                                     ap_netlist_,
+                                     device_grid,
+                                     atom_netlist,
+                                     pre_cluster_timing_manager_,
+                                     place_delay_model_,
+                                     ap_timing_tradeoff,
+                                     num_threads,
+                                     log_verbosity_);
+
+    // Build the density manager, which defines the capacities of the device.
+    VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the density manager...\n");
+    density_manager_ = std::make_shared<FlatPlacementDensityManager>(ap_netlist_,
+                                                                     prepacker,
+                                                                     atom_netlist,
+                                                                     device_grid,
+                                                                     logical_block_types,
+                                                                     physical_tile_types,
+                                                                     models,
+                                                                     target_density_arg_strs,
+                                                                     log_verbosity_);
+    if (generate_mass_report)
+        density_manager_->generate_mass_report();
+
+    // Build the partial legalizer used to clean up the final placement.
+    VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the partial legalizer...\n");
+    partial_legalizer_ = make_partial_legalizer(partial_legalizer_type,
+                                                ap_netlist_,
+                                                density_manager_,
+                                                prepacker,
+                                                models,
+                                                log_verbosity_);
+
+    // Collect the blocks and nets being optimized.
+    block_num_pins_.resize(ap_netlist_.blocks().size(), 0);
+    for (APBlockId blk_id : ap_netlist_.blocks()) {
+        if (ap_netlist_.block_mobility(blk_id) == APBlockMobility::MOVEABLE)
+            moveable_blocks_.push_back(blk_id);
+    }
+    for (APNetId net_id : ap_netlist_.nets()) {
+        if (ap_netlist_.net_is_ignored(net_id))
+            continue;
+        if (ap_netlist_.net_pins(net_id).size() < 2)
+            continue;
+        nets_.push_back(net_id);
+        for (APPinId pin_id : ap_netlist_.net_pins(net_id))
+            block_num_pins_[ap_netlist_.pin_block(pin_id)]++;
+    }
+    pin_grad_x_.resize(ap_netlist_.pins().size(), 0.0);
+    pin_grad_y_.resize(ap_netlist_.pins().size(), 0.0);
+
+    // Build the density maps.
+    VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the density maps...\n");
+    init_density_maps();
+}
+
+void ElectrostaticGlobalPlacer::init_density_maps() {
+    // The density bins form a uniform grid over the placeable region. The FFT
+    // needs a power of two number of bins, so the bins are at most one tile
+    // wide (unless the device is very large).
+    std::tie(region_width_, region_height_, std::ignore) = density_manager_->get_overall_placeable_region_size();
+    size_t num_bins_x = std::min(next_power_of_two(static_cast<size_t>(std::ceil(region_width_))), max_num_density_bins);
+    size_t num_bins_y = std::min(next_power_of_two(static_cast<size_t>(std::ceil(region_height_))), max_num_density_bins);
+    field_solver_ = std::make_unique<ElectrostaticFieldSolver>(num_bins_x,
+                                                               num_bins_y,
+                                                               region_width_,
+                                                               region_height_);
+    const double bin_width = field_solver_->bin_width();
+    const double bin_height = field_solver_->bin_height();
+    const double bin_area = bin_width * bin_height;
+
+    // Each used primitive dim gets its own density map, since blocks can
+    // only use the capacity of tiles which can hold them.
+    std::vector<PrimitiveVectorDim> dims = density_manager_->get_used_dims_mask().get_non_zero_dims();
+    const size_t num_maps = dims.size();
+    capacity_maps_.assign(num_maps, vtr::NdMatrix<double, 2>({num_bins_x, num_bins_y}, 0.0));
+
+    // Spread the capacity of each tile bin uniformly over its region.
+    const FlatPlacementBins& bins = density_manager_->flat_placement_bins();
+    for (FlatPlacementBinId bin_id : bins.bins()) {
+        const vtr::Rect<double>& region = bins.bin_region(bin_id);
+        double region_area = region.width() * region.height();
+        if (region_area <= 0.0)
+            continue;
+        const PrimitiveVector& capacity = density_manager_->get_bin_capacity(bin_id);
+        double target_density = density_manager_->get_bin_target_density(bin_id);
+        for (size_t map_idx = 0; map_idx < num_maps; map_idx++) {
+            double cap = capacity.get_dim_val(dims[map_idx]);
+            if (cap <= 0.0)
+                continue;
+            double cap_density = target_density * cap / region_area;
+            vtr::NdMatrix<double, 2>& cap_map = capacity_maps_[map_idx];
+            for_each_bin_overlap(region.xmin(), region.xmax(), bin_width, num_bins_x, [&](size_t i, double overlap_x) {
+                for_each_bin_overlap(region.ymin(), region.ymax(), bin_height, num_bins_y, [&](size_t j, double overlap_y) {
+                    cap_map[i][j] += cap_density * overlap_x * overlap_y / bin_area;
+                });
+            });
+        }
+    }
+
+    // The mass of each dim is in different units (e.g. number of LUTs vs
+    // number of DSPs). Normalize the charges so that a fully used tile has a
+    // density of around 1 in every map, which keeps the fields comparable.
+    std::vector<double> map_norms(num_maps, 1.0);
+    for (size_t map_idx = 0; map_idx < num_maps; map_idx++) {
+        const vtr::NdMatrix<double, 2>& cap_map = capacity_maps_[map_idx];
+        double total_cap = 0.0;
+        size_t num_non_zero_bins = 0;
+        for (size_t i = 0; i < cap_map.size(); i++) {
+            if (cap_map.get(i) > 0.0) {
+                total_cap += cap_map.get(i);
+                num_non_zero_bins++;
+            }
+        }
+        if (num_non_zero_bins > 0)
+            map_norms[map_idx] = total_cap / num_non_zero_bins;
+    }
+    for (size_t map_idx = 0; map_idx < num_maps; map_idx++) {
+        vtr::NdMatrix<double, 2>& cap_map = capacity_maps_[map_idx];
+        for (size_t i = 0; i < cap_map.size(); i++)
+            cap_map.get(i) /= map_norms[map_idx];
+    }
+
+    // Compute the charge of each block in each map.
+    map_block_charges_.assign(num_maps, {});
+    block_charges_.resize(ap_netlist_.blocks().size());
+    block_total_charge_.resize(ap_netlist_.blocks().size(), 0.0);
+    total_moveable_charge_ = 0.0;
+    for (APBlockId blk_id : ap_netlist_.blocks()) {
+        const PrimitiveVector& blk_mass = density_manager_->mass_calculator().get_block_mass(blk_id);
+        for (size_t map_idx = 0; map_idx < num_maps; map_idx++) {
+            double mass = blk_mass.get_dim_val(dims[map_idx]);
+            if (mass <= 0.0)
+                continue;
+            double charge = mass / map_norms[map_idx];
+            map_block_charges_[map_idx].emplace_back(blk_id, charge);
+            block_charges_[blk_id].emplace_back(map_idx, charge);
+            block_total_charge_[blk_id] += charge;
+        }
+        if (ap_netlist_.block_mobility(blk_id) == APBlockMobility::MOVEABLE)
+            total_moveable_charge_ += block_total_charge_[blk_id];
+    }
+
+    density_maps_.assign(num_maps, vtr::NdMatrix<double, 2>({num_bins_x, num_bins_y}, 0.0));
+    field_x_maps_.assign(num_maps, vtr::NdMatrix<double, 2>({num_bins_x, num_bins_y}, 0.0));
+    field_y_maps_.assign(num_maps, vtr::NdMatrix<double, 2>({num_bins_x, num_bins_y}, 0.0));
+
+    VTR_LOGV(log_verbosity_ >= 10, "\t\tNumber of density maps: %zu\n", num_maps);
+    VTR_LOGV(log_verbosity_ >= 10, "\t\tDensity bin grid: %zu x %zu\n", num_bins_x, num_bins_y);
+}
+
+void ElectrostaticGlobalPlacer::compute_wirelength_gradient(const PartialPlacement& p_placement,
+                                                            double gamma,
+                                                            vtr::vector<APBlockId, double>& grad_x,
+                                                            vtr::vector<APBlockId, double>& grad_y) {
+    // Compute the gradient of the WA wirelength of each net with respect to
+    // each of its pins. Each net only writes the gradients of its own pins,
+    // so the nets can be computed in parallel.
+    auto compute_net_gradient = [&](const vtr::vector<APBlockId, double>& locs,
+                                    vtr::vector<APPinId, double>& pin_grads,
+                                    APNetId net_id) {
+        double max_loc = std::numeric_limits<double>::lowest();
+        double min_loc = std::numeric_limits<double>::max();
+        for (APPinId pin_id : ap_netlist_.net_pins(net_id)) {
+            double loc = locs[ap_netlist_.pin_block(pin_id)];
+            max_loc = std::max(max_loc, loc);
+            min_loc = std::min(min_loc, loc);
+        }
+        // The exponentials are shifted by the max and min locations to prevent
+        // overflows.
+        double sum_pos = 0.0, weighted_sum_pos = 0.0;
+        double sum_neg = 0.0, weighted_sum_neg = 0.0;
+        for (APPinId pin_id : ap_netlist_.net_pins(net_id)) {
+            double loc = locs[ap_netlist_.pin_block(pin_id)];
+            double exp_pos = std::exp((loc - max_loc) / gamma);
+            double exp_neg = std::exp((min_loc - loc) / gamma);
+            sum_pos += exp_pos;
+            weighted_sum_pos += loc * exp_pos;
+            sum_neg += exp_neg;
+            weighted_sum_neg += loc * exp_neg;
+        }
+        double wa_max = weighted_sum_pos / sum_pos;
+        double wa_min = weighted_sum_neg / sum_neg;
+        for (APPinId pin_id : ap_netlist_.net_pins(net_id)) {
+            double loc = locs[ap_netlist_.pin_block(pin_id)];
+            double exp_pos = std::exp((loc - max_loc) / gamma);
+            double exp_neg = std::exp((min_loc - loc) / gamma);
+            double grad_max = exp_pos / sum_pos * (1.0 + (loc - wa_max) / gamma);
+            double grad_min = exp_neg / sum_neg * (1.0 - (loc - wa_min) / gamma);
+            pin_grads[pin_id] = grad_max - grad_min;
+        }
+    };
+    vtr::parallel_for(nets_.size(), [&](size_t net_idx) {
+        compute_net_gradient(p_placement.block_x_locs, pin_grad_x_, nets_[net_idx]);
+        compute_net_gradient(p_placement.block_y_locs, pin_grad_y_, nets_[net_idx]);
+    });
+
+    // Gather the pin gradients into the blocks. Pins of nets which are not
+    // optimized always have a gradient of zero.
+    vtr::parallel_for(moveable_blocks_.size(), [&](size_t i) {
+        APBlockId blk_id = moveable_blocks_[i];
+        double blk_grad_x = 0.0;
+        double blk_grad_y = 0.0;
+        for (APPinId pin_id : ap_netlist_.block_pins(blk_id)) {
+            blk_grad_x += pin_grad_x_[pin_id];
+            blk_grad_y += pin_grad_y_[pin_id];
+        }
+        grad_x[blk_id] = blk_grad_x;
+        grad_y[blk_id] = blk_grad_y;
+    });
+}
+
+double ElectrostaticGlobalPlacer::compute_density_gradient(const PartialPlacement& p_placement,
+                                                           vtr::vector<APBlockId, double>& grad_x,
+                                                           vtr::vector<APBlockId, double>& grad_y) {
+    const size_t num_bins_x = field_solver_->num_bins_x();
+    const size_t num_bins_y = field_solver_->num_bins_y();
+    const double bin_width = field_solver_->bin_width();
+    const double bin_height = field_solver_->bin_height();
+    const double bin_area = bin_width * bin_height;
+    const double half_footprint = block_footprint_size / 2.0;
+    const size_t num_maps = density_maps_.size();
+
+    // Spread the charges into the bins, compute the overflow, and solve for
+    // the field of each map. The maps are independent.
+    std::vector<double> map_overflow(num_maps, 0.0);
+    vtr::parallel_for(num_maps, [&](size_t map_idx) {
+        vtr::NdMatrix<double, 2>& density = density_maps_[map_idx];
+        density.fill(0.0);
+        for (const auto& [blk_id, charge] : map_block_charges_[map_idx]) {
+            double x = p_placement.block_x_locs[blk_id];
+            double y = p_placement.block_y_locs[blk_id];
+            for_each_bin_overlap(x - half_footprint, x + half_footprint, bin_width, num_bins_x, [&](size_t i, double overlap_x) {
+                for_each_bin_overlap(y - half_footprint, y + half_footprint, bin_height, num_bins_y, [&](size_t j, double overlap_y) {
+                    density[i][j] += charge * overlap_x * overlap_y / (block_footprint_size * block_footprint_size * bin_area);
+                });
+            });
+        }
+
+        // The capacity acts as a negative charge, which attracts blocks
+        // towards regions that can hold them.
+        const vtr::NdMatrix<double, 2>& capacity = capacity_maps_[map_idx];
+        double overflow = 0.0;
+        for (size_t i = 0; i < density.size(); i++) {
+            density.get(i) -= capacity.get(i);
+            overflow += std::max(density.get(i), 0.0) * bin_area;
+        }
+        map_overflow[map_idx] = overflow;
+
+        field_solver_->compute_field(density, field_x_maps_[map_idx], field_y_maps_[map_idx]);
+    });
+
+    // The gradient of the potential energy of a block is its charge times the
+    // negative of the field, averaged over the bins its footprint overlaps.
+    vtr::parallel_for(moveable_blocks_.size(), [&](size_t blk_idx) {
+        APBlockId blk_id = moveable_blocks_[blk_idx];
+        double x = p_placement.block_x_locs[blk_id];
+        double y = p_placement.block_y_locs[blk_id];
+        double blk_grad_x = 0.0;
+        double blk_grad_y = 0.0;
+        for (const auto& [map_idx, charge] : block_charges_[blk_id]) {
+            const vtr::NdMatrix<double, 2>& field_x = field_x_maps_[map_idx];
+            const vtr::NdMatrix<double, 2>& field_y = field_y_maps_[map_idx];
+            double field_sum_x = 0.0;
+            double field_sum_y = 0.0;
+            double area_sum = 0.0;
+            for_each_bin_overlap(x - half_footprint, x + half_footprint, bin_width, num_bins_x, [&](size_t i, double overlap_x) {
+                for_each_bin_overlap(y - half_footprint, y + half_footprint, bin_height, num_bins_y, [&](size_t j, double overlap_y) {
+                    double area = overlap_x * overlap_y;
+                    field_sum_x += field_x[i][j] * area;
+                    field_sum_y += field_y[i][j] * area;
+                    area_sum += area;
+                });
+            });
+            if (area_sum > 0.0) {
+                blk_grad_x -= charge * field_sum_x / area_sum;
+                blk_grad_y -= charge * field_sum_y / area_sum;
+            }
+        }
+        grad_x[blk_id] = blk_grad_x;
+        grad_y[blk_id] = blk_grad_y;
+    });
+
+    double total_overflow = 0.0;
+    for (double overflow : map_overflow)
+        total_overflow += overflow;
+    if (total_moveable_charge_ <= 0.0)
+        return 0.0;
+    return total_overflow / total_moveable_charge_;
+}
+
+/**
+ * @brief Helper method to print the header of the per-iteration status updates
+ *        of the electrostatic global placer.
+ */
+static void print_electrostatic_status_header() {
+    VTR_LOG("----  ----------------  --------  ---------------  ------------  ----------  ----------\n");
+    VTR_LOG("Iter              HPWL  Overflow  Density Penalty  WL Smoothing   Step Size  Total Time\n");
+    VTR_LOG("                                                                                  (sec)\n");
+    VTR_LOG("----  ----------------  --------  ---------------  ------------  ----------  ----------\n");
+}
+
+/**
+ * @brief Helper method to print the per-iteration status of the electrostatic
+ *        global placer.
+ */
+static void print_electrostatic_status(size_t iteration,
+                                       double hpwl,
+                                       double overflow,
+                                       double density_penalty,
+                                       double gamma,
+                                       double step_size,
+                                       float total_time) {
+    VTR_LOG("%4zu  %16.2f  %8.4f  %15.4g  %12.4g  %10.4g  %10.3f\n",
+            iteration,
+            hpwl,
+            overflow,
+            density_penalty,
+            gamma,
+            step_size,
+            total_time);
+
+    fflush(stdout);
+}
+
+PartialPlacement ElectrostaticGlobalPlacer::place() {
+    // Create a timer to time the entire global placement time.
+    vtr::ScopedStartFinishTimer global_placer_time("AP Global Placer");
+    vtr::Timer runtime_timer;
+
+    // Start from the solution of the analytical solver, which optimizes the
+    // wirelength without considering density.
+    PartialPlacement p_placement(ap_netlist_);
+    solver_->solve(0, p_placement);
+    for (APBlockId blk_id : moveable_blocks_) {
+        p_placement.block_x_locs[blk_id] = clamp_to_region(p_placement.block_x_locs[blk_id], region_width_);
+        p_placement.block_y_locs[blk_id] = clamp_to_region(p_placement.block_y_locs[blk_id], region_height_);
+    }
+    float solver_time = runtime_timer.elapsed_sec();
+
+    const size_t num_blocks = ap_netlist_.blocks().size();
+    vtr::vector<APBlockId, double> wl_grad_x(num_blocks, 0.0), wl_grad_y(num_blocks, 0.0);
+    vtr::vector<APBlockId, double> density_grad_x(num_blocks, 0.0), density_grad_y(num_blocks, 0.0);
+
+    // The WA smoothing parameter is scaled with the overflow, so the model is
+    // smooth while blocks are spreading and close to the HPWL near the end.
+    const double avg_bin_size = (field_solver_->bin_width() + field_solver_->bin_height()) / 2.0;
+    auto get_gamma = [&](double overflow) {
+        return 8.0 * avg_bin_size * std::pow(10.0, (20.0 / 9.0) * overflow - 11.0 / 9.0);
+    };
+
+    // Computes the preconditioned gradient of the objective at the given
+    // placement and returns the overflow.
+    // The preconditioner approximates the diagonal of the Hessian of the
+    // objective with the number of pins of each block (wirelength) and its
+    // charge (density).
+    double density_penalty = 0.0;
+    double gamma = get_gamma(1.0);
+    auto compute_gradient = [&](const PartialPlacement& placement,
+                                vtr::vector<APBlockId, double>& grad_x,
+                                vtr::vector<APBlockId, double>& grad_y) {
+        compute_wirelength_gradient(placement, gamma, wl_grad_x, wl_grad_y);
+        double overflow = compute_density_gradient(placement, density_grad_x, density_grad_y);
+        vtr::parallel_for(moveable_blocks_.size(), [&](size_t i) {
+            APBlockId blk_id = moveable_blocks_[i];
+            double precond = std::max(1.0, block_num_pins_[blk_id] + density_penalty * block_total_charge_[blk_id]);
+            grad_x[blk_id] = (wl_grad_x[blk_id] + density_penalty * density_grad_x[blk_id]) / precond;
+            grad_y[blk_id] = (wl_grad_y[blk_id] + density_penalty * density_grad_y[blk_id]) / precond;
+        });
+        return overflow;
+    };
+
+    // The initial density penalty balances the wirelength and density
+    // gradients.
+    compute_wirelength_gradient(p_placement, gamma, wl_grad_x, wl_grad_y);
+    compute_density_gradient(p_placement, density_grad_x, density_grad_y);
+    double wl_grad_norm = 0.0;
+    double density_grad_norm = 0.0;
+    for (APBlockId blk_id : moveable_blocks_) {
+        wl_grad_norm += std::abs(wl_grad_x[blk_id]) + std::abs(wl_grad_y[blk_id]);
+        density_grad_norm += std::abs(density_grad_x[blk_id]) + std::abs(density_grad_y[blk_id]);
+    }
+    density_penalty = density_grad_norm > 0.0 ? wl_grad_norm / density_grad_norm : 1.0;
+
+    // Nesterov's method keeps a major solution (u) and a reference solution
+    // (v) at which the gradient is computed.
+    PartialPlacement u_placement = p_placement;
+    PartialPlacement v_placement = p_placement;
+    vtr::vector<APBlockId, double> grad_x(num_blocks, 0.0), grad_y(num_blocks, 0.0);
+    double overflow = compute_gradient(v_placement, grad_x, grad_y);
+    gamma = get_gamma(overflow);
+
+    // Predict the initial step size from the gradient at a nearby point.
+    double step_size = 0.0;
+    {
+        double max_grad = 0.0;
+        for (APBlockId blk_id : moveable_blocks_)
+            max_grad = std::max({max_grad, std::abs(grad_x[blk_id]), std::abs(grad_y[blk_id])});
+        PartialPlacement trial_placement = v_placement;
+        if (max_grad > 0.0) {
+            double trial_step = 0.1 * avg_bin_size / max_grad;
+            for (APBlockId blk_id : moveable_blocks_) {
+                trial_placement.block_x_locs[blk_id] = clamp_to_region(v_placement.block_x_locs[blk_id] - trial_step * grad_x[blk_id], region_width_);
+                trial_placement.block_y_locs[blk_id] = clamp_to_region(v_placement.block_y_locs[blk_id] - trial_step * grad_y[blk_id], region_height_);
+            }
+            step_size = trial_step;
+        }
+        vtr::vector<APBlockId, double> trial_grad_x(num_blocks, 0.0), trial_grad_y(num_blocks, 0.0);
+        compute_gradient(trial_placement, trial_grad_x, trial_grad_y);
+        double loc_diff_sq = 0.0;
+        double grad_diff_sq = 0.0;
+        for (APBlockId blk_id : moveable_blocks_) {
+            double dx = trial_placement.block_x_locs[blk_id] - v_placement.block_x_locs[blk_id];
+            double dy = trial_placement.block_y_locs[blk_id] - v_placement.block_y_locs[blk_id];
+            double dgx = trial_grad_x[blk_id] - grad_x[blk_id];
+            double dgy = trial_grad_y[blk_id] - grad_y[blk_id];
+            loc_diff_sq += dx * dx + dy * dy;
+            grad_diff_sq += dgx * dgx + dgy * dgy;
+        }
+        if (grad_diff_sq > 0.0)
+            step_size = std::sqrt(loc_diff_sq / grad_diff_sq);
+    }
+
+    if (log_verbosity_ >= 1)
+        print_electrostatic_status_header();
+
+    double prev_hpwl = u_placement.get_hpwl(ap_netlist_);
+    const double ref_hpwl_change = std::max(0.01 * prev_hpwl, 1.0);
+    double nesterov_coeff = 1.0;
+    PartialPlacement next_u_placement = u_placement;
+    PartialPlacement next_v_placement = v_placement;
+    vtr::vector<APBlockId, double> next_grad_x(num_blocks, 0.0), next_grad_y(num_blocks, 0.0);
+    size_t num_iterations = 0;
+    for (size_t iter = 0; iter < max_num_iterations_; iter++) {
+        num_iterations = iter + 1;
+
+        // Take a gradient step from the reference solution and extrapolate
+        // the new reference solution.
+        double next_nesterov_coeff = (1.0 + std::sqrt(4.0 * nesterov_coeff * nesterov_coeff + 1.0)) / 2.0;
+        double momentum = (nesterov_coeff - 1.0) / next_nesterov_coeff;
+        vtr::parallel_for(moveable_blocks_.size(), [&](size_t i) {
+            APBlockId blk_id = moveable_blocks_[i];
+            double new_u_x = clamp_to_region(v_placement.block_x_locs[blk_id] - step_size * grad_x[blk_id], region_width_);
+            double new_u_y = clamp_to_region(v_placement.block_y_locs[blk_id] - step_size * grad_y[blk_id], region_height_);
+            next_v_placement.block_x_locs[blk_id] = clamp_to_region(new_u_x + momentum * (new_u_x - u_placement.block_x_locs[blk_id]), region_width_);
+            next_v_placement.block_y_locs[blk_id] = clamp_to_region(new_u_y + momentum * (new_u_y - u_placement.block_y_locs[blk_id]), region_height_);
+            next_u_placement.block_x_locs[blk_id] = new_u_x;
+            next_u_placement.block_y_locs[blk_id] = new_u_y;
+        });
+        overflow = compute_gradient(next_v_placement, next_grad_x, next_grad_y);
+
+        // Predict the next step size from the inverse of the local Lipschitz
+        // constant of the gradient.
+        double loc_diff_sq = 0.0;
+        double grad_diff_sq = 0.0;
+        for (APBlockId blk_id : moveable_blocks_) {
+            double dx = next_v_placement.block_x_locs[blk_id] - v_placement.block_x_locs[blk_id];
+            double dy = next_v_placement.block_y_locs[blk_id] - v_placement.block_y_locs[blk_id];
+            double dgx = next_grad_x[blk_id] - grad_x[blk_id];
+            double dgy = next_grad_y[blk_id] - grad_y[blk_id];
+            loc_diff_sq += dx * dx + dy * dy;
+            grad_diff_sq += dgx * dgx + dgy * dgy;
+        }
+        if (grad_diff_sq > 0.0)
+            step_size = std::sqrt(loc_diff_sq / grad_diff_sq);
+
+        std::swap(u_placement, next_u_placement);
+        std::swap(v_placement, next_v_placement);
+        std::swap(grad_x, next_grad_x);
+        std::swap(grad_y, next_grad_y);
+        nesterov_coeff = next_nesterov_coeff;
+
+        // Increase the density penalty, slower when the wirelength grows
+        // quickly.
+        double hpwl = u_placement.get_hpwl(ap_netlist_);
+        double penalty_multiplier = std::pow(max_density_penalty_multiplier_, 1.0 - (hpwl - prev_hpwl) / ref_hpwl_change);
+        penalty_multiplier = std::clamp(penalty_multiplier,
+                                        1.0 / max_density_penalty_multiplier_,
+                                        max_density_penalty_multiplier_);
+        density_penalty *= penalty_multiplier;
+        gamma = get_gamma(overflow);
+        prev_hpwl = hpwl;
+
+        bool converged = overflow < target_overflow_;
+        if (log_verbosity_ >= 1 && (iter % 10 == 0 || converged || iter + 1 == max_num_iterations_)) {
+            print_electrostatic_status(iter,
+                                       hpwl,
+                                       overflow,
+                                       density_penalty,
+                                       gamma,
+                                       step_size,
+                                       runtime_timer.elapsed_sec());
+        }
+
+        if (converged)
+            break;
+    }
+    float spreading_time = runtime_timer.elapsed_sec() - solver_time;
+
+    // Clean up the remaining overflow with the partial legalizer.
+    p_placement = u_placement;
+    double pre_legalization_hpwl = p_placement.get_hpwl(ap_netlist_);
+    float legalizer_start_time = runtime_timer.elapsed_sec();
+    partial_legalizer_->legalize(p_placement);
+    float legalizer_time = runtime_timer.elapsed_sec() - legalizer_start_time;
+
+    float timing_update_start_time = runtime_timer.elapsed_sec();
+    update_timing_info_with_gp_placement(pre_cluster_timing_manager_,
+                                         *place_delay_model_.get(),
+                                         p_placement,
+                                         ap_netlist_);
+    float timing_update_time = runtime_timer.elapsed_sec() - timing_update_start_time;
+
+    // Print statistics on the partial legalizer used.
+    partial_legalizer_->print_statistics();
+
+    VTR_LOG("Global Placer Statistics:\n");
+    VTR_LOG("\tNumber of spreading iterations: %zu\n", num_iterations);
+    VTR_LOG("\tFinal density overflow: %f\n", overflow);
+    VTR_LOG("\tHPWL before partial legalization: %f\n", pre_legalization_hpwl);
+    VTR_LOG("\tTime spent in solver: %g seconds\n", solver_time);
+    VTR_LOG("\tTime spent spreading: %g seconds\n", spreading_time);
+    VTR_LOG("\tTime spent in legalizer: %g seconds\n", legalizer_time);
+    VTR_LOG("\tTime spent updating timing: %g seconds\n", timing_update_time);
+
+    // Print some statistics on the final placement.
+    VTR_LOG("Placement after Global Placement:\n");
+    print_placement_stats(p_placement,
+                          ap_netlist_,
+                          *density_manager_,
+                          pre_cluster_timing_manager_);
+
+    return p_placement;
+}
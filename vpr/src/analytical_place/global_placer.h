@@ -14,9 +14,15 @@
  */
 
 #include <memory>
+#include <utility>
+#include <vector>
 #include "ap_flow_enums.h"
+#include "ap_netlist_fwd.h"
+#include "electrostatic_field_solver.h"
 #include "flat_placement_density_manager.h"
 #include "partial_legalizer.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_vector.h"
 
 // Forward declarations
 class APNetlist;
@@ -74,7 +80,9 @@ class GlobalPlacer {
 /**
  * @brief A factory method which creates a Global Placer of the given type.
  */
-std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_analytical_solver analytical_solver_type,
+std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_global_placer global_placer_type,
+                                                 e_ap_analytical_solver analytical_solver_type,
+                                                 e_ap_solver_preconditioner solver_preconditioner_type,
                                                  e_ap_partial_legalizer partial_legalizer_type,
                                                  const APNetlist& ap_netlist,
                                                  const Prepacker& prepacker,
@@ -153,6 +161,7 @@ class SimPLGlobalPlacer : public GlobalPlacer {
      * Constructs the solver and partial legalizer.
      */
     SimPLGlobalPlacer(e_ap_analytical_solver analytical_solver_type,
+                      e_ap_solver_preconditioner solver_preconditioner_type,
                       e_ap_partial_legalizer partial_legalizer_type,
                       const APNetlist& ap_netlist,
                       const Prepacker& prepacker,
@@ -177,3 +186,175 @@ class SimPLGlobalPlacer : public GlobalPlacer {
      */
     PartialPlacement place() final;
 };
+
+/**
+ * @brief A Global Placer based on the ePlace work for electrostatics-based
+ *        analytical placement.
+ *          https://doi.org/10.1145/2699873
+ *
+ * Each block is modeled as a positive charge and the capacity of the device as
+ * a negative charge, so the density of the placement becomes the potential
+ * energy of an electrostatic system. The field of the system is computed with
+ * an FFT-based Poisson solver over a uniform grid of density bins (see
+ * ElectrostaticFieldSolver). Since FPGA blocks can only be placed into tiles
+ * which can hold them, a separate density map is solved for each primitive
+ * dimension used by the netlist (as computed by the density manager's mass
+ * calculator).
+ *
+ * The placer minimizes the smooth weighted-average (WA) wirelength plus the
+ * potential energy (weighted by a density penalty factor) using Nesterov's
+ * accelerated gradient method, with the step size predicted from the local
+ * Lipschitz constant. Starting from the solution of the analytical solver,
+ * the density penalty is increased every iteration until the overflow of the
+ * density bins is small enough. Unlike the SimPL placer, no legalizer is run
+ * inside the loop; the partial legalizer is only run once at the end to clean
+ * up the remaining overflow.
+ *
+ * The wirelength and density gradients, the density maps, and the field
+ * solves are all computed in parallel when VPR is built with TBB.
+ *
+ * TODO: The density maps are projected onto a single layer; 3D devices are
+ *       spread in 2D only and blocks keep the layer given by the solver.
+ */
+class ElectrostaticGlobalPlacer : public GlobalPlacer {
+  private:
+    /// @brief The maximum number of Nesterov iterations the placer can perform.
+    static constexpr size_t max_num_iterations_ = 1000;
+
+    /// @brief The placer stops once the total overflow of the density bins,
+    ///        normalized to the total mass of the moveable blocks, drops below
+    ///        this value.
+    static constexpr double target_overflow_ = 0.1;
+
+    /// @brief The density penalty factor is multiplied by a factor in the
+    ///        range [1 / max, max] every iteration, based on how much the
+    ///        wirelength changed.
+    static constexpr double max_density_penalty_multiplier_ = 1.05;
+
+    /// @brief The solver which generates the initial placement.
+    std::unique_ptr<AnalyticalSolver> solver_;
+
+    /// @brief The density manager which defines the capacities of the device
+    ///        and the mass of the blocks.
+    std::shared_ptr<FlatPlacementDensityManager> density_manager_;
+
+    /// @brief The legalizer which cleans up the final placement.
+    std::unique_ptr<PartialLegalizer> partial_legalizer_;
+
+    /// @brief The pre-cluster timing manager which manages how the timing of
+    ///        the netlist is computed.
+    PreClusterTimingManager& pre_cluster_timing_manager_;
+
+    /// @brief A placement delay model which is used to help compute the delays
+    ///        of connections in the AP netlist.
+    std::shared_ptr<PlaceDelayModel> place_delay_model_;
+
+    /// @brief The solver used to compute the field of each density map.
+    std::unique_ptr<ElectrostaticFieldSolver> field_solver_;
+
+    /// @brief The width and height of the placeable region.
+    double region_width_;
+    double region_height_;
+
+    /// @brief The moveable blocks in the netlist.
+    std::vector<APBlockId> moveable_blocks_;
+
+    /// @brief The nets which have at least two pins and are not ignored.
+    std::vector<APNetId> nets_;
+
+    /// @brief The number of pins each block has on the nets being optimized.
+    vtr::vector<APBlockId, unsigned> block_num_pins_;
+
+    /// @brief The target density times the capacity of each density bin
+    ///        (charge per unit area), for each density map.
+    std::vector<vtr::NdMatrix<double, 2>> capacity_maps_;
+
+    /// @brief The blocks with charge in each density map and their charge.
+    std::vector<std::vector<std::pair<APBlockId, double>>> map_block_charges_;
+
+    /// @brief The charge of each block in each density map it is in, as
+    ///        (density map index, charge).
+    vtr::vector<APBlockId, std::vector<std::pair<size_t, double>>> block_charges_;
+
+    /// @brief The sum of the charges of each block over all density maps.
+    vtr::vector<APBlockId, double> block_total_charge_;
+
+    /// @brief The total charge of all moveable blocks.
+    double total_moveable_charge_ = 0.0;
+
+    /// @brief Scratch storage for the density and field of each density map.
+    std::vector<vtr::NdMatrix<double, 2>> density_maps_;
+    std::vector<vtr::NdMatrix<double, 2>> field_x_maps_;
+    std::vector<vtr::NdMatrix<double, 2>> field_y_maps_;
+
+    /// @brief Scratch storage for the wirelength gradient of each pin.
+    vtr::vector<APPinId, double> pin_grad_x_;
+    vtr::vector<APPinId, double> pin_grad_y_;
+
+    /**
+     * @brief Build the density maps of the device and the charge of each block.
+     */
+    void init_density_maps();
+
+    /**
+     * @brief Compute the gradient of the weighted-average wirelength of the
+     *        given placement for every moveable block.
+     *
+     *  @param p_placement  The placement to compute the gradient at.
+     *  @param gamma        The smoothing parameter of the WA model. Smaller
+     *                      values are closer to the HPWL.
+     *  @param grad_x       Output: the gradient in the x dimension.
+     *  @param grad_y       Output: the gradient in the y dimension.
+     */
+    void compute_wirelength_gradient(const PartialPlacement& p_placement,
+                                     double gamma,
+                                     vtr::vector<APBlockId, double>& grad_x,
+                                     vtr::vector<APBlockId, double>& grad_y);
+
+    /**
+     * @brief Compute the gradient of the potential energy of the given
+     *        placement for every moveable block.
+     *
+     *  @param p_placement  The placement to compute the gradient at.
+     *  @param grad_x       Output: the gradient in the x dimension.
+     *  @param grad_y       Output: the gradient in the y dimension.
+     *
+     *  @return The overflow of the density bins, normalized to the total
+     *          charge of the moveable blocks.
+     */
+    double compute_density_gradient(const PartialPlacement& p_placement,
+                                    vtr::vector<APBlockId, double>& grad_x,
+                                    vtr::vector<APBlockId, double>& grad_y);
+
+  public:
+    /**
+     * @brief Constructor for the Electrostatic Global Placer
+     *
+     * Constructs the solver, the density maps, and the partial legalizer.
+     */
+    ElectrostaticGlobalPlacer(e_ap_analytical_solver analytical_solver_type,
+                              e_ap_solver_preconditioner solver_preconditioner_type,
+                              e_ap_partial_legalizer partial_legalizer_type,
+                              const APNetlist& ap_netlist,
+                              const Prepacker& prepacker,
+                              const AtomNetlist& atom_netlist,
+                              const DeviceGrid& device_grid,
+                              const std::vector<t_logical_block_type>& logical_block_types,
+                              const std::vector<t_physical_tile_type>& physical_tile_types,
+                              const LogicalModels& models,
+                              PreClusterTimingManager& pre_cluster_timing_manager,
+                              std::shared_ptr<PlaceDelayModel> place_delay_model,
+                              float ap_timing_tradeoff,
+                              bool generate_mass_report,
+                              const std::vector<std::string>& target_density_arg_strs,
+                              unsigned num_threads,
+                              int log_verbosity);
+
+    /**
+     * @brief Run the electrostatics-based global placement algorithm.
+     *
+     * Spreads the solver's placement with Nesterov's method until the density
+     * overflow target is met, then partially legalizes the result.
+     */
+    PartialPlacement place() final;
+};
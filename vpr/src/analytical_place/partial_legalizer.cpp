@@ -35,12 +35,17 @@
 #include "vtr_geometry.h"
 #include "vtr_log.h"
 #include "vtr_math.h"
+#include "vtr_parallel.h"
 #include "vtr_prefix_sum.h"
 #include "vtr_strong_id.h"
 #include "vtr_time.h"
 #include "vtr_vector.h"
 #include "vtr_vector_map.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_invoke.h>
+#endif
+
 std::unique_ptr<PartialLegalizer> make_partial_legalizer(e_ap_partial_legalizer legalizer_type,
                                                          const APNetlist& netlist,
                                                          std::shared_ptr<FlatPlacementDensityManager> density_manager,
@@ -1404,61 +1409,21 @@ void BiPartitioningPartialLegalizer::spread_over_windows(std::vector<SpreadingWi
         }
     }
 
-    // Insert the windows into a queue for spreading.
-    std::queue<SpreadingWindow> window_queue;
-    for (SpreadingWindow& window : non_overlapping_windows) {
-        window_queue.push(std::move(window));
-    }
+    // Spread each of the windows. The windows do not share any blocks, so
+    // each is spread independently into its own result.
+    std::vector<SpreadingWindowResult> window_results(non_overlapping_windows.size());
+    vtr::parallel_for(non_overlapping_windows.size(), [&](size_t i) {
+        spread_window(non_overlapping_windows[i], p_placement, group_id, window_results[i]);
+    });
 
-    // For each window in the queue:
-    //      1) If the window is small enough, do not partition further.
-    //      2) Partition the window
-    //      3) Partition the blocks into the window partitions
-    //      4) Insert the new windows into the queue
+    // Merge the results in window order so the result is deterministic.
     std::vector<SpreadingWindow> finished_windows;
-    while (!window_queue.empty()) {
-        // Get a reference to the front of the queue but do not pop it yet. We
-        // can save time from having to copy the element out since these windows
-        // contain vectors.
-        SpreadingWindow& window = window_queue.front();
-
-        // Check if the window is empty. This can happen when there is odd
-        // numbers of blocks or when things do not perfectly fit.
-        if (window.contained_blocks.empty()) {
-            // If the window does not contain any blocks, pop it from the queue
-            // and do not put it in finished windows. There is no point
-            // operating on it further.
-            window_queue.pop();
-            continue;
-        }
-
-        // 1) Check if the window is small enough (one bin in size).
-        // TODO: Perhaps we can make this stopping criteria more intelligent.
-        //       Like stopping when we know there is only one bin within the
-        //       window.
-        double window_area = window.region.width() * window.region.height();
-        if (window_area <= 1.0) {
-            finished_windows.emplace_back(std::move(window));
-            window_queue.pop();
-            continue;
-        }
-
-        num_windows_partitioned_++;
-        num_blocks_partitioned_ += window.contained_blocks.size();
-
-        // 2) Partition the window.
-        auto partitioned_window = partition_window(window, group_id);
-
-        // 3) Partition the blocks.
-        partition_blocks_in_window(window, partitioned_window, group_id, p_placement);
-
-        // 4) Enqueue the new windows.
-        window_queue.push(std::move(partitioned_window.lower_window));
-        window_queue.push(std::move(partitioned_window.upper_window));
-
-        // Pop the top element off the queue. This will invalidate the window
-        // object.
-        window_queue.pop();
+    for (SpreadingWindowResult& window_result : window_results) {
+        num_windows_partitioned_ += window_result.num_windows_partitioned;
+        num_blocks_partitioned_ += window_result.num_blocks_partitioned;
+        std::move(window_result.finished_windows.begin(),
+                  window_result.finished_windows.end(),
+                  std::back_inserter(finished_windows));
     }
 
     if (log_verbosity_ >= 10) {
@@ -1494,6 +1459,66 @@ void BiPartitioningPartialLegalizer::spread_over_windows(std::vector<SpreadingWi
     VTR_ASSERT_SAFE(density_manager_->verify());
 }
 
+void BiPartitioningPartialLegalizer::spread_window(SpreadingWindow& window,
+                                                   const PartialPlacement& p_placement,
+                                                   PrimitiveGroupId group_id,
+                                                   SpreadingWindowResult& result) {
+    // Check if the window is empty. This can happen when there is odd
+    // numbers of blocks or when things do not perfectly fit. There is no point
+    // operating on it further.
+    if (window.contained_blocks.empty())
+        return;
+
+    // 1) Check if the window is small enough (one bin in size).
+    // TODO: Perhaps we can make this stopping criteria more intelligent.
+    //       Like stopping when we know there is only one bin within the
+    //       window.
+    double window_area = window.region.width() * window.region.height();
+    if (window_area <= 1.0) {
+        result.finished_windows.emplace_back(std::move(window));
+        return;
+    }
+
+    result.num_windows_partitioned++;
+    result.num_blocks_partitioned += window.contained_blocks.size();
+
+    // 2) Partition the window.
+    PartitionedWindow partitioned_window = partition_window(window, group_id);
+
+    // 3) Partition the blocks.
+    partition_blocks_in_window(window, partitioned_window, group_id, p_placement);
+
+    // 4) Spread the two partitions. The lower partition is spread into this
+    //    result and the upper partition into its own, which is appended after.
+    //    The finished windows are therefore in depth-first order (all of the
+    //    lower sub-tree before the upper one) whether or not the partitions
+    //    are spread in parallel.
+    SpreadingWindow& lower_window = partitioned_window.lower_window;
+    SpreadingWindow& upper_window = partitioned_window.upper_window;
+    SpreadingWindowResult upper_result;
+#ifdef VPR_USE_TBB
+    // Spawning tasks for small windows costs more than the work they do.
+    constexpr size_t min_blocks_for_parallel_spread = 256;
+    if (lower_window.contained_blocks.size() + upper_window.contained_blocks.size() >= min_blocks_for_parallel_spread) {
+        tbb::parallel_invoke(
+            [&]() { spread_window(lower_window, p_placement, group_id, result); },
+            [&]() { spread_window(upper_window, p_placement, group_id, upper_result); });
+    } else {
+        spread_window(lower_window, p_placement, group_id, result);
+        spread_window(upper_window, p_placement, group_id, upper_result);
+    }
+#else
+    spread_window(lower_window, p_placement, group_id, result);
+    spread_window(upper_window, p_placement, group_id, upper_result);
+#endif
+
+    result.num_windows_partitioned += upper_result.num_windows_partitioned;
+    result.num_blocks_partitioned += upper_result.num_blocks_partitioned;
+    std::move(upper_result.finished_windows.begin(),
+              upper_result.finished_windows.end(),
+              std::back_inserter(result.finished_windows));
+}
+
 PartitionedWindow BiPartitioningPartialLegalizer::partition_window(
     SpreadingWindow& window,
     PrimitiveGroupId group_id) {
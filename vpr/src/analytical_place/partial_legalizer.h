@@ -322,6 +322,25 @@ struct PartitionedWindow {
     SpreadingWindow upper_window;
 };
 
+/**
+ * @brief The result of recursively spreading the blocks of a window.
+ *
+ * Each sub-tree of the window partitioning writes into its own result, which
+ * allows the sub-trees to be spread independently.
+ */
+struct SpreadingWindowResult {
+    /// @brief The windows which are small enough to not be partitioned further,
+    ///        in depth-first order of the partitioning tree (the whole lower
+    ///        sub-tree before the upper one).
+    std::vector<SpreadingWindow> finished_windows;
+
+    /// @brief The number of windows partitioned in this sub-tree.
+    unsigned num_windows_partitioned = 0;
+
+    /// @brief The number of times a block was partitioned in this sub-tree.
+    unsigned num_blocks_partitioned = 0;
+};
+
 /**
  * @brief Wrapper class around the prefix sum class which creates a prefix sum
  *        for each dim type and has helper methods for getting the sums over
@@ -590,11 +609,29 @@ class BiPartitioningPartialLegalizer : public PartialLegalizer {
      * The partial placement solution from the solver is used to decide which
      * window partition to put a block into. The model group this window is
      * spreading over can make it more efficient to make decisions.
+     *
+     * The windows (and the two partitions of each window) do not share any
+     * blocks, so when VPR is built with TBB the windows are spread as a tree
+     * of parallel tasks. The finished windows are gathered in the order of
+     * the partitioning tree, so the result does not depend on the number of
+     * threads.
      */
     void spread_over_windows(std::vector<SpreadingWindow>& non_overlapping_windows,
                              const PartialPlacement& p_placement,
                              PrimitiveGroupId group_id);
 
+    /**
+     * @brief Recursively partition the given window until every window is
+     *        small enough, collecting the finished windows into the result.
+     *
+     * This only reads from the legalizer's state, so it is safe to call on
+     * disjoint windows concurrently.
+     */
+    void spread_window(SpreadingWindow& window,
+                       const PartialPlacement& p_placement,
+                       PrimitiveGroupId group_id,
+                       SpreadingWindowResult& result);
+
     /**
      * @brief Partition the given window into two sub-windows.
      *
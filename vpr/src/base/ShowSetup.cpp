@@ -610,6 +610,18 @@ static void ShowPlacerOpts(const t_placer_opts& PlacerOpts) {
 }
 
 static void ShowAnalyticalPlacerOpts(const t_ap_opts& APOpts) {
+    VTR_LOG("AnalyticalPlacerOpts.global_placer_type: ");
+    switch (APOpts.global_placer_type) {
+        case e_ap_global_placer::SimPL:
+            VTR_LOG("simpl\n");
+            break;
+        case e_ap_global_placer::Electrostatic:
+            VTR_LOG("electrostatic\n");
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown global_placer_type\n");
+    }
+
     VTR_LOG("AnalyticalPlacerOpts.analytical_solver_type: ");
     switch (APOpts.analytical_solver_type) {
         case e_ap_analytical_solver::Identity:
@@ -625,6 +637,18 @@ static void ShowAnalyticalPlacerOpts(const t_ap_opts& APOpts) {
             VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown analytical_solver_type\n");
     }
 
+    VTR_LOG("AnalyticalPlacerOpts.solver_preconditioner_type: ");
+    switch (APOpts.solver_preconditioner_type) {
+        case e_ap_solver_preconditioner::Jacobi:
+            VTR_LOG("jacobi\n");
+            break;
+        case e_ap_solver_preconditioner::IncompleteCholesky:
+            VTR_LOG("incomplete-cholesky\n");
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown solver_preconditioner_type\n");
+    }
+
     VTR_LOG("AnalyticalPlacerOpts.partial_legalizer_type: ");
     switch (APOpts.partial_legalizer_type) {
         case e_ap_partial_legalizer::Identity:
@@ -256,6 +256,10 @@ void BlkLocRegistry::commit_move_blocks(const t_pl_blocks_to_be_moved& blocks_af
         const t_pl_loc& to = moved_block.new_loc;
         const t_pl_loc& from = moved_block.old_loc;
 
+        if (move_journal_active_) {
+            journal_block_move(blk, from);
+        }
+
         // Remove from old location only if it hasn't already been updated by a previous block update
         if (grid_blocks_.block_at_location(from) == blk) {
             grid_blocks_.set_block_at_location(from, ClusterBlockId::INVALID());
@@ -301,6 +305,57 @@ void BlkLocRegistry::revert_move_blocks(const t_pl_blocks_to_be_moved& blocks_af
     expected_transaction_ = e_expected_transaction::APPLY;
 }
 
+void BlkLocRegistry::start_move_journal() {
+    for (const auto& [blk, saved_loc] : move_journal_) {
+        is_move_journaled_[blk] = false;
+    }
+    move_journal_.clear();
+
+    if (is_move_journaled_.size() != block_locs_.size()) {
+        is_move_journaled_.clear();
+        is_move_journaled_.resize(block_locs_.size(), false);
+    }
+
+    move_journal_active_ = true;
+}
+
+void BlkLocRegistry::rollback_move_journal() {
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    VTR_ASSERT(move_journal_active_);
+    VTR_ASSERT(expected_transaction_ == e_expected_transaction::APPLY);
+
+    // Vacate the current locations of the moved blocks first, since a block
+    // may be restored to a location currently occupied by another moved block.
+    // Blocks which were not moved are still at their journaled locations.
+    for (const auto& [blk, saved_loc] : move_journal_) {
+        const t_pl_loc& cur_loc = block_locs_[blk].loc;
+        if (grid_blocks_.block_at_location(cur_loc) == blk) {
+            grid_blocks_.set_block_at_location(cur_loc, ClusterBlockId::INVALID());
+        }
+    }
+
+    for (const auto& [blk, saved_loc] : move_journal_) {
+        const t_pl_loc cur_loc = block_locs_[blk].loc;
+        block_locs_[blk].loc = saved_loc;
+        grid_blocks_.set_block_at_location(saved_loc, blk);
+
+        // if the physical tile type changes, sync the physical pins with the restored location
+        t_physical_tile_type_ptr cur_type = device_ctx.grid.get_physical_type({cur_loc.x, cur_loc.y, cur_loc.layer});
+        t_physical_tile_type_ptr saved_type = device_ctx.grid.get_physical_type({saved_loc.x, saved_loc.y, saved_loc.layer});
+        if (cur_type != saved_type) {
+            place_sync_external_block_connections(blk);
+        }
+    }
+
+    start_move_journal();
+}
+
+void BlkLocRegistry::stop_move_journal() {
+    start_move_journal();
+    move_journal_active_ = false;
+}
+
 t_physical_tile_loc BlkLocRegistry::get_coordinate_of_pin(ClusterPinId pin) const {
     const auto& cluster_ctx = g_vpr_ctx.clustering();
 
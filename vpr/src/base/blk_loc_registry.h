@@ -150,6 +150,30 @@ class BlkLocRegistry {
      */
     void revert_move_blocks(const t_pl_blocks_to_be_moved& blocks_affected);
 
+    /**
+     * @brief Starts (or restarts) the move journal.
+     *
+     * While the journal is active, the location each block had when the journal
+     * was started is recorded the first time the block is moved by commit_move_blocks().
+     * This allows the placement at this point to be restored by rollback_move_journal()
+     * in time proportional to the number of moved blocks, rather than the size of the netlist.
+     * Blocks moved by other means (e.g. set_block_location()) are not recorded.
+     */
+    void start_move_journal();
+
+    /**
+     * @brief Moves all the blocks moved since the last call to start_move_journal() back
+     * to the locations they had at that point, and restarts the journal.
+     * Must not be called between apply_move_blocks() and commit_move_blocks()/revert_move_blocks().
+     */
+    void rollback_move_journal();
+
+    ///@brief Stops recording block moves and discards the journal.
+    void stop_move_journal();
+
+    ///@brief Returns true if block moves are being recorded in the move journal.
+    bool move_journal_active() const { return move_journal_active_; }
+
     /**
      * @brief Returns the coordinates of a cluster pin
      * @param pin The unique Id of the cluster pin whose coordinates is desired.
@@ -163,4 +187,22 @@ class BlkLocRegistry {
     };
 
     e_expected_transaction expected_transaction_;
+
+  private:
+    ///@brief Records the location blk had when the move journal was started, unless it is already recorded.
+    inline void journal_block_move(ClusterBlockId blk, const t_pl_loc& old_loc) {
+        if (!is_move_journaled_[blk]) {
+            is_move_journaled_[blk] = true;
+            move_journal_.emplace_back(blk, old_loc);
+        }
+    }
+
+    ///@brief True while commit_move_blocks() records moves in the journal
+    bool move_journal_active_ = false;
+
+    ///@brief Each block moved since the journal was started, with its location at that point
+    std::vector<std::pair<ClusterBlockId, t_pl_loc>> move_journal_;
+
+    ///@brief Whether each block is already in move_journal_
+    vtr::vector_map<ClusterBlockId, bool> is_move_journaled_;
 };
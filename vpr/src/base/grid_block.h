@@ -59,6 +59,15 @@ class GridBlock {
         return grid_blocks_[loc.layer_num][loc.x][loc.y].blocks.size();
     }
 
+    ///@brief Returns the number of layers of the grid.
+    inline size_t num_layers() const { return grid_blocks_.dim_size(0); }
+
+    ///@brief Returns the width of the grid.
+    inline size_t width() const { return grid_blocks_.dim_size(1); }
+
+    ///@brief Returns the height of the grid.
+    inline size_t height() const { return grid_blocks_.dim_size(2); }
+
     /**
      * @brief Returns the number of subtiles in use at the specified grid location.
      *
@@ -135,6 +135,41 @@ struct ParseCircuitFormat {
     }
 };
 
+struct ParseAPGlobalPlacer {
+    ConvertedValue<e_ap_global_placer> from_str(const std::string& str) {
+        ConvertedValue<e_ap_global_placer> conv_value;
+        if (str == "simpl")
+            conv_value.set_value(e_ap_global_placer::SimPL);
+        else if (str == "electrostatic")
+            conv_value.set_value(e_ap_global_placer::Electrostatic);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_ap_global_placer (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_ap_global_placer val) {
+        ConvertedValue<std::string> conv_value;
+        switch (val) {
+            case e_ap_global_placer::SimPL:
+                conv_value.set_value("simpl");
+                break;
+            case e_ap_global_placer::Electrostatic:
+                conv_value.set_value("electrostatic");
+                break;
+            default:
+                VTR_ASSERT(false);
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"simpl", "electrostatic"};
+    }
+};
+
 struct ParseAPAnalyticalSolver {
     ConvertedValue<e_ap_analytical_solver> from_str(const std::string& str) {
         ConvertedValue<e_ap_analytical_solver> conv_value;
@@ -175,6 +210,41 @@ struct ParseAPAnalyticalSolver {
     }
 };
 
+struct ParseAPSolverPreconditioner {
+    ConvertedValue<e_ap_solver_preconditioner> from_str(const std::string& str) {
+        ConvertedValue<e_ap_solver_preconditioner> conv_value;
+        if (str == "jacobi")
+            conv_value.set_value(e_ap_solver_preconditioner::Jacobi);
+        else if (str == "incomplete-cholesky")
+            conv_value.set_value(e_ap_solver_preconditioner::IncompleteCholesky);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_ap_solver_preconditioner (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_ap_solver_preconditioner val) {
+        ConvertedValue<std::string> conv_value;
+        switch (val) {
+            case e_ap_solver_preconditioner::Jacobi:
+                conv_value.set_value("jacobi");
+                break;
+            case e_ap_solver_preconditioner::IncompleteCholesky:
+                conv_value.set_value("incomplete-cholesky");
+                break;
+            default:
+                VTR_ASSERT(false);
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"jacobi", "incomplete-cholesky"};
+    }
+};
+
 struct ParseAPPartialLegalizer {
     ConvertedValue<e_ap_partial_legalizer> from_str(const std::string& str) {
         ConvertedValue<e_ap_partial_legalizer> conv_value;
@@ -1661,6 +1731,15 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "environment variable; otherwise the default is used.")
         .default_value("1");
 
+    gen_grp.add_argument<bool, ParseOnOff>(args.numa_interleave, "--numa_interleave")
+        .help(
+            "Controls whether the pages of the large routing and placement data structures"
+            " (e.g. the RR graph edges and routing node state) are interleaved over all the"
+            " memory nodes of a NUMA host, rather than placed on the node of the thread which"
+            " initialized them. May speed up parallel routing and placement on multi-socket hosts.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.timing_analysis, "--timing_analysis")
         .help("Controls whether timing analysis (and timing driven optimizations) are enabled.")
         .default_value("on");
@@ -1920,6 +1999,16 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .help("Writes the placement delay lookup to the specified file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.read_place_agent_state, "--read_place_agent_state")
+        .help(
+            "Warm-starts the placement RL agents from the state in the specified file"
+            " (written by --write_place_agent_state) instead of starting them untrained.")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_place_agent_state, "--write_place_agent_state")
+        .help("Writes the state learned by the placement RL agents to the specified file.")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.out_file_prefix, "--outfile_prefix")
         .help("Prefix for output files")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -1978,6 +2067,14 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
 
     auto& ap_grp = parser.add_argument_group("analytical placement options");
 
+    ap_grp.add_argument<e_ap_global_placer, ParseAPGlobalPlacer>(args.ap_global_placer, "--ap_global_placer")
+        .help(
+            "Controls which Global Placer the AP Flow will use.\n"
+            " * simpl: Alternates the Analytical Solver and the Partial Legalizer until the lower-bound and upper-bound placements converge.\n"
+            " * electrostatic: Starts from the Analytical Solver's placement and spreads blocks by minimizing a smooth wirelength plus an FFT-based electrostatic density penalty with Nesterov's method. The Partial Legalizer is only run once at the end.")
+        .default_value("simpl")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     ap_grp.add_argument<e_ap_analytical_solver, ParseAPAnalyticalSolver>(args.ap_analytical_solver, "--ap_analytical_solver")
         .help(
             "Controls which Analytical Solver the Global Placer will use in the AP Flow.\n"
@@ -1987,6 +2084,14 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("lp-b2b")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    ap_grp.add_argument<e_ap_solver_preconditioner, ParseAPSolverPreconditioner>(args.ap_solver_preconditioner, "--ap_solver_preconditioner")
+        .help(
+            "Controls which preconditioner the Analytical Solver uses for the Conjugate Gradient solves of its linear systems.\n"
+            " * jacobi: Diagonal preconditioner. Cheap to build, but may need many iterations to converge.\n"
+            " * incomplete-cholesky: Incomplete Cholesky factorization of the system. More expensive to build, but usually needs far fewer iterations on large netlists.")
+        .default_value("jacobi")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     ap_grp.add_argument<e_ap_partial_legalizer, ParseAPPartialLegalizer>(args.ap_partial_legalizer, "--ap_partial_legalizer")
         .help(
             "Controls which Partial Legalizer the Global Placer will use in the AP Flow.\n"
@@ -2479,6 +2584,14 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("0.05")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_agent_batch_size, "--place_agent_batch_size")
+        .help(
+            "Number of moves between the placement RL agent's Q-table updates. "
+            "With values > 1, the rewards of a batch of moves are applied together and the agent "
+            "samples its actions from probabilities which are only recomputed between batches.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.place_dm_rlim, "--place_dm_rlim")
         .help(
             "The maximum range limit of any directed move other than the uniform move. "
@@ -2543,6 +2656,23 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_multilevel_levels, "--place_multilevel_levels")
+        .help(
+            "The maximum number of coarse levels used by multilevel placement. The clustered netlist "
+            "is coarsened by merging strongly connected blocks into groups, and each level is annealed "
+            "by moving whole groups, from the coarsest level to the flat netlist. "
+            "Only supported on single layer devices. "
+            "0 disables multilevel placement.")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument<bool, ParseOnOff>(args.place_init_parallel, "--place_init_parallel")
+        .help(
+            "Place the block types which can not share a physical tile type concurrently during the initial placement. "
+            "Each group of block types is placed without seeing the blocks placed by the other groups.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument<e_agent_algorithm, ParsePlaceAgentAlgorithm>(args.place_agent_algorithm, "--place_agent_algorithm")
         .help("Controls which placement RL agent is used")
         .default_value("softmax")
@@ -41,6 +41,8 @@ struct t_options {
 
     argparse::ArgValue<std::string> write_placement_delay_lookup;
     argparse::ArgValue<std::string> read_placement_delay_lookup;
+    argparse::ArgValue<std::string> write_place_agent_state;
+    argparse::ArgValue<std::string> read_place_agent_state;
 
     argparse::ArgValue<std::string> write_router_lookahead;
     argparse::ArgValue<std::string> read_router_lookahead;
@@ -70,6 +72,7 @@ struct t_options {
     argparse::ArgValue<bool> show_version;
     argparse::ArgValue<bool> show_arch_resources;
     argparse::ArgValue<size_t> num_workers;
+    argparse::ArgValue<bool> numa_interleave;
     argparse::ArgValue<bool> timing_analysis;
     argparse::ArgValue<e_timing_update_type> timing_update_type;
     argparse::ArgValue<bool> CreateEchoFile;
@@ -102,6 +105,8 @@ struct t_options {
 
     /* Analytical Placement options */
     argparse::ArgValue<e_ap_analytical_solver> ap_analytical_solver;
+    argparse::ArgValue<e_ap_global_placer> ap_global_placer;
+    argparse::ArgValue<e_ap_solver_preconditioner> ap_solver_preconditioner;
     argparse::ArgValue<e_ap_partial_legalizer> ap_partial_legalizer;
     argparse::ArgValue<e_ap_full_legalizer> ap_full_legalizer;
     argparse::ArgValue<e_ap_detailed_placer> ap_detailed_placer;
@@ -156,6 +161,7 @@ struct t_options {
     argparse::ArgValue<bool> place_checkpointing;
     argparse::ArgValue<float> place_agent_epsilon;
     argparse::ArgValue<float> place_agent_gamma;
+    argparse::ArgValue<int> place_agent_batch_size;
     argparse::ArgValue<float> place_dm_rlim;
     argparse::ArgValue<e_agent_space> place_agent_space;
     argparse::ArgValue<e_agent_algorithm> place_agent_algorithm;
@@ -166,6 +172,8 @@ struct t_options {
     argparse::ArgValue<int> floorplan_num_horizontal_partitions;
     argparse::ArgValue<int> floorplan_num_vertical_partitions;
     argparse::ArgValue<bool> place_quench_only;
+    argparse::ArgValue<int> place_multilevel_levels;
+    argparse::ArgValue<bool> place_init_parallel;
 
     argparse::ArgValue<int> placer_debug_block;
     argparse::ArgValue<int> placer_debug_net;
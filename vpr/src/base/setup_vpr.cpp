@@ -580,6 +580,8 @@ static void setup_anneal_sched(const t_options& Options,
 void setup_ap_opts(const t_options& options,
                    t_ap_opts& apOpts) {
     apOpts.analytical_solver_type = options.ap_analytical_solver.value();
+    apOpts.global_placer_type = options.ap_global_placer.value();
+    apOpts.solver_preconditioner_type = options.ap_solver_preconditioner.value();
     apOpts.partial_legalizer_type = options.ap_partial_legalizer.value();
     apOpts.full_legalizer_type = options.ap_full_legalizer.value();
     apOpts.detailed_placer_type = options.ap_detailed_placer.value();
@@ -698,6 +700,8 @@ static void setup_placer_opts(const t_options& Options, t_placer_opts* PlacerOpt
 
     PlacerOpts->write_placement_delay_lookup = Options.write_placement_delay_lookup;
     PlacerOpts->read_placement_delay_lookup = Options.read_placement_delay_lookup;
+    PlacerOpts->write_place_agent_state = Options.write_place_agent_state;
+    PlacerOpts->read_place_agent_state = Options.read_place_agent_state;
 
     PlacerOpts->allowed_tiles_for_delay_model = Options.allowed_tiles_for_delay_model;
 
@@ -712,6 +716,7 @@ static void setup_placer_opts(const t_options& Options, t_placer_opts* PlacerOpt
     PlacerOpts->place_checkpointing = Options.place_checkpointing;
     PlacerOpts->place_agent_epsilon = Options.place_agent_epsilon;
     PlacerOpts->place_agent_gamma = Options.place_agent_gamma;
+    PlacerOpts->place_agent_batch_size = Options.place_agent_batch_size;
     PlacerOpts->place_dm_rlim = Options.place_dm_rlim;
     PlacerOpts->place_agent_space = Options.place_agent_space;
     PlacerOpts->place_reward_fun = Options.place_reward_fun;
@@ -722,6 +727,8 @@ static void setup_placer_opts(const t_options& Options, t_placer_opts* PlacerOpt
     PlacerOpts->floorplan_num_horizontal_partitions = Options.floorplan_num_horizontal_partitions;
     PlacerOpts->floorplan_num_vertical_partitions = Options.floorplan_num_vertical_partitions;
     PlacerOpts->place_quench_only = Options.place_quench_only;
+    PlacerOpts->place_multilevel_levels = Options.place_multilevel_levels;
+    PlacerOpts->place_init_parallel = Options.place_init_parallel;
 
     PlacerOpts->seed = Options.Seed;
 
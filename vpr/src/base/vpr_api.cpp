@@ -26,6 +26,7 @@
 #include "vpr_context.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_memory.h"
 #include "vtr_version.h"
 #include "vtr_time.h"
 
@@ -240,6 +241,14 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     }
 #endif
 
+    if (options->numa_interleave) {
+        if (vtr::set_numa_policy(vtr::e_numa_policy::INTERLEAVE) == vtr::e_numa_policy::INTERLEAVE) {
+            VTR_LOG("Interleaving large data structures over %d NUMA memory nodes\n", vtr::get_num_numa_nodes());
+        } else {
+            VTR_LOG_WARN("Host has a single NUMA memory node (or NUMA is not supported), ignoring --numa_interleave\n");
+        }
+    }
+
     vpr_setup->TimingEnabled = options->timing_analysis;
     vpr_setup->device_layout = options->device_layout;
     vpr_setup->constant_net_method = options->constant_net_method;
@@ -526,6 +535,15 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
         vpr_analysis_flow(router_net_list, vpr_setup, arch, route_status, is_flat);
     }
 
+    if (vtr::get_numa_policy() == vtr::e_numa_policy::INTERLEAVE) {
+        const vtr::t_numa_policy_stats numa_stats = vtr::get_numa_policy_stats();
+        VTR_LOG("Interleaved %zu data structures (%.1f MiB) over %d NUMA memory nodes\n",
+                numa_stats.num_applied, numa_stats.num_bytes_applied / (1024. * 1024.), vtr::get_num_numa_nodes());
+        if (numa_stats.num_failed > 0) {
+            VTR_LOG_WARN("Failed to interleave %zu data structures over the NUMA memory nodes\n", numa_stats.num_failed);
+        }
+    }
+
     //close the graphics
     vpr_close_graphics(vpr_setup);
 
@@ -1036,6 +1036,18 @@ enum class e_move_type;
  *   @param anneal_init_t_estimator
  *              When the annealer is using the automatic schedule, this option
  *              selects which estimator is used to select an initial temperature.
+ *   @param place_multilevel_levels
+ *              The maximum number of coarse levels annealed before the flat
+ *              netlist in multilevel placement. 0 disables multilevel placement.
+ *   @param place_init_parallel
+ *              True if the initial placement places the block types that never
+ *              share a physical tile type concurrently.
+ *   @param place_agent_batch_size
+ *              Number of moves between the RL agent's Q-table updates.
+ *   @param write_place_agent_state
+ *              File to write the state learned by the RL agents to.
+ *   @param read_place_agent_state
+ *              File to warm-start the RL agents from.
  */
 struct t_placer_opts {
     t_place_algorithm place_algorithm;
@@ -1076,6 +1088,8 @@ struct t_placer_opts {
 
     std::string write_placement_delay_lookup;
     std::string read_placement_delay_lookup;
+    std::string write_place_agent_state;
+    std::string read_place_agent_state;
     vtr::vector<e_move_type, float> place_static_move_prob;
     bool RL_agent_placement;
     bool place_agent_multistate;
@@ -1085,6 +1099,7 @@ struct t_placer_opts {
     e_agent_algorithm place_agent_algorithm;
     float place_agent_epsilon;
     float place_agent_gamma;
+    int place_agent_batch_size;
     float place_dm_rlim;
     e_agent_space place_agent_space;
     std::string place_reward_fun;
@@ -1094,6 +1109,8 @@ struct t_placer_opts {
     int floorplan_num_horizontal_partitions;
     int floorplan_num_vertical_partitions;
     bool place_quench_only;
+    int place_multilevel_levels;
+    bool place_init_parallel;
 
     int placer_debug_block;
     int placer_debug_net;
@@ -1123,9 +1140,14 @@ struct t_placer_opts {
  *   @param doAnalyticalPlacement
  *              True if analytical placement is supposed to be done in the CAD
  *              flow. False if otherwise.
+ *   @param global_placer_type
+ *              The type of global placer the AP flow will use.
  *   @param analytical_solver_type
  *              The type of analytical solver the Global Placer in the AP flow
  *              will use.
+ *   @param solver_preconditioner_type
+ *              The preconditioner the Analytical Solver will use when solving
+ *              its linear systems.
  *   @param partial_legalizer_type
  *              The type of partial legalizer the Global Placer in the AP flow
  *              will use.
@@ -1159,8 +1181,12 @@ struct t_placer_opts {
 struct t_ap_opts {
     e_stage_action doAP;
 
+    e_ap_global_placer global_placer_type;
+
     e_ap_analytical_solver analytical_solver_type;
 
+    e_ap_solver_preconditioner solver_preconditioner_type;
+
     e_ap_partial_legalizer partial_legalizer_type;
 
     e_ap_full_legalizer full_legalizer_type;
@@ -35,6 +35,7 @@
 #include "vpr_types.h"
 #include "vpr_utils.h"
 #include "vtr_assert.h"
+#include "vtr_parallel.h"
 #include "vtr_vector.h"
 #include "vtr_vector_map.h"
 
@@ -49,8 +50,8 @@ static void alloc_and_load_pb_stats(t_pb* pb) {
 
     pb->pb_stats = new t_pb_stats;
 
-    pb->pb_stats->input_pins_used = std::vector<std::unordered_map<size_t, AtomNetId>>(pb->pb_graph_node->num_input_pin_class);
-    pb->pb_stats->output_pins_used = std::vector<std::unordered_map<size_t, AtomNetId>>(pb->pb_graph_node->num_output_pin_class);
+    pb->pb_stats->num_input_pins_used = std::vector<size_t>(pb->pb_graph_node->num_input_pin_class, 0);
+    pb->pb_stats->num_output_pins_used = std::vector<size_t>(pb->pb_graph_node->num_output_pin_class, 0);
     pb->pb_stats->lookahead_input_pins_used = std::vector<std::vector<AtomNetId>>(pb->pb_graph_node->num_input_pin_class);
     pb->pb_stats->lookahead_output_pins_used = std::vector<std::vector<AtomNetId>>(pb->pb_graph_node->num_output_pin_class);
 
@@ -860,7 +861,7 @@ static bool check_lookahead_pins_used(t_pb* cur_pb, t_ext_pin_util max_external_
                 // used as 1.0 allowing molecules that are using up to all the cluster inputs to be
                 // packed legally. Therefore, if the seed block is already using more inputs than
                 // the allowed maximum utilization, this should become the new maximum pin utilization.
-                class_size = std::max<size_t>(class_size, cur_pb->pb_stats->input_pins_used[i].size());
+                class_size = std::max<size_t>(class_size, cur_pb->pb_stats->num_input_pins_used[i]);
             }
 
             if (cur_pb->pb_stats->lookahead_input_pins_used[i].size() > class_size) {
@@ -880,7 +881,7 @@ static bool check_lookahead_pins_used(t_pb* cur_pb, t_ext_pin_util max_external_
                 // used as 1.0 allowing molecules that are using up to all the cluster inputs to be
                 // packed legally. Therefore, if the seed block is already using more inputs than
                 // the allowed maximum utilization, this should become the new maximum pin utilization.
-                class_size = std::max<size_t>(class_size, cur_pb->pb_stats->output_pins_used[i].size());
+                class_size = std::max<size_t>(class_size, cur_pb->pb_stats->num_output_pins_used[i]);
             }
 
             if (cur_pb->pb_stats->lookahead_output_pins_used[i].size() > class_size) {
@@ -1015,19 +1016,22 @@ static void commit_lookahead_pins_used(t_pb* cur_pb) {
 
     if (!pb_type->is_primitive() && cur_pb->name) {
         for (int i = 0; i < cur_pb->pb_graph_node->num_input_pin_class; i++) {
-            VTR_ASSERT(cur_pb->pb_stats->lookahead_input_pins_used[i].size() <= (unsigned int)cur_pb->pb_graph_node->input_pin_class_size[i]);
-            for (size_t j = 0; j < cur_pb->pb_stats->lookahead_input_pins_used[i].size(); j++) {
-                VTR_ASSERT(cur_pb->pb_stats->lookahead_input_pins_used[i][j]);
-                cur_pb->pb_stats->input_pins_used[i].insert({j, cur_pb->pb_stats->lookahead_input_pins_used[i][j]});
-            }
+            const std::vector<AtomNetId>& lookahead_nets = cur_pb->pb_stats->lookahead_input_pins_used[i];
+            VTR_ASSERT(lookahead_nets.size() <= (unsigned int)cur_pb->pb_graph_node->input_pin_class_size[i]);
+            VTR_ASSERT_SAFE(std::all_of(lookahead_nets.begin(), lookahead_nets.end(), [](AtomNetId net_id) { return net_id.is_valid(); }));
+            // The lookahead pins are recomputed from every atom in the cluster,
+            // so the committed pins of this class are the first
+            // max(used, lookahead) pins.
+            size_t& num_used = cur_pb->pb_stats->num_input_pins_used[i];
+            num_used = std::max(num_used, lookahead_nets.size());
         }
 
         for (int i = 0; i < cur_pb->pb_graph_node->num_output_pin_class; i++) {
-            VTR_ASSERT(cur_pb->pb_stats->lookahead_output_pins_used[i].size() <= (unsigned int)cur_pb->pb_graph_node->output_pin_class_size[i]);
-            for (size_t j = 0; j < cur_pb->pb_stats->lookahead_output_pins_used[i].size(); j++) {
-                VTR_ASSERT(cur_pb->pb_stats->lookahead_output_pins_used[i][j]);
-                cur_pb->pb_stats->output_pins_used[i].insert({j, cur_pb->pb_stats->lookahead_output_pins_used[i][j]});
-            }
+            const std::vector<AtomNetId>& lookahead_nets = cur_pb->pb_stats->lookahead_output_pins_used[i];
+            VTR_ASSERT(lookahead_nets.size() <= (unsigned int)cur_pb->pb_graph_node->output_pin_class_size[i]);
+            VTR_ASSERT_SAFE(std::all_of(lookahead_nets.begin(), lookahead_nets.end(), [](AtomNetId net_id) { return net_id.is_valid(); }));
+            size_t& num_used = cur_pb->pb_stats->num_output_pins_used[i];
+            num_used = std::max(num_used, lookahead_nets.size());
         }
 
         if (cur_pb->child_pbs) {
@@ -1420,6 +1424,7 @@ ClusterLegalizer::start_new_cluster(PackMoleculeId molecule_id,
     // Allocate and load the LB router data
     t_lb_router_data* router_data = alloc_and_load_router_data(&lb_type_rr_graphs_[cluster_type->index],
                                                                cluster_type);
+    router_data->route_failure_cache = intra_lb_route_failure_cache_.get();
 
     // Allocate and load the cluster's placement stats
     t_intra_cluster_placement_stats* cluster_placement_stats = alloc_and_load_cluster_placement_stats(cluster_type, cluster_mode);
@@ -1595,6 +1600,35 @@ bool ClusterLegalizer::check_cluster_legality(LegalizationClusterId cluster_id)
     return try_intra_lb_route(cluster.router_data, log_verbosity_, &mode_status);
 }
 
+std::vector<bool> ClusterLegalizer::check_clusters_legality(const std::vector<LegalizationClusterId>& cluster_ids) {
+    // Route all the clusters concurrently, each with its own copy of the
+    // illegal modes.
+    std::vector<uint8_t> is_cluster_legal(cluster_ids.size());
+    for (LegalizationClusterId cluster_id : cluster_ids) {
+        isolate_illegal_modes(legalization_clusters_[cluster_id].router_data);
+    }
+    vtr::parallel_for(cluster_ids.size(), [&](size_t i) {
+        is_cluster_legal[i] = check_cluster_legality(cluster_ids[i]);
+    });
+
+    // Up to the first cluster whose route found a new illegal mode, every
+    // route saw the illegal modes it would have seen if the clusters were
+    // checked one after the other. The modes found by that cluster are shared,
+    // and the following clusters are checked again with them.
+    size_t num_checked_clusters = cluster_ids.size();
+    for (size_t i = 0; i < cluster_ids.size(); i++) {
+        bool merge = (num_checked_clusters == cluster_ids.size());
+        if (rejoin_illegal_modes(legalization_clusters_[cluster_ids[i]].router_data, merge) && merge) {
+            num_checked_clusters = i + 1;
+        }
+    }
+    for (size_t i = num_checked_clusters; i < cluster_ids.size(); i++) {
+        is_cluster_legal[i] = check_cluster_legality(cluster_ids[i]);
+    }
+
+    return std::vector<bool>(is_cluster_legal.begin(), is_cluster_legal.end());
+}
+
 ClusterLegalizer::ClusterLegalizer(const AtomNetlist& atom_netlist,
                                    const Prepacker& prepacker,
                                    std::vector<t_lb_type_rr_node>* lb_type_rr_graphs,
@@ -1635,6 +1669,7 @@ ClusterLegalizer::ClusterLegalizer(const AtomNetlist& atom_netlist,
     VTR_ASSERT(g_vpr_ctx.atom().lookup().atom_pb_bimap().is_empty());
     atom_pb_lookup_ = AtomPBBimap();
     intra_lb_pb_pin_lookup_ = IntraLbPbPinLookup(g_vpr_ctx.device().logical_block_types);
+    intra_lb_route_failure_cache_ = std::make_unique<IntraLbRouteFailureCache>();
 }
 
 void ClusterLegalizer::reset() {
@@ -1756,7 +1791,7 @@ size_t ClusterLegalizer::get_num_cluster_inputs_available(LegalizationClusterId
     // Count the number of inputs available per pin class.
     size_t inputs_avail = 0;
     for (int i = 0; i < cluster.pb->pb_graph_node->num_input_pin_class; i++) {
-        inputs_avail += cluster.pb->pb_stats->input_pins_used[i].size();
+        inputs_avail += cluster.pb->pb_stats->num_input_pins_used[i];
     }
 
     return inputs_avail;
@@ -11,6 +11,7 @@
  * externally to the Packer in VPR.
  */
 
+#include <memory>
 #include <vector>
 #include "atom_netlist_fwd.h"
 #include "noc_data_types.h"
@@ -25,6 +26,7 @@
 #include "vpr_utils.h"
 
 // Forward declarations
+class IntraLbRouteFailureCache;
 class Prepacker;
 class LogicalModels;
 class t_intra_cluster_placement_stats;
@@ -370,6 +372,22 @@ class ClusterLegalizer {
      */
     bool check_cluster_legality(LegalizationClusterId cluster_id);
 
+    /*
+     * @brief Check that each of the given clusters is fully legal.
+     *
+     * This gives the same results as calling check_cluster_legality on each
+     * of the clusters in order, but the intra_lb_routes of the clusters are
+     * run concurrently. Each route uses its own copy of the modes found
+     * illegal so far for its logical block type. If a route finds a new
+     * illegal mode, which the routes of the following clusters would have
+     * seen, those clusters are checked again one after the other.
+     *
+     *  @param cluster_ids      The IDs of the clusters to check.
+     *
+     *  @return                 For each cluster, true if it is legal.
+     */
+    std::vector<bool> check_clusters_legality(const std::vector<LegalizationClusterId>& cluster_ids);
+
     /*
      * @brief Cleans the cluster of unnessary data, reducing the memory footprint.
      *
@@ -602,4 +620,8 @@ class ClusterLegalizer {
 
     /// @brief A lookup table for the pin mapping of the intra-lb pb pins.
     IntraLbPbPinLookup intra_lb_pb_pin_lookup_;
+
+    /// @brief Cache of the intra-lb routing problems found to be unroutable,
+    ///        shared by the intra-lb routers of all clusters.
+    std::unique_ptr<IntraLbRouteFailureCache> intra_lb_route_failure_cache_;
 };
@@ -15,11 +15,12 @@
 #include <cstdio>
 #include <cstring>
 #include <vector>
-#include <map>
 #include <queue>
 #include <cmath>
+#include <algorithm>
 
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 #include "vtr_log.h"
 
 #include "vpr_error.h"
@@ -64,6 +65,11 @@ class reservable_pq : public std::priority_queue<T, U, V> {
         this->c.clear();
         this->c.reserve(cur_cap);
     }
+    /* Exchange the underlying container with the given one. This allows the storage of the queue to be kept
+     * between routes. */
+    void swap_container(U& container) {
+        std::swap(this->c, container);
+    }
 
   private:
     size_type cur_cap;
@@ -107,6 +113,8 @@ static bool is_route_success(t_lb_router_data* router_data);
 static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index);
 static void reset_explored_node_tb(t_lb_router_data* router_data);
 static void save_and_reset_lb_route(t_lb_router_data* router_data);
+static void prune_nodes_with_mode(t_lb_router_data* router_data);
+static void load_intra_lb_route_signature(t_lb_router_data* router_data);
 
 /**
  * @brief Recurse through route tree trace to populate pb pin to atom net lookup array.
@@ -158,7 +166,6 @@ t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_
     router_data->lb_rr_node_stats = new t_lb_rr_node_stats[size];
     router_data->explored_node_tb = new t_explored_node_tb[size];
     router_data->intra_lb_nets = new std::vector<t_intra_lb_net>;
-    router_data->atoms_added = new std::map<AtomBlockId, bool>;
     router_data->lb_type = type;
 
     return router_data;
@@ -172,8 +179,6 @@ void free_router_data(t_lb_router_data* router_data) {
         delete[] router_data->explored_node_tb;
         router_data->explored_node_tb = nullptr;
         router_data->lb_type_graph = nullptr;
-        delete router_data->atoms_added;
-        router_data->atoms_added = nullptr;
         free_intra_lb_nets(router_data->intra_lb_nets);
         free_intra_lb_nets(router_data->saved_lb_nets);
         router_data->intra_lb_nets = nullptr;
@@ -200,8 +205,56 @@ static bool route_has_conflict(t_lb_trace* rt, t_lb_router_data* router_data) {
     return false;
 }
 
+// Returns the modes of pb_graph_node found illegal so far. These are the modes
+// kept in the pb_graph_node, which are shared by every cluster of the logical
+// block type, unless the router data has its own copy of them (see
+// isolate_illegal_modes).
+static const std::vector<int>& get_illegal_modes(const t_lb_router_data* router_data,
+                                                 t_pb_graph_node* pb_graph_node) {
+    if (!router_data->has_own_illegal_modes) {
+        return pb_graph_node->illegal_modes;
+    }
+
+    static const std::vector<int> no_illegal_modes;
+    auto illegal_modes_it = router_data->own_illegal_modes.find(pb_graph_node);
+    if (illegal_modes_it == router_data->own_illegal_modes.end()) {
+        return no_illegal_modes;
+    }
+    return illegal_modes_it->second;
+}
+
+// Record a mode of the given pb_graph_node as illegal, returning all of the
+// node's illegal modes. Entries of the router data's own illegal modes are
+// only created here, so an empty map means no mode has been found illegal.
+static const std::vector<int>& add_illegal_mode(t_lb_router_data* router_data,
+                                                t_pb_graph_node* pb_graph_node,
+                                                int mode_index) {
+    std::vector<int>& node_illegal_modes = router_data->has_own_illegal_modes
+                                               ? router_data->own_illegal_modes[pb_graph_node]
+                                               : pb_graph_node->illegal_modes;
+    if (std::find(node_illegal_modes.begin(), node_illegal_modes.end(), mode_index) == node_illegal_modes.end()) {
+        node_illegal_modes.push_back(mode_index);
+    }
+    return node_illegal_modes;
+}
+
+// Returns true if any mode of the logical block type has been found illegal
+static bool has_illegal_modes(const t_lb_router_data* router_data) {
+    if (router_data->has_own_illegal_modes) {
+        return !router_data->own_illegal_modes.empty();
+    }
+
+    for (const t_lb_type_rr_node& node : *router_data->lb_type_graph) {
+        if (node.pb_graph_pin != nullptr && !node.pb_graph_pin->parent_node->illegal_modes.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Check one edge for mode conflict.
 static bool check_edge_for_route_conflicts(std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map,
+                                           t_lb_router_data* router_data,
                                            const t_pb_graph_pin* driver_pin,
                                            const t_pb_graph_pin* pin) {
     if (driver_pin == nullptr) {
@@ -227,9 +280,7 @@ static bool check_edge_for_route_conflicts(std::unordered_map<const t_pb_graph_n
 
     /* Insert unpackable mode to the illegal mode list */
     if (true == mode->disable_packing) {
-        if (std::find(pb_graph_node->illegal_modes.begin(), pb_graph_node->illegal_modes.end(), mode->index) == pb_graph_node->illegal_modes.end()) {
-            pb_graph_node->illegal_modes.push_back(mode->index);
-        }
+        add_illegal_mode(router_data, pb_graph_node, mode->index);
         return true;
     }
 
@@ -242,13 +293,11 @@ static bool check_edge_for_route_conflicts(std::unordered_map<const t_pb_graph_n
 
             // The illegal mode is added to the pb_graph_node as it resulted in a conflict during atom-to-atom routing. This mode cannot be used in the consequent cluster
             // generation try.
-            if (std::find(pb_graph_node->illegal_modes.begin(), pb_graph_node->illegal_modes.end(), result.first->second->index) == pb_graph_node->illegal_modes.end()) {
-                pb_graph_node->illegal_modes.push_back(result.first->second->index);
-            }
+            const std::vector<int>& node_illegal_modes = add_illegal_mode(router_data, pb_graph_node, result.first->second->index);
 
             // If the number of illegal modes equals the number of available mode for a specific pb_graph_node it means that no cluster can be generated. This resuts
             // in a fatal error.
-            if ((int)pb_graph_node->illegal_modes.size() >= pb_graph_node->pb_type->num_modes) {
+            if ((int)node_illegal_modes.size() >= pb_graph_node->pb_type->num_modes) {
                 VPR_FATAL_ERROR(VPR_ERROR_PACK, "There are no more available modes to be used. Routing Failed!");
             }
 
@@ -268,9 +317,9 @@ void add_atom_as_target(t_lb_router_data* router_data, const AtomBlockId blk_id,
     const t_pb* pb;
     auto& atom_ctx = g_vpr_ctx.atom();
 
-    std::map<AtomBlockId, bool>& atoms_added = *router_data->atoms_added;
+    std::vector<AtomBlockId>& atoms_added = router_data->atoms_added;
 
-    if (atoms_added.count(blk_id) > 0) {
+    if (std::find(atoms_added.begin(), atoms_added.end(), blk_id) != atoms_added.end()) {
         VPR_FATAL_ERROR(VPR_ERROR_PACK, "Atom %s added twice to router\n", atom_ctx.netlist().block_name(blk_id).c_str());
     }
 
@@ -278,7 +327,7 @@ void add_atom_as_target(t_lb_router_data* router_data, const AtomBlockId blk_id,
 
     VTR_ASSERT(pb);
 
-    atoms_added[blk_id] = true;
+    atoms_added.push_back(blk_id);
 
     set_reset_pb_modes(router_data, pb, true);
 
@@ -293,11 +342,12 @@ void add_atom_as_target(t_lb_router_data* router_data, const AtomBlockId blk_id,
 void remove_atom_from_target(t_lb_router_data* router_data, const AtomBlockId blk_id, const AtomPBBimap& atom_to_pb) {
     auto& atom_ctx = g_vpr_ctx.atom();
 
-    std::map<AtomBlockId, bool>& atoms_added = *router_data->atoms_added;
+    std::vector<AtomBlockId>& atoms_added = router_data->atoms_added;
 
     const t_pb* pb = atom_to_pb.atom_pb(blk_id);
 
-    if (atoms_added.count(blk_id) == 0) {
+    auto atom_it = std::find(atoms_added.begin(), atoms_added.end(), blk_id);
+    if (atom_it == atoms_added.end()) {
         return;
     }
 
@@ -307,7 +357,19 @@ void remove_atom_from_target(t_lb_router_data* router_data, const AtomBlockId bl
         remove_pin_from_rt_terminals(router_data, pin_id, atom_to_pb);
     }
 
-    atoms_added.erase(blk_id);
+    atoms_added.erase(atom_it);
+}
+
+/* Set/Reset the mode of an lb rr node, remembering the nodes set for the route signature */
+static void set_reset_lb_rr_node_mode(t_lb_router_data* router_data, int inode, int mode, bool set) {
+    if (set && router_data->lb_rr_node_stats[inode].mode == -1) {
+        /* Keep the list bounded when the cache is not used and the list is never pruned by the signature */
+        if (router_data->nodes_with_mode.size() >= router_data->lb_type_graph->size()) {
+            prune_nodes_with_mode(router_data);
+        }
+        router_data->nodes_with_mode.push_back(inode);
+    }
+    router_data->lb_rr_node_stats[inode].mode = set ? mode : -1;
 }
 
 /* Set/Reset mode of rr nodes to the pb used.  If set == true, then set all modes of the rr nodes affected by pb to the mode of the pb.
@@ -327,13 +389,13 @@ void set_reset_pb_modes(t_lb_router_data* router_data, const t_pb* pb, const boo
     for (int iport = 0; iport < pb_graph_node->num_input_ports; iport++) {
         for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ipin++) {
             inode = pb_graph_node->input_pins[iport][ipin].pin_count_in_cluster;
-            router_data->lb_rr_node_stats[inode].mode = (set == true) ? mode : -1;
+            set_reset_lb_rr_node_mode(router_data, inode, mode, set);
         }
     }
     for (int iport = 0; iport < pb_graph_node->num_clock_ports; iport++) {
         for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ipin++) {
             inode = pb_graph_node->clock_pins[iport][ipin].pin_count_in_cluster;
-            router_data->lb_rr_node_stats[inode].mode = (set == true) ? mode : -1;
+            set_reset_lb_rr_node_mode(router_data, inode, mode, set);
         }
     }
 
@@ -347,7 +409,7 @@ void set_reset_pb_modes(t_lb_router_data* router_data, const t_pb* pb, const boo
                 for (int iport = 0; iport < child_pb_graph_node->num_output_ports; iport++) {
                     for (int ipin = 0; ipin < child_pb_graph_node->num_output_pins[iport]; ipin++) {
                         inode = child_pb_graph_node->output_pins[iport][ipin].pin_count_in_cluster;
-                        router_data->lb_rr_node_stats[inode].mode = (set == true) ? mode : -1;
+                        set_reset_lb_rr_node_mode(router_data, inode, mode, set);
                     }
                 }
             }
@@ -427,10 +489,32 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
     mode_status->is_mode_conflict = false;
     mode_status->try_expand_all_modes = false;
 
+    /* Check if this routing problem is already known to be unroutable. Illegal modes and expanding all
+     * modes change how the graph is explored, so the cache is only used without them. The cache is also
+     * not used when debug messages are requested, so that they are always printed. */
+    bool use_failure_cache = router_data->route_failure_cache != nullptr
+                             && !has_illegal_modes(router_data)
+                             && !mode_status->expand_all_modes
+                             && verbosity <= 3;
+    if (use_failure_cache) {
+        load_intra_lb_route_signature(router_data);
+        if (router_data->route_failure_cache->contains(router_data->route_signature)) {
+            /* Leave the nets as the router does after failing to route */
+            for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+                free_lb_net_rt(lb_nets[inet].rt_tree);
+                lb_nets[inet].rt_tree = nullptr;
+            }
+            return false;
+        }
+    }
+
     t_expansion_node exp_node;
 
-    /* Stores state info during route */
+    /* Stores state info during route. The storage of the queue is taken from the router data so it is
+     * only allocated once for each cluster. */
     reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node> pq;
+    pq.swap_container(router_data->expansion_heap);
+    pq.clear();
 
     reset_explored_node_tb(router_data);
 
@@ -550,7 +634,17 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
             free_lb_net_rt(lb_nets[inet].rt_tree);
             lb_nets[inet].rt_tree = nullptr;
         }
+
+        /* Only failures which did not involve the modes are fully described by the signature */
+        if (use_failure_cache && !mode_status->is_mode_issue() && !has_illegal_modes(router_data)) {
+            router_data->route_failure_cache->insert(router_data->route_signature);
+        }
     }
+
+    /* Give the storage of the queue back to the router data for the next route */
+    pq.clear();
+    pq.swap_container(router_data->expansion_heap);
+
     return is_routed;
 }
 
@@ -945,21 +1039,37 @@ static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data, const A
     std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
 
+    //Sink terminals of a net as (target node, index in terminals), reused across the nets
+    std::vector<std::pair<int, int>>& sink_terminals = router_data->sink_terminals;
+
     for (size_t ilb_net = 0; ilb_net < lb_nets.size(); ++ilb_net) {
-        //Collect all the sink terminals indicies which target a particular node
-        std::map<int, std::vector<int>> duplicate_terminals;
-        for (size_t iterm = 1; iterm < lb_nets[ilb_net].terminals.size(); ++iterm) {
-            int node = lb_nets[ilb_net].terminals[iterm];
+        //A net with a single sink has no duplicates
+        if (lb_nets[ilb_net].terminals.size() <= 2) continue;
 
-            duplicate_terminals[node].push_back(iterm);
+        //Sort the sink terminals by the node they target, so the terminals which target
+        //a particular node are adjacent and in increasing index order
+        sink_terminals.clear();
+        for (size_t iterm = 1; iterm < lb_nets[ilb_net].terminals.size(); ++iterm) {
+            sink_terminals.emplace_back(lb_nets[ilb_net].terminals[iterm], iterm);
         }
+        std::sort(sink_terminals.begin(), sink_terminals.end());
 
-        for (auto kv : duplicate_terminals) {
-            if (kv.second.size() < 2) continue; //Only process duplicates
+        for (size_t dup_begin = 0; dup_begin < sink_terminals.size();) {
+            int node = sink_terminals[dup_begin].first;
+            size_t dup_end = dup_begin + 1;
+            while (dup_end < sink_terminals.size() && sink_terminals[dup_end].first == node) {
+                ++dup_end;
+            }
+
+            //Only process duplicates
+            if (dup_end - dup_begin < 2) {
+                dup_begin = dup_end;
+                continue;
+            }
 
             //Remap all the duplicate terminals so they target the pin instead of the sink
-            for (size_t idup_term = 0; idup_term < kv.second.size(); ++idup_term) {
-                int iterm = kv.second[idup_term]; //The index in terminals which is duplicated
+            for (size_t idup_term = dup_begin; idup_term < dup_end; ++idup_term) {
+                int iterm = sink_terminals[idup_term].second; //The index in terminals which is duplicated
 
                 VTR_ASSERT(lb_nets[ilb_net].atom_pins.size() == lb_nets[ilb_net].terminals.size());
                 AtomPinId atom_pin = lb_nets[ilb_net].atom_pins[iterm];
@@ -978,7 +1088,7 @@ static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data, const A
                     "Remapping intra lb net %d (atom net %zu '%s') from common sink "
                     "pb_route %d to fixed pin pb_route %d\n",
                     ilb_net, size_t(lb_nets[ilb_net].atom_net_id), atom_ctx.netlist().net_name(lb_nets[ilb_net].atom_net_id).c_str(),
-                    kv.first, pin_index);
+                    node, pin_index);
 
                 VTR_ASSERT(lb_type_graph[pin_index].type == LB_INTERMEDIATE);
                 VTR_ASSERT(lb_type_graph[pin_index].num_fanout[0] == 1);
@@ -989,6 +1099,7 @@ static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data, const A
                 //Change the target
                 lb_nets[ilb_net].terminals[iterm] = pin_index;
             }
+            dup_begin = dup_end;
         }
     }
 }
@@ -1036,7 +1147,7 @@ static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_co
             auto& node = lb_type_graph[rt->next_nodes[i].current_node];
             auto* pin = node.pb_graph_pin;
 
-            if (check_edge_for_route_conflicts(mode_map, driver_pin, pin)) {
+            if (check_edge_for_route_conflicts(mode_map, router_data, driver_pin, pin)) {
                 mode_status->is_mode_conflict = true;
             }
         }
@@ -1208,8 +1319,7 @@ static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_nod
         /* Check whether a mode is illegal. If it is then the node will not be expanded */
         bool is_illegal = false;
         if (pin != nullptr) {
-            auto* pb_graph_node = pin->parent_node;
-            for (auto illegal_mode : pb_graph_node->illegal_modes) {
+            for (auto illegal_mode : get_illegal_modes(router_data, pin->parent_node)) {
                 if (mode == illegal_mode) {
                     is_illegal = true;
                     break;
@@ -1378,6 +1488,61 @@ static void save_and_reset_lb_route(t_lb_router_data* router_data) {
     }
 }
 
+/* Remove the nodes whose mode was reset from router_data->nodes_with_mode, and sort and deduplicate the rest */
+static void prune_nodes_with_mode(t_lb_router_data* router_data) {
+    std::vector<int>& nodes_with_mode = router_data->nodes_with_mode;
+    nodes_with_mode.erase(std::remove_if(nodes_with_mode.begin(), nodes_with_mode.end(),
+                                         [&](int inode) { return router_data->lb_rr_node_stats[inode].mode == -1; }),
+                          nodes_with_mode.end());
+    std::sort(nodes_with_mode.begin(), nodes_with_mode.end());
+    nodes_with_mode.erase(std::unique(nodes_with_mode.begin(), nodes_with_mode.end()), nodes_with_mode.end());
+}
+
+/* Build a canonical description of the routing problem in the given router data into router_data->route_signature.
+ * Two routing problems with the same signature give the same routing result.
+ *   [lb type, num nets, for each net: (num terminals, terminals...), for each node with a mode: (node, mode)...] */
+static void load_intra_lb_route_signature(t_lb_router_data* router_data) {
+    const std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
+    std::vector<int>& signature = router_data->route_signature;
+
+    signature.clear();
+    signature.push_back(router_data->lb_type->index);
+    signature.push_back(lb_nets.size());
+    for (const t_intra_lb_net& lb_net : lb_nets) {
+        signature.push_back(lb_net.terminals.size());
+        signature.insert(signature.end(), lb_net.terminals.begin(), lb_net.terminals.end());
+    }
+
+    /* Only the nodes set by set_reset_pb_modes can have a mode. They are in node order after pruning, so the
+     * signature does not depend on the order the modes were set in */
+    prune_nodes_with_mode(router_data);
+    for (int inode : router_data->nodes_with_mode) {
+        signature.push_back(inode);
+        signature.push_back(router_data->lb_rr_node_stats[inode].mode);
+    }
+}
+
+size_t IntraLbRouteFailureCache::SignatureHash::operator()(const std::vector<int>& signature) const noexcept {
+    size_t seed = signature.size();
+    for (int value : signature) {
+        vtr::hash_combine(seed, value);
+    }
+    return seed;
+}
+
+bool IntraLbRouteFailureCache::contains(const std::vector<int>& signature) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return failed_signatures_.count(signature) != 0;
+}
+
+void IntraLbRouteFailureCache::insert(const std::vector<int>& signature) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (failed_signatures_.size() >= max_num_signatures_) {
+        return;
+    }
+    failed_signatures_.insert(signature);
+}
+
 static std::vector<int> find_congested_rr_nodes(const std::vector<t_lb_type_rr_node>& lb_type_graph,
                                                 const t_lb_rr_node_stats* lb_rr_node_stats) {
     std::vector<int> congested_rr_nodes;
@@ -1516,6 +1681,11 @@ static std::string describe_congested_rr_nodes(const std::vector<int>& congested
 }
 
 void reset_intra_lb_route(t_lb_router_data* router_data) {
+    if (router_data->has_own_illegal_modes) {
+        router_data->own_illegal_modes.clear();
+        return;
+    }
+
     for (auto& node : *router_data->lb_type_graph) {
         auto* pin = node.pb_graph_pin;
         if (pin == nullptr) {
@@ -1525,3 +1695,34 @@ void reset_intra_lb_route(t_lb_router_data* router_data) {
         pin->parent_node->illegal_modes.clear();
     }
 }
+
+void isolate_illegal_modes(t_lb_router_data* router_data) {
+    VTR_ASSERT(!router_data->has_own_illegal_modes);
+    router_data->own_illegal_modes.clear();
+    for (const t_lb_type_rr_node& node : *router_data->lb_type_graph) {
+        const t_pb_graph_pin* pin = node.pb_graph_pin;
+        if (pin != nullptr && !pin->parent_node->illegal_modes.empty()) {
+            router_data->own_illegal_modes[pin->parent_node] = pin->parent_node->illegal_modes;
+        }
+    }
+    router_data->has_own_illegal_modes = true;
+}
+
+bool rejoin_illegal_modes(t_lb_router_data* router_data, bool merge) {
+    VTR_ASSERT(router_data->has_own_illegal_modes);
+    bool found_new_illegal_modes = false;
+    for (auto& [pb_graph_node, node_illegal_modes] : router_data->own_illegal_modes) {
+        std::vector<int>& shared_illegal_modes = pb_graph_node->illegal_modes;
+        for (int mode : node_illegal_modes) {
+            if (std::find(shared_illegal_modes.begin(), shared_illegal_modes.end(), mode) == shared_illegal_modes.end()) {
+                found_new_illegal_modes = true;
+                if (merge) {
+                    shared_illegal_modes.push_back(mode);
+                }
+            }
+        }
+    }
+    router_data->own_illegal_modes.clear();
+    router_data->has_own_illegal_modes = false;
+    return found_new_illegal_modes;
+}
@@ -6,6 +6,8 @@
  * Date: July 22, 2013
  */
 
+#include <shared_mutex>
+#include <unordered_set>
 #include <vector>
 #include "atom_netlist_fwd.h"
 #include "atom_pb_bimap.h"
@@ -13,6 +15,48 @@
 #include "vpr_types.h"
 #include "vpr_utils.h"
 
+/**
+ * @brief A cache of the intra-lb routing problems which were found to be
+ *        unroutable.
+ *
+ * The intra-lb router is deterministic: its result only depends on the type of
+ * the cluster, the terminals of each net (in order) and the modes selected for
+ * the lb rr nodes. Clusters built by the packer often end up with the same
+ * routing problem (the same primitive sites used with the same connectivity),
+ * so the signature of each problem which failed to route is stored here and
+ * later routes of the same problem fail without running the router.
+ *
+ * Only failures are cached, since a successful route must produce the route
+ * trees of the cluster. The cache is shared by the routers of every cluster in
+ * a cluster legalizer and is safe to use from multiple threads.
+ */
+class IntraLbRouteFailureCache {
+  public:
+    /// @brief Returns true if the routing problem with the given signature is
+    ///        known to be unroutable.
+    bool contains(const std::vector<int>& signature) const;
+
+    /// @brief Record that the routing problem with the given signature is
+    ///        unroutable.
+    void insert(const std::vector<int>& signature);
+
+  private:
+    struct SignatureHash {
+        size_t operator()(const std::vector<int>& signature) const noexcept;
+    };
+
+    /// @brief The maximum number of signatures to store. Once reached, no more
+    ///        failures are recorded to bound the memory used by the cache.
+    static constexpr size_t max_num_signatures_ = 10000;
+
+    /// @brief The signatures of the routing problems which failed to route.
+    std::unordered_set<std::vector<int>, SignatureHash> failed_signatures_;
+
+    /// @brief Lock used to protect the cache when routing clusters in parallel.
+    ///        Lookups, which are far more common than insertions, share it.
+    mutable std::shared_mutex mutex_;
+};
+
 /* Constructors/Destructors */
 t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type);
 void free_router_data(t_lb_router_data* router_data);
@@ -25,6 +69,15 @@ void set_reset_pb_modes(t_lb_router_data* router_data, const t_pb* pb, const boo
 bool try_intra_lb_route(t_lb_router_data* router_data, int verbosity, t_mode_selection_status* mode_status);
 void reset_intra_lb_route(t_lb_router_data* router_data);
 
+/* Makes the routes of router_data use and record their own copy of the modes found illegal for its logical
+ * block type, instead of the copy shared by every cluster of the type, so that the cluster can be routed
+ * concurrently with other clusters. */
+void isolate_illegal_modes(t_lb_router_data* router_data);
+
+/* Makes the routes of router_data use the shared illegal modes again. Returns true if its own copy holds
+ * illegal modes which are not shared, which are added to the shared ones if merge is true. */
+bool rejoin_illegal_modes(t_lb_router_data* router_data, bool merge);
+
 /**
  * @brief Creates an array [0..num_pb_graph_pins-1] for intra-logic block routing lookup. 
  * Given a pb_graph_pin ID for a CLB, this lookup returns t_pb_route corresponding to that
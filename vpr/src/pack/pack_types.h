@@ -13,6 +13,7 @@
 #include "physical_types.h"
 #include "vpr_types.h"
 
+class IntraLbRouteFailureCache;
 class t_pack_molecule;
 
 /**************************************************************************
@@ -37,9 +38,10 @@ const std::vector<const char*> lb_rr_type_str{
 struct t_pb_stats {
     int num_child_blocks_in_pb;
 
-    /* Record of pins of class used */
-    std::vector<std::unordered_map<size_t, AtomNetId>> input_pins_used;  /* [0..pb_graph_node->num_pin_classes-1] nets using this input pin class */
-    std::vector<std::unordered_map<size_t, AtomNetId>> output_pins_used; /* [0..pb_graph_node->num_pin_classes-1] nets using this output pin class */
+    /* Record of pins of class used. Only the number of committed pins of each class is
+     * ever queried, so a counter is kept instead of the nets themselves. */
+    std::vector<size_t> num_input_pins_used;  /* [0..pb_graph_node->num_pin_classes-1] number of nets using this input pin class */
+    std::vector<size_t> num_output_pins_used; /* [0..pb_graph_node->num_pin_classes-1] number of nets using this output pin class */
 
     /* Use vector because array size is expected to be small so runtime should be faster using vector than map despite the O(N) vs O(log(n)) behaviour.*/
     std::vector<std::vector<AtomNetId>> lookahead_input_pins_used;  /* [0..pb_graph_node->num_pin_classes-1] vector of input pins of this class that are speculatively used */
@@ -195,7 +197,7 @@ struct t_lb_router_data {
     /* Saved nets */
     std::vector<t_intra_lb_net>* saved_lb_nets; /* Save vector of intra logic cluster_ctx.blocks nets and their connections */
 
-    std::map<AtomBlockId, bool>* atoms_added; /* map that records which atoms are added to cluster router */
+    std::vector<AtomBlockId> atoms_added; /* atoms that are added to cluster router, a cluster only holds a few of them */
 
     /* Logical-to-physical mapping info */
     t_lb_rr_node_stats* lb_rr_node_stats; /* [0..lb_type_graph->size()-1] Stats for each logic cluster_ctx.blocks rr node instance */
@@ -214,6 +216,28 @@ struct t_lb_router_data {
     /* current congestion factor */
     float pres_con_fac;
 
+    /* The modes which produced conflicts while routing are kept in t_pb_graph_node::illegal_modes, where they
+     * are shared by every cluster of the logical block type. A cluster routed concurrently with other clusters
+     * uses its own copy of them instead, by pb_graph_node (see isolate_illegal_modes). */
+    bool has_own_illegal_modes;
+    std::unordered_map<t_pb_graph_node*, std::vector<int>> own_illegal_modes;
+
+    /* Storage of the router's expansion heap, kept between routes so that it is only allocated once per cluster */
+    std::vector<t_expansion_node> expansion_heap;
+
+    /* Cache of the routing problems known to be unroutable. This is shared between clusters and may be nullptr */
+    IntraLbRouteFailureCache* route_failure_cache;
+
+    /* Reusable buffer holding the signature of the current routing problem, see IntraLbRouteFailureCache */
+    std::vector<int> route_signature;
+
+    /* The lb rr nodes whose mode was set by set_reset_pb_modes. Nodes which were reset since or listed twice are
+     * removed when the route signature is built, so the nodes with a mode are found without walking the graph */
+    std::vector<int> nodes_with_mode;
+
+    /* Scratch storage of the sink terminals of a net, used to find the terminals which target the same node */
+    std::vector<std::pair<int, int>> sink_terminals;
+
     t_lb_router_data() {
         lb_type_graph = nullptr;
         lb_rr_node_stats = nullptr;
@@ -221,9 +245,10 @@ struct t_lb_router_data {
         saved_lb_nets = nullptr;
         is_routed = false;
         lb_type = nullptr;
-        atoms_added = nullptr;
         explored_node_tb = nullptr;
         explore_id_index = 1;
+        route_failure_cache = nullptr;
+        has_own_illegal_modes = false;
 
         params.max_iterations = 50;
         params.pres_fac = 1;
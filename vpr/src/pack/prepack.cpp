@@ -12,6 +12,7 @@
 
 #include "prepack.h"
 
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <map>
@@ -27,6 +28,7 @@
 #include "vpr_types.h"
 #include "vpr_utils.h"
 #include "vtr_assert.h"
+#include "vtr_parallel.h"
 #include "vtr_range.h"
 #include "vtr_time.h"
 #include "vtr_util.h"
@@ -135,6 +137,8 @@ static std::unordered_set<t_pb_type*> get_pattern_blocks(const t_pack_patterns&
 
 static void print_chain_starting_points(t_pack_patterns* chain_pattern);
 
+static const t_pb_type* get_pattern_root_pb_type(const t_pack_patterns& pack_pattern);
+
 /*****************************************/
 /*Function Definitions					 */
 /*****************************************/
@@ -798,6 +802,19 @@ void Prepacker::alloc_and_load_pack_molecules(std::multimap<AtomBlockId, PackMol
                                               const std::vector<t_logical_block_type>& logical_block_types) {
     std::vector<bool> is_used(list_of_pack_patterns.size(), false);
 
+    // The lowest cost primitive of each atom only depends on the atom and the
+    // architecture, so it is found for all atoms up front (in parallel if
+    // possible). Each lookup walks every pb_graph in the architecture.
+    auto blocks = atom_nlist.blocks();
+    vtr::parallel_for(blocks.size(), [&](size_t i) {
+        AtomBlockId blk_id = *(blocks.begin() + i);
+        expected_lowest_cost_pb_gnode[blk_id] = get_expected_lowest_cost_primitive_for_atom_block(blk_id, logical_block_types);
+    });
+
+    // Scratch space marking which atoms may be the root of the pattern being
+    // matched.
+    std::vector<uint8_t> is_root_candidate(blocks.size(), 0);
+
     /* Find forced pack patterns
      * Simplifying assumptions: Each atom can map to at most one molecule,
      *                          use first-fit mapping based on priority of pattern
@@ -824,10 +841,22 @@ void Prepacker::alloc_and_load_pack_molecules(std::multimap<AtomBlockId, PackMol
         VTR_ASSERT(is_used[best_pattern] == false);
         is_used[best_pattern] = true;
 
-        auto blocks = atom_nlist.blocks();
+        // Only atoms which fit the root primitive of the pattern can start a
+        // molecule. This check is independent of the molecules created so
+        // far, so it is done for all atoms in parallel; the (order dependent)
+        // first-fit matching below then only visits the candidates.
+        const t_pack_patterns& pattern = list_of_pack_patterns[best_pattern];
+        const t_pb_type* root_pb_type = get_pattern_root_pb_type(pattern);
+        vtr::parallel_for(blocks.size(), [&](size_t i) {
+            is_root_candidate[i] = (root_pb_type == nullptr || primitive_type_feasible(*(blocks.begin() + i), root_pb_type));
+        });
+
         for (auto blk_iter = blocks.begin(); blk_iter != blocks.end(); ++blk_iter) {
             auto blk_id = *blk_iter;
 
+            if (!is_root_candidate[blk_iter - blocks.begin()])
+                continue;
+
             PackMoleculeId cur_molecule_id = try_create_molecule(best_pattern,
                                                                  blk_id,
                                                                  atom_molecules_multimap,
@@ -868,16 +897,11 @@ void Prepacker::alloc_and_load_pack_molecules(std::multimap<AtomBlockId, PackMol
      * more difficult because now it needs to consider splitting molecules.
      */
     for (auto blk_id : atom_nlist.blocks()) {
-        t_pb_graph_node* best = get_expected_lowest_cost_primitive_for_atom_block(blk_id, logical_block_types);
-        if (!best) {
+        if (!expected_lowest_cost_pb_gnode[blk_id]) {
             VPR_FATAL_ERROR(VPR_ERROR_PACK, "Failed to find any location to pack primitive of type '%s' in architecture",
                             models.get_model(atom_nlist.block_model(blk_id)).name);
         }
 
-        VTR_ASSERT_SAFE(nullptr != best);
-
-        expected_lowest_cost_pb_gnode[blk_id] = best;
-
         auto rng = atom_molecules_multimap.equal_range(blk_id);
         bool rng_empty = (rng.first == rng.second);
         if (rng_empty) {
@@ -1751,6 +1775,31 @@ static void print_chain_starting_points(t_pack_patterns* chain_pattern) {
     VTR_LOG("\n");
 }
 
+/**
+ * Returns the primitive type an atom must fit to be the root of a molecule of
+ * the given pattern, or nullptr if any atom may be tried as the root.
+ */
+static const t_pb_type* get_pattern_root_pb_type(const t_pack_patterns& pack_pattern) {
+    if (pack_pattern.num_blocks == 0 || pack_pattern.root_block == nullptr) {
+        return nullptr;
+    }
+
+    // Chains start from the primitive of the chain root pin (see
+    // find_new_root_atom_for_chain).
+    if (pack_pattern.is_chain) {
+        VTR_ASSERT(!pack_pattern.chain_root_pins.empty());
+        return pack_pattern.chain_root_pins[0][0]->parent_node->pb_type;
+    }
+
+    // An optional root block may be left empty (see try_expand_molecule), so
+    // it does not constrain the root atom.
+    if (pack_pattern.is_block_optional[pack_pattern.root_block->block_id]) {
+        return nullptr;
+    }
+
+    return pack_pattern.root_block->pb_type;
+}
+
 Prepacker::Prepacker(const AtomNetlist& atom_nlist,
                      const LogicalModels& models,
                      const std::vector<t_logical_block_type>& logical_block_types) {
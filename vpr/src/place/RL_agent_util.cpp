@@ -4,6 +4,9 @@
 #include "simpleRL_move_generator.h"
 #include "static_move_generator.h"
 #include "placer_state.h"
+#include "vpr_error.h"
+
+#include <fstream>
 
 std::pair<std::unique_ptr<MoveGenerator>, std::unique_ptr<MoveGenerator>> create_move_generators(PlacerState& placer_state,
                                                                                                  const PlaceMacros& place_macros,
@@ -90,6 +93,7 @@ std::pair<std::unique_ptr<MoveGenerator>, std::unique_ptr<MoveGenerator>> create
                                                                             num_movable_blocks_per_type);
             }
             karmed_bandit_agent1->set_step(placer_opts.place_agent_gamma, move_lim);
+            karmed_bandit_agent1->set_batch_size(placer_opts.place_agent_batch_size);
             move_generators.first = std::make_unique<SimpleRLMoveGenerator>(placer_state,
                                                                             place_macros,
                                                                             net_cost_handler,
@@ -105,6 +109,7 @@ std::pair<std::unique_ptr<MoveGenerator>, std::unique_ptr<MoveGenerator>> create
                                                                         rng,
                                                                         num_movable_blocks_per_type);
             karmed_bandit_agent2->set_step(placer_opts.place_agent_gamma, move_lim);
+            karmed_bandit_agent2->set_batch_size(placer_opts.place_agent_batch_size);
             move_generators.second = std::make_unique<SimpleRLMoveGenerator>(placer_state,
                                                                              place_macros,
                                                                              net_cost_handler,
@@ -130,6 +135,7 @@ std::pair<std::unique_ptr<MoveGenerator>, std::unique_ptr<MoveGenerator>> create
                                                                       num_movable_blocks_per_type);
             }
             karmed_bandit_agent1->set_step(placer_opts.place_agent_gamma, move_lim);
+            karmed_bandit_agent1->set_batch_size(placer_opts.place_agent_batch_size);
             move_generators.first = std::make_unique<SimpleRLMoveGenerator>(placer_state,
                                                                             place_macros,
                                                                             net_cost_handler,
@@ -144,6 +150,7 @@ std::pair<std::unique_ptr<MoveGenerator>, std::unique_ptr<MoveGenerator>> create
                                                                   rng,
                                                                   num_movable_blocks_per_type);
             karmed_bandit_agent2->set_step(placer_opts.place_agent_gamma, move_lim);
+            karmed_bandit_agent2->set_batch_size(placer_opts.place_agent_batch_size);
             move_generators.second = std::make_unique<SimpleRLMoveGenerator>(placer_state,
                                                                              place_macros,
                                                                              net_cost_handler,
@@ -175,3 +182,32 @@ MoveGenerator& select_move_generator(std::unique_ptr<MoveGenerator>& move_genera
             return *move_generator2;
     }
 }
+
+void write_agent_states(const std::string& filename,
+                        MoveGenerator& move_generator,
+                        MoveGenerator& move_generator2) {
+    std::ofstream ofs(filename);
+    if (!ofs) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Failed to open RL agent state file '%s' for writing\n", filename.c_str());
+    }
+
+    move_generator.write_agent_state(ofs);
+    move_generator2.write_agent_state(ofs);
+    VTR_LOG("Wrote RL agent state to '%s'\n", filename.c_str());
+}
+
+void read_agent_states(const std::string& filename,
+                       MoveGenerator& move_generator,
+                       MoveGenerator& move_generator2) {
+    std::ifstream ifs(filename);
+    if (!ifs) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Failed to open RL agent state file '%s' for reading\n", filename.c_str());
+    }
+
+    if (move_generator.read_agent_state(ifs) && move_generator2.read_agent_state(ifs)) {
+        VTR_LOG("Warm-started RL agent from '%s'\n", filename.c_str());
+    } else {
+        VTR_LOG_WARN("RL agent state in '%s' does not match the agents of this placement, not all of them are warm-started\n",
+                     filename.c_str());
+    }
+}
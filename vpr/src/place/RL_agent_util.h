@@ -44,3 +44,20 @@ MoveGenerator& select_move_generator(std::unique_ptr<MoveGenerator>& move_genera
                                      e_agent_state agent_state,
                                      const t_placer_opts& placer_opts,
                                      bool in_quench);
+
+/**
+ * @brief Writes the learned state of the RL agents of both move generators to a file,
+ * so that later placements can be warm-started from it with read_agent_states()
+ */
+void write_agent_states(const std::string& filename,
+                        MoveGenerator& move_generator,
+                        MoveGenerator& move_generator2);
+
+/**
+ * @brief Warm-starts the RL agents of both move generators from a file written by write_agent_states()
+ *
+ * Agents whose actions do not match the file (e.g. a different netlist or agent options) keep their initial state.
+ */
+void read_agent_states(const std::string& filename,
+                       MoveGenerator& move_generator,
+                       MoveGenerator& move_generator2);
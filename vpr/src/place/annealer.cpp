@@ -923,6 +923,10 @@ e_agent_state PlacementAnnealer::get_agent_state() const {
     return agent_state_;
 }
 
+void PlacementAnnealer::write_agent_states(const std::string& filename) {
+    ::write_agent_states(filename, *move_generator_1_, *move_generator_2_);
+}
+
 const t_annealing_state& PlacementAnnealer::get_annealing_state() const {
     return annealing_state_;
 }
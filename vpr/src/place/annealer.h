@@ -228,6 +228,9 @@ class PlacementAnnealer {
     /// @brief Return the RL agent's state
     e_agent_state get_agent_state() const;
 
+    /// @brief Writes the learned state of the RL agents of the move generators to a file
+    void write_agent_states(const std::string& filename);
+
     /// @brief Returns a constant reference to the annealing state
     const t_annealing_state& get_annealing_state() const;
 
@@ -13,10 +13,22 @@
  * @param locations The location of logical blocks of a specific type.
  * [0...layer-1][0...num_instances_on_layer-1] --> (x, y)
  * @param num_layers The number of dice.
+ * @param grid_width The width of the device grid.
+ * @param grid_height The height of the device grid.
  * @return t_compressed_block_grid The compressed grid created from the given locations.
  */
 static t_compressed_block_grid create_compressed_block_grid(const std::vector<std::vector<vtr::Point<int>>>& locations,
-                                                            int num_layers);
+                                                            int num_layers,
+                                                            int grid_width,
+                                                            int grid_height);
+
+/**
+ * @brief Builds the dense grid to compressed coordinate lookups of one dimension.
+ *
+ * @param compressed The sorted grid coordinates of the compressed grid in this dimension.
+ * @param grid_dim The size of the device grid in this dimension.
+ */
+static t_compressed_dim_lookup build_compressed_dim_lookup(const std::vector<int>& compressed, int grid_dim);
 
 std::vector<t_compressed_block_grid> create_compressed_block_grids() {
     /* Measure how long it takes to allocate and initialize compressed grid.
@@ -60,7 +72,7 @@ std::vector<t_compressed_block_grid> create_compressed_block_grids() {
     std::vector<t_compressed_block_grid> compressed_type_grids(device_ctx.logical_block_types.size());
 
     for (const auto& logical_block : device_ctx.logical_block_types) {
-        auto compressed_block_grid = create_compressed_block_grid(block_locations[logical_block.index], num_layers);
+        auto compressed_block_grid = create_compressed_block_grid(block_locations[logical_block.index], num_layers, grid.width(), grid.height());
 
         for (const auto& physical_tile : logical_block.equivalent_tiles) {
             std::vector<int> compatible_sub_tiles;
@@ -90,7 +102,9 @@ std::vector<t_compressed_block_grid> create_compressed_block_grids() {
 
 //Given a set of locations, returns a 2D matrix in a compressed space
 static t_compressed_block_grid create_compressed_block_grid(const std::vector<std::vector<vtr::Point<int>>>& locations,
-                                                            int num_layers) {
+                                                            int num_layers,
+                                                            int grid_width,
+                                                            int grid_height) {
     t_compressed_block_grid compressed_grid;
 
     if (locations.empty()) {
@@ -130,6 +144,13 @@ static t_compressed_block_grid create_compressed_block_grid(const std::vector<st
         }
     }
 
+    compressed_grid.grid_to_compressed_x.resize(num_layers);
+    compressed_grid.grid_to_compressed_y.resize(num_layers);
+    for (int layer_num = 0; layer_num < num_layers; layer_num++) {
+        compressed_grid.grid_to_compressed_x[layer_num] = build_compressed_dim_lookup(compressed_grid.compressed_to_grid_x[layer_num], grid_width);
+        compressed_grid.grid_to_compressed_y[layer_num] = build_compressed_dim_lookup(compressed_grid.compressed_to_grid_y[layer_num], grid_height);
+    }
+
     compressed_grid.grid.resize(num_layers);
     for (int layer_num = 0; layer_num < num_layers; layer_num++) {
         auto& layer_compressed_grid = compressed_grid.grid[layer_num];
@@ -168,9 +189,141 @@ static t_compressed_block_grid create_compressed_block_grid(const std::vector<st
         }
     }
 
+    compressed_grid.loc_counts.resize(num_layers);
+    for (int layer_num = 0; layer_num < num_layers; layer_num++) {
+        const size_t num_columns = compressed_grid.get_num_columns(layer_num);
+        const size_t num_rows = compressed_grid.get_num_rows(layer_num);
+        t_compressed_loc_counts& loc_counts = compressed_grid.loc_counts[layer_num];
+
+        auto count_locs = [&](size_t cx, size_t cy, bool sparse) {
+            if (compressed_grid.is_sparse_column(cx, layer_num) != sparse) {
+                return 0;
+            }
+            return (int)compressed_grid.grid[layer_num][cx].count(cy);
+        };
+
+        loc_counts.dense_column_locs = vtr::PrefixSum2D<int>(num_columns, num_rows, [&](size_t cx, size_t cy) {
+            return count_locs(cx, cy, /*sparse=*/false);
+        });
+        loc_counts.sparse_column_locs = vtr::PrefixSum2D<int>(num_columns, num_rows, [&](size_t cx, size_t cy) {
+            return count_locs(cx, cy, /*sparse=*/true);
+        });
+        loc_counts.sparse_column_size = vtr::PrefixSum1D<int>(num_columns, [&](size_t cx) {
+            return compressed_grid.is_sparse_column(cx, layer_num) ? (int)compressed_grid.grid[layer_num][cx].size() : 0;
+        });
+    }
+
     return compressed_grid;
 }
 
+int t_compressed_block_grid::num_locs_in_range(const t_bb& search_range, int cx_max, int layer_num, bool expand_sparse_columns) const {
+    if (cx_max < search_range.xmin || search_range.ymax < search_range.ymin) {
+        return 0;
+    }
+
+    const t_compressed_loc_counts& counts = loc_counts[layer_num];
+    int num_locs = counts.dense_column_locs.get_sum(search_range.xmin, search_range.ymin, cx_max, search_range.ymax);
+
+    if (expand_sparse_columns) {
+        num_locs += counts.sparse_column_size.get_sum(search_range.xmin, cx_max);
+    } else {
+        num_locs += counts.sparse_column_locs.get_sum(search_range.xmin, search_range.ymin, cx_max, search_range.ymax);
+    }
+
+    return num_locs;
+}
+
+int t_compressed_block_grid::loc_index_in_range(const t_bb& search_range, const t_physical_tile_loc& compressed_loc, bool expand_sparse_columns) const {
+    const int cx = compressed_loc.x;
+    const int cy = compressed_loc.y;
+    const int layer_num = compressed_loc.layer_num;
+
+    if (layer_num < 0 || cx < search_range.xmin || cx > search_range.xmax) {
+        return UNDEFINED;
+    }
+
+    const auto& block_rows = get_column_block_map(cx, layer_num);
+    auto loc_iter = block_rows.find(cy);
+    if (loc_iter == block_rows.end()) {
+        return UNDEFINED;
+    }
+
+    auto first_iter = block_rows.begin();
+    if (!expand_sparse_columns || !is_sparse_column(cx, layer_num)) {
+        if (cy < search_range.ymin || cy > search_range.ymax) {
+            return UNDEFINED;
+        }
+        first_iter = block_rows.lower_bound(search_range.ymin);
+    }
+
+    return num_locs_in_range(search_range, cx - 1, layer_num, expand_sparse_columns) + (int)std::distance(first_iter, loc_iter);
+}
+
+t_physical_tile_loc t_compressed_block_grid::loc_in_range(const t_bb& search_range, int index, int layer_num, bool expand_sparse_columns) const {
+    VTR_ASSERT_SAFE(index >= 0 && index < num_locs_in_range(search_range, search_range.xmax, layer_num, expand_sparse_columns));
+
+    // Find the first column where the number of locations up to that column exceeds the index
+    int cx_low = search_range.xmin;
+    int cx_high = search_range.xmax;
+    while (cx_low < cx_high) {
+        const int cx_mid = cx_low + (cx_high - cx_low) / 2;
+        if (num_locs_in_range(search_range, cx_mid, layer_num, expand_sparse_columns) > index) {
+            cx_high = cx_mid;
+        } else {
+            cx_low = cx_mid + 1;
+        }
+    }
+
+    const int cx = cx_low;
+    const int index_in_column = index - num_locs_in_range(search_range, cx - 1, layer_num, expand_sparse_columns);
+
+    const auto& block_rows = get_column_block_map(cx, layer_num);
+    auto first_iter = (expand_sparse_columns && is_sparse_column(cx, layer_num)) ? block_rows.begin()
+                                                                                 : block_rows.lower_bound(search_range.ymin);
+
+    return {cx, (first_iter + index_in_column)->first, layer_num};
+}
+
+static t_compressed_dim_lookup build_compressed_dim_lookup(const std::vector<int>& compressed, int grid_dim) {
+    t_compressed_dim_lookup lookup;
+    lookup.round_down.resize(grid_dim);
+    lookup.round_up.resize(grid_dim);
+    lookup.nearest.resize(grid_dim);
+
+    for (int grid_coord = 0; grid_coord < grid_dim; grid_coord++) {
+        // First compressed coordinate not less than grid_coord
+        auto itr = std::lower_bound(compressed.begin(), compressed.end(), grid_coord);
+        int next = std::distance(compressed.begin(), itr);
+
+        // If all the compressed locations are less than the grid location, round up to the last compressed location
+        lookup.round_up[grid_coord] = (itr == compressed.end()) ? (int)compressed.size() - 1 : next;
+
+        // Last compressed coordinate not bigger than grid_coord. If all the compressed
+        // locations are bigger than the grid location, round down to the first one.
+        if (itr != compressed.end() && *itr == grid_coord) {
+            lookup.round_down[grid_coord] = next;
+        } else {
+            lookup.round_down[grid_coord] = (itr == compressed.begin()) ? 0 : next - 1;
+        }
+
+        if (compressed.empty()) {
+            // No compatible locations for a block of the given type
+            lookup.nearest[grid_coord] = UNDEFINED;
+        } else if (itr == compressed.begin()) {
+            lookup.nearest[grid_coord] = 0;
+        } else if (itr == compressed.end()) {
+            lookup.nearest[grid_coord] = compressed.size() - 1;
+        } else {
+            // Find the nearest compressed location, preferring the lower one on ties
+            int dist_prev = grid_coord - *(itr - 1);
+            int dist_next = *itr - grid_coord;
+            lookup.nearest[grid_coord] = (dist_prev <= dist_next) ? next - 1 : next;
+        }
+    }
+
+    return lookup;
+}
+
 /*Print the contents of the compressed grids to an echo file*/
 void echo_compressed_grids(const char* filename, const std::vector<t_compressed_block_grid>& comp_grids) {
     FILE* fp;
@@ -5,8 +5,49 @@
 
 #include "vtr_assert.h"
 #include "vtr_flat_map.h"
+#include "vtr_prefix_sum.h"
 #include "vpr_types.h"
 
+/**
+ * Columns of the compressed grid with fewer locations than this are sparse (e.g. columns
+ * of IO blocks on the perimeter of the device). Unless the search range is fixed, the
+ * move generators search the whole of a sparse column rather than only its rows in range.
+ */
+constexpr int MIN_NUM_BLOCKS_IN_COLUMN = 3;
+
+/**
+ * @brief Dense lookups from the grid coordinates of one dimension of a layer to
+ *        the compressed coordinates of a block type.
+ *
+ * Each table has an entry for every grid coordinate, so the translations done by
+ * the move generators for every proposed move are a single indexed load rather
+ * than a binary search over the compressed coordinates.
+ */
+struct t_compressed_dim_lookup {
+    std::vector<int> round_down; //[0...grid_dim-1] -> last compressed coordinate not above the grid coordinate (or the first one)
+    std::vector<int> round_up;   //[0...grid_dim-1] -> first compressed coordinate not below the grid coordinate (or the last one)
+    std::vector<int> nearest;    //[0...grid_dim-1] -> closest compressed coordinate (or UNDEFINED if there is none)
+
+    ///@brief Looks up grid_coord in table. Coordinates outside the grid are clamped to it, which gives the same results.
+    static inline int lookup(const std::vector<int>& table, int grid_coord) {
+        VTR_ASSERT_SAFE(!table.empty());
+        return table[std::clamp(grid_coord, 0, (int)table.size() - 1)];
+    }
+};
+
+/**
+ * @brief Number of compressed locations in any rectangle of one layer of a compressed grid.
+ *
+ * The locations of sparse columns (see MIN_NUM_BLOCKS_IN_COLUMN) are counted separately from
+ * the others, so that the search ranges where sparse columns are searched entirely can also
+ * be counted in constant time.
+ */
+struct t_compressed_loc_counts {
+    vtr::PrefixSum2D<int> dense_column_locs;  //[0...num_columns-1][0...num_rows-1] -> 1 if there is a location in a column which is not sparse
+    vtr::PrefixSum2D<int> sparse_column_locs; //[0...num_columns-1][0...num_rows-1] -> 1 if there is a location in a sparse column
+    vtr::PrefixSum1D<int> sparse_column_size; //[0...num_columns-1] -> number of locations of the column if it is sparse, 0 otherwise
+};
+
 struct t_compressed_block_grid {
     // The compressed grid of a block type stores only the coordinates that are occupied by that particular block type.
     // For instance, if a DSP block exists only in the 2nd, 3rd, and 5th columns, the compressed grid of X axis will solely store the values 2, 3, and 5.
@@ -20,6 +61,10 @@ struct t_compressed_block_grid {
     std::vector<std::vector<int>> compressed_to_grid_y; // [0...num_layers-1][0...num_rows-1] -> uncompressed y
     std::vector<int> compressed_to_grid_layer;          // [0...num_layers-1] -> uncompressed layer
 
+    //The inverse of compressed_to_grid_x/y, see t_compressed_dim_lookup
+    std::vector<t_compressed_dim_lookup> grid_to_compressed_x; // [0...num_layers-1]
+    std::vector<t_compressed_dim_lookup> grid_to_compressed_y; // [0...num_layers-1]
+
     //The grid is stored with a full/dense x-dimension (since only
     //x values which exist are considered), while the y-dimension is
     //stored sparsely, since we may not have full columns of blocks.
@@ -32,6 +77,10 @@ struct t_compressed_block_grid {
     //  - value: vector of compatible sub tiles for the physical tile/logical block pair
     std::unordered_map<int, std::vector<int>> compatible_sub_tiles_for_tile;
 
+    //The number of locations in the rectangles of each layer, used to pick locations in a
+    //search range without probing for them
+    std::vector<t_compressed_loc_counts> loc_counts; // [0...num_layers-1]
+
     inline size_t get_num_columns(int layer_num) const {
         return compressed_to_grid_x[layer_num].size();
     }
@@ -41,17 +90,13 @@ struct t_compressed_block_grid {
     }
 
     inline t_physical_tile_loc grid_loc_to_compressed_loc(t_physical_tile_loc grid_loc) const {
-        int cx = UNDEFINED;
-        int cy = UNDEFINED;
         int layer_num = grid_loc.layer_num;
 
-        auto itr_x = std::lower_bound(compressed_to_grid_x[layer_num].begin(), compressed_to_grid_x[layer_num].end(), grid_loc.x);
-        VTR_ASSERT(*itr_x == grid_loc.x);
-        cx = std::distance(compressed_to_grid_x[layer_num].begin(), itr_x);
+        int cx = t_compressed_dim_lookup::lookup(grid_to_compressed_x[layer_num].round_up, grid_loc.x);
+        VTR_ASSERT(compressed_to_grid_x[layer_num][cx] == grid_loc.x);
 
-        auto itr_y = std::lower_bound(compressed_to_grid_y[layer_num].begin(), compressed_to_grid_y[layer_num].end(), grid_loc.y);
-        VTR_ASSERT(*itr_y == grid_loc.y);
-        cy = std::distance(compressed_to_grid_y[layer_num].begin(), itr_y);
+        int cy = t_compressed_dim_lookup::lookup(grid_to_compressed_y[layer_num].round_up, grid_loc.y);
+        VTR_ASSERT(compressed_to_grid_y[layer_num][cy] == grid_loc.y);
 
         return {cx, cy, layer_num};
     }
@@ -67,21 +112,9 @@ struct t_compressed_block_grid {
      * @return The corresponding compressed location with the same layer number.
      */
     inline t_physical_tile_loc grid_loc_to_compressed_loc_approx_round_up(t_physical_tile_loc grid_loc) const {
-        auto find_compressed_index = [](const std::vector<int>& compressed, int value) -> int {
-            // Get the first element that is not less than the value
-            auto itr = std::lower_bound(compressed.begin(), compressed.end(), value);
-            if (itr == compressed.end()) {
-                // If all the compressed locations are less than the grid location, return the last compressed location
-                return compressed.size() - 1;
-            } else {
-                // Return the index of the first element that is not less than the value
-                return std::distance(compressed.begin(), itr);
-            }
-        };
-
         int layer_num = grid_loc.layer_num;
-        int cx = find_compressed_index(compressed_to_grid_x[layer_num], grid_loc.x);
-        int cy = find_compressed_index(compressed_to_grid_y[layer_num], grid_loc.y);
+        int cx = t_compressed_dim_lookup::lookup(grid_to_compressed_x[layer_num].round_up, grid_loc.x);
+        int cy = t_compressed_dim_lookup::lookup(grid_to_compressed_y[layer_num].round_up, grid_loc.y);
 
         return {cx, cy, layer_num};
     }
@@ -97,21 +130,9 @@ struct t_compressed_block_grid {
      * @return The corresponding compressed location with the same layer number.
      */
     inline t_physical_tile_loc grid_loc_to_compressed_loc_approx_round_down(t_physical_tile_loc grid_loc) const {
-        auto find_compressed_index = [](const std::vector<int>& compressed, int value) -> int {
-            // Get the first element that is strictly bigger than the value
-            auto itr = std::upper_bound(compressed.begin(), compressed.end(), value);
-            if (itr == compressed.begin()) {
-                // If all the compressed locations are bigger than the grid location, return the first compressed location
-                return 0;
-            } else {
-                // Return the index of the first element that is less than or equal to the value
-                return std::distance(compressed.begin(), itr - 1);
-            }
-        };
-
         int layer_num = grid_loc.layer_num;
-        int cx = find_compressed_index(compressed_to_grid_x[layer_num], grid_loc.x);
-        int cy = find_compressed_index(compressed_to_grid_y[layer_num], grid_loc.y);
+        int cx = t_compressed_dim_lookup::lookup(grid_to_compressed_x[layer_num].round_down, grid_loc.x);
+        int cy = t_compressed_dim_lookup::lookup(grid_to_compressed_y[layer_num].round_down, grid_loc.y);
 
         return {cx, cy, layer_num};
     }
@@ -126,35 +147,9 @@ struct t_compressed_block_grid {
      *           or OPEN if a location does not exist.
      */
     inline t_physical_tile_loc grid_loc_to_compressed_loc_approx(t_physical_tile_loc grid_loc) const {
-        auto find_closest_compressed_point = [](int loc, const std::vector<int>& compressed_grid_dim) -> int {
-            // If the compressed grid dim's size is 0, this means that there are
-            // no compatible locations for a block of the given type. Returns OPEN
-            // in that case.
-            if (compressed_grid_dim.size() == 0) {
-                return UNDEFINED;
-            }
-
-            // Find the first element not less than loc
-            auto itr = std::lower_bound(compressed_grid_dim.begin(), compressed_grid_dim.end(), loc);
-
-            if (itr == compressed_grid_dim.begin()) {
-                // If all the compressed locations are bigger that or equal to loc, return the first compressed location
-                return 0;
-            } else if (itr == compressed_grid_dim.end()) {
-                // If all the compressed locations are less than loc, return the last compressed location
-                return compressed_grid_dim.size() - 1;
-            } else {
-                // Find the nearest compressed location.
-                int dist_prev = loc - *(itr - 1);
-                int dist_next = *itr - loc;
-                VTR_ASSERT_DEBUG(dist_prev >= 0 && dist_next >= 0);
-                return (dist_prev <= dist_next) ? (std::distance(compressed_grid_dim.begin(), itr - 1)) : (std::distance(compressed_grid_dim.begin(), itr));
-            }
-        };
-
         const int layer_num = grid_loc.layer_num;
-        const int cx = find_closest_compressed_point(grid_loc.x, compressed_to_grid_x[layer_num]);
-        const int cy = find_closest_compressed_point(grid_loc.y, compressed_to_grid_y[layer_num]);
+        const int cx = t_compressed_dim_lookup::lookup(grid_to_compressed_x[layer_num].nearest, grid_loc.x);
+        const int cy = t_compressed_dim_lookup::lookup(grid_to_compressed_y[layer_num].nearest, grid_loc.y);
 
         return {cx, cy, layer_num};
     }
@@ -177,6 +172,33 @@ struct t_compressed_block_grid {
     inline const std::vector<int>& get_layer_nums() const {
         return compressed_to_grid_layer;
     }
+
+    inline bool is_sparse_column(int cx, int layer_num) const {
+        return (int)grid[layer_num][cx].size() < MIN_NUM_BLOCKS_IN_COLUMN;
+    }
+
+    /**
+     * @brief Returns the number of locations of the layer in the columns [search_range.xmin, cx_max]
+     * and the rows [search_range.ymin, search_range.ymax].
+     *
+     * If expand_sparse_columns is true, all the locations of the sparse columns are counted,
+     * whatever their row.
+     */
+    int num_locs_in_range(const t_bb& search_range, int cx_max, int layer_num, bool expand_sparse_columns) const;
+
+    /**
+     * @brief Returns the index of compressed_loc among the locations counted by num_locs_in_range(),
+     * ordered by column and then by row, or UNDEFINED if it is not one of them.
+     */
+    int loc_index_in_range(const t_bb& search_range, const t_physical_tile_loc& compressed_loc, bool expand_sparse_columns) const;
+
+    /**
+     * @brief Returns the location of the given index among the locations counted by num_locs_in_range(),
+     * ordered by column and then by row. This is the inverse of loc_index_in_range().
+     *
+     * Takes O(log(number of columns)) time.
+     */
+    t_physical_tile_loc loc_in_range(const t_bb& search_range, int index, int layer_num, bool expand_sparse_columns) const;
 };
 
 //Compressed grid space for each block type
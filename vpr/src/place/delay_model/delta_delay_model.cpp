@@ -30,6 +30,34 @@ float DeltaDelayModel::delay(const t_physical_tile_loc& from_loc, int /*from_pin
     return delays_[from_loc.layer_num][to_loc.layer_num][delta_x][delta_y];
 }
 
+void DeltaDelayModel::delays(t_place_delay_batch& batch) const {
+    const size_t num_connections = batch.size();
+    batch.delays.resize(num_connections);
+    if (num_connections == 0) {
+        return;
+    }
+
+    // Index the flat delay array directly rather than going through the matrix
+    // proxies, so that the loop has no branches or calls and the compiler can
+    // turn it into vector index computations and gathers.
+    const int num_to_layers = (int)delays_.dim_size(1);
+    const int num_dx = (int)delays_.dim_size(2);
+    const int num_dy = (int)delays_.dim_size(3);
+    const float* delay_data = &delays_.get(0);
+
+    const t_physical_tile_loc* from_locs = batch.from_locs.data();
+    const t_physical_tile_loc* to_locs = batch.to_locs.data();
+    float* out = batch.delays.data();
+
+    for (size_t i = 0; i < num_connections; ++i) {
+        const int delta_x = std::abs(from_locs[i].x - to_locs[i].x);
+        const int delta_y = std::abs(from_locs[i].y - to_locs[i].y);
+        const int index = ((from_locs[i].layer_num * num_to_layers + to_locs[i].layer_num) * num_dx + delta_x) * num_dy + delta_y;
+        VTR_ASSERT_SAFE(delta_x < num_dx && delta_y < num_dy);
+        out[i] = delay_data[index];
+    }
+}
+
 void DeltaDelayModel::dump_echo(std::string filepath) const {
     FILE* f = vtr::fopen(filepath.c_str(), "w");
     fprintf(f, "         ");
@@ -28,6 +28,8 @@ class DeltaDelayModel : public PlaceDelayModel {
 
     float delay(const t_physical_tile_loc& from_loc, int /*from_pin*/, const t_physical_tile_loc& to_loc, int /*to_pin*/) const override;
 
+    void delays(t_place_delay_batch& batch) const override;
+
     void dump_echo(std::string filepath) const override;
 
     void read(const std::string& file) override;
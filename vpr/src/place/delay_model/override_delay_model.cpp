@@ -142,6 +142,36 @@ float OverrideDelayModel::delay(const t_physical_tile_loc& from_loc, int from_pi
     return delay_val;
 }
 
+void OverrideDelayModel::delays(t_place_delay_batch& batch) const {
+    base_delay_model_->delays(batch);
+
+    if (delay_overrides_.empty()) {
+        return;
+    }
+
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const t_physical_tile_loc& from_loc = batch.from_locs[i];
+        const t_physical_tile_loc& to_loc = batch.to_locs[i];
+        t_physical_tile_type_ptr from_type_ptr = grid.get_physical_type(from_loc);
+        t_physical_tile_type_ptr to_type_ptr = grid.get_physical_type(to_loc);
+
+        t_override override_key;
+        override_key.from_type = from_type_ptr->index;
+        override_key.from_class = from_type_ptr->pin_class[batch.from_pins[i]];
+        override_key.to_type = to_type_ptr->index;
+        override_key.to_class = to_type_ptr->pin_class[batch.to_pins[i]];
+        override_key.delta_x = to_loc.x - from_loc.x;
+        override_key.delta_y = to_loc.y - from_loc.y;
+
+        auto override_iter = delay_overrides_.find(override_key);
+        if (override_iter != delay_overrides_.end()) {
+            batch.delays[i] = override_iter->second;
+        }
+    }
+}
+
 void OverrideDelayModel::set_delay_override(int from_type, int from_class, int to_type, int to_class, int delta_x, int delta_y, float delay_val) {
     t_override override_key;
     override_key.from_type = from_type;
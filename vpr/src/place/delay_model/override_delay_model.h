@@ -21,6 +21,9 @@ class OverrideDelayModel : public PlaceDelayModel {
      */
     float delay(const t_physical_tile_loc& from_loc, int from_pin, const t_physical_tile_loc& to_loc, int to_pin) const override;
 
+    ///@brief Looks up the whole batch in the base delay model, then applies the overrides.
+    void delays(t_place_delay_batch& batch) const override;
+
     void dump_echo(std::string filepath) const override;
 
     void read(const std::string& file) override;
@@ -62,6 +62,42 @@ float comp_td_single_connection_delay(const PlaceDelayModel* delay_model,
     return (delay_source_to_sink);
 }
 
+void comp_td_net_connection_delays(const PlaceDelayModel* delay_model,
+                                   const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
+                                   ClusterNetId net_id,
+                                   t_place_delay_batch& batch) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const size_t num_sinks = clb_nlist.net_sinks(net_id).size();
+
+    batch.clear();
+
+    // Ignored nets (e.g. globals) are assumed to have zero delay
+    if (clb_nlist.net_is_ignored(net_id)) {
+        batch.delays.resize(num_sinks, 0.);
+        return;
+    }
+
+    ClusterPinId source_pin = clb_nlist.net_driver(net_id);
+    const t_pl_loc source_block_loc = block_locs[clb_nlist.pin_block(source_pin)].loc;
+    const t_physical_tile_loc source_loc(source_block_loc.x, source_block_loc.y, source_block_loc.layer);
+    const int source_block_ipin = clb_nlist.pin_logical_index(source_pin);
+
+    for (ClusterPinId sink_pin : clb_nlist.net_sinks(net_id)) {
+        const t_pl_loc sink_block_loc = block_locs[clb_nlist.pin_block(sink_pin)].loc;
+        batch.add(source_loc, source_block_ipin,
+                  {sink_block_loc.x, sink_block_loc.y, sink_block_loc.layer}, clb_nlist.pin_logical_index(sink_pin));
+    }
+
+    delay_model->delays(batch);
+
+    for (size_t isink = 0; isink < num_sinks; ++isink) {
+        if (batch.delays[isink] < 0) {
+            // Recompute the connection on its own to report the bad delay
+            comp_td_single_connection_delay(delay_model, block_locs, net_id, isink + 1);
+        }
+    }
+}
+
 ///@brief Recompute all point to point delays, updating `connection_delay` matrix.
 void comp_td_connection_delays(const PlaceDelayModel* delay_model,
                                PlacerState& placer_state) {
@@ -70,9 +106,20 @@ void comp_td_connection_delays(const PlaceDelayModel* delay_model,
     auto& block_locs = placer_state.block_locs();
     auto& connection_delay = p_timing_ctx.connection_delay;
 
+    t_place_delay_batch batch;
     for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        comp_td_net_connection_delays(delay_model, block_locs, net_id, batch);
         for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ++ipin) {
-            connection_delay[net_id][ipin] = comp_td_single_connection_delay(delay_model, block_locs, net_id, ipin);
+            connection_delay[net_id][ipin] = batch.delays[ipin - 1];
         }
     }
 }
+
+void PlaceDelayModel::delays(t_place_delay_batch& batch) const {
+    const size_t num_connections = batch.size();
+    batch.delays.resize(num_connections);
+
+    for (size_t i = 0; i < num_connections; ++i) {
+        batch.delays[i] = delay(batch.from_locs[i], batch.from_pins[i], batch.to_locs[i], batch.to_pins[i]);
+    }
+}
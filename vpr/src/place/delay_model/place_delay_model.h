@@ -32,6 +32,53 @@ float comp_td_single_connection_delay(const PlaceDelayModel* delay_model,
                                       ClusterNetId net_id,
                                       int ipin);
 
+/**
+ * @brief A batch of point to point connections whose delays are looked up together.
+ *
+ * The connections are stored as parallel arrays so that a delay model can look up
+ * the whole batch in one call with a tight loop, instead of a virtual call per
+ * connection. See PlaceDelayModel::delays().
+ */
+struct t_place_delay_batch {
+    std::vector<t_physical_tile_loc> from_locs;
+    std::vector<int> from_pins;
+    std::vector<t_physical_tile_loc> to_locs;
+    std::vector<int> to_pins;
+    ///@brief The delay of each connection, filled by PlaceDelayModel::delays().
+    std::vector<float> delays;
+
+    size_t size() const { return from_locs.size(); }
+
+    ///@brief Removes all connections while keeping the allocated storage.
+    void clear() {
+        from_locs.clear();
+        from_pins.clear();
+        to_locs.clear();
+        to_pins.clear();
+        delays.clear();
+    }
+
+    void add(const t_physical_tile_loc& from_loc, int from_pin, const t_physical_tile_loc& to_loc, int to_pin) {
+        from_locs.push_back(from_loc);
+        from_pins.push_back(from_pin);
+        to_locs.push_back(to_loc);
+        to_pins.push_back(to_pin);
+    }
+};
+
+/**
+ * @brief Returns the delays of all the sink connections of a net in `batch.delays`.
+ *
+ * On return, `batch.delays[ipin - 1]` holds the same value as
+ * comp_td_single_connection_delay(delay_model, block_locs, net_id, ipin).
+ * The batch is only used as scratch storage, so reusing it between calls
+ * avoids allocations.
+ */
+void comp_td_net_connection_delays(const PlaceDelayModel* delay_model,
+                                   const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
+                                   ClusterNetId net_id,
+                                   t_place_delay_batch& batch);
+
 ///@brief Recompute all point to point delays, updating `connection_delay` matrix.
 void comp_td_connection_delays(const PlaceDelayModel* delay_model,
                                PlacerState& placer_state);
@@ -54,6 +101,15 @@ class PlaceDelayModel {
      */
     virtual float delay(const t_physical_tile_loc& from_loc, int from_pin, const t_physical_tile_loc& to_loc, int to_pin) const = 0;
 
+    /**
+     * @brief Fills `batch.delays` with the delay estimate of every connection in the batch.
+     *
+     * Equivalent to calling delay() for each connection. The default implementation
+     * does exactly that; models with a cheap lookup override it to process the
+     * whole batch without a virtual call per connection.
+     */
+    virtual void delays(t_place_delay_batch& batch) const;
+
     ///@brief Dumps the delay model to an echo file.
     virtual void dump_echo(std::string filename) const = 0;
 
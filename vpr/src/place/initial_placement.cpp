@@ -28,10 +28,16 @@
 #include <cstdlib>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <optional>
 #include <queue>
 #include <vector>
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #ifdef VERBOSE
 void print_clb_placement(const char* fname);
 #endif
@@ -279,6 +285,45 @@ static void place_all_blocks(const t_placer_opts& placer_opts,
                              const FlatPlacementInfo& flat_placement_info,
                              vtr::RngContainer& rng);
 
+/**
+ * @brief Calls place_block for each of the given blocks, starting with the blocks that are
+ * the most difficult to place according to their scores.
+ *
+ * The scores change as blocks are placed, so the order is refreshed periodically rather
+ * than after every block.
+ */
+template<typename F>
+static void for_each_block_by_score(const std::vector<ClusterBlockId>& blocks,
+                                    const vtr::vector<ClusterBlockId, t_block_score>& block_scores,
+                                    F&& place_block);
+
+/**
+ * @brief Partitions the unplaced blocks into placement domains.
+ *
+ * Two logical block types belong to the same domain if they can be placed in a common
+ * physical tile type. The blocks of different domains therefore never compete for the
+ * same grid locations, and the domains can be placed independently of each other.
+ *
+ * @return The unplaced blocks of each domain.
+ */
+static std::vector<std::vector<ClusterBlockId>> partition_unplaced_blocks_by_domain(const BlkLocRegistry& blk_loc_registry);
+
+/**
+ * @brief Places the unplaced blocks of each placement domain concurrently.
+ *
+ * Each domain is placed on a private copy of the placement, with its own random number
+ * generator seeded from rng, so the result does not depend on the number of threads.
+ * The blocks of a domain only see the blocks of other domains that were placed before
+ * this routine is called (e.g. fixed blocks). The placed blocks are then copied back into
+ * blk_loc_registry. Blocks that could not be placed are left for the serial placement.
+ */
+static void place_domains_in_parallel(const vtr::vector<ClusterBlockId, t_block_score>& block_scores,
+                                      e_pad_loc_type pad_loc_type,
+                                      BlkLocRegistry& blk_loc_registry,
+                                      const PlaceMacros& place_macros,
+                                      const FlatPlacementInfo& flat_placement_info,
+                                      vtr::RngContainer& rng);
+
 /**
  * @brief If any blocks remain unplaced after all initial placement iterations, this routine
  * throws an error indicating that initial placement can not be done with the current device size or
@@ -440,14 +485,11 @@ static bool find_centroid_neighbor(ClusterBlockId block_id,
                                                                 compressed_loc_on_layer,
                                                                 first_rlim);
 
-    int delta_cx = search_range.xmax - search_range.xmin;
-
     bool block_constrained = is_cluster_constrained(block_id);
 
     if (block_constrained) {
         bool intersect = intersect_range_limit_with_floorplan_constraints(block_id,
                                                                           search_range,
-                                                                          delta_cx,
                                                                           centroid_loc_layer_num);
         if (!intersect) {
             return false;
@@ -462,11 +504,9 @@ static bool find_centroid_neighbor(ClusterBlockId block_id,
     t_physical_tile_loc to_compressed_loc;
 
     bool legal = find_compatible_compressed_loc_in_range(block_type,
-                                                         delta_cx,
                                                          {cx_from, cy_from, layer_from},
                                                          search_range,
                                                          to_compressed_loc,
-                                                         /*is_median=*/false,
                                                          centroid_loc_layer_num,
                                                          search_for_empty,
                                                          blk_loc_registry,
@@ -1100,8 +1140,6 @@ bool try_place_macro_randomly(const t_pl_macro& pl_macro,
 
     auto max_compressed_loc = compressed_block_grid.grid_loc_to_compressed_loc_approx({reg_rect.xmax(), reg_rect.ymax(), selected_layer});
 
-    int delta_cx = max_compressed_loc.x - min_compressed_loc.x;
-
     t_physical_tile_loc to_compressed_loc;
 
     bool legal;
@@ -1110,13 +1148,11 @@ bool try_place_macro_randomly(const t_pl_macro& pl_macro,
     // the search range covers the entire region, so there is no need for
     // the search range to be adjusted
     legal = find_compatible_compressed_loc_in_range(block_type,
-                                                    delta_cx,
                                                     {cx_from, cy_from, selected_layer},
                                                     {min_compressed_loc.x, max_compressed_loc.x,
                                                      min_compressed_loc.y, max_compressed_loc.y,
                                                      selected_layer, selected_layer},
                                                     to_compressed_loc,
-                                                    /*is_median=*/false,
                                                     selected_layer,
                                                     /*search_for_empty=*/false,
                                                     blk_loc_registry,
@@ -1428,13 +1464,6 @@ static void place_all_blocks(const t_placer_opts& placer_opts,
     //keep tracks of which block types can not be placed in each iteration
     std::unordered_set<int> unplaced_blk_type_in_curr_itr;
 
-    auto criteria = [&block_scores](ClusterBlockId lhs, ClusterBlockId rhs) {
-        int lhs_score = block_scores[lhs].macro_size + block_scores[lhs].number_of_placed_connections + SORT_WEIGHT_PER_TILES_OUTSIDE_OF_PR * block_scores[lhs].tiles_outside_of_floorplan_constraints + SORT_WEIGHT_PER_FAILED_BLOCK * block_scores[lhs].failed_to_place_in_prev_attempts;
-        int rhs_score = block_scores[rhs].macro_size + block_scores[rhs].number_of_placed_connections + SORT_WEIGHT_PER_TILES_OUTSIDE_OF_PR * block_scores[rhs].tiles_outside_of_floorplan_constraints + SORT_WEIGHT_PER_FAILED_BLOCK * block_scores[rhs].failed_to_place_in_prev_attempts;
-
-        return lhs_score < rhs_score;
-    };
-
     // Keeps the first locations and number of remained blocks in each column for a specific block type.
     //[0..device_ctx.logical_block_types.size()-1][0..num_of_grid_columns_containing_this_block_type-1]
     std::vector<std::vector<t_grid_empty_locs_block_type>> blk_types_empty_locs_in_grid;
@@ -1454,19 +1483,14 @@ static void place_all_blocks(const t_placer_opts& placer_opts,
 
         number_of_unplaced_blks_in_curr_itr = 0;
 
-        //calculate heap update frequency based on number of blocks in the design
-        int update_heap_freq = std::max((int)(blocks.size() / 100), 1);
-
-        int blocks_placed_since_heap_update = 0;
-
-        std::vector<ClusterBlockId> heap_blocks(blocks.begin(), blocks.end());
-        std::make_heap(heap_blocks.begin(), heap_blocks.end(), criteria);
-
-        while (!heap_blocks.empty()) {
-            std::pop_heap(heap_blocks.begin(), heap_blocks.end(), criteria);
-            auto blk_id = heap_blocks.back();
-            heap_blocks.pop_back();
+        // The later iterations only place the few block types that failed, so only the first one is parallelized.
+        // Any block that the parallel placement could not place is placed serially below.
+        if (placer_opts.place_init_parallel && iter_no == 0) {
+            place_domains_in_parallel(block_scores, pad_loc_type, blk_loc_registry, place_macros, flat_placement_info, rng);
+        }
 
+        std::vector<ClusterBlockId> blocks_to_place(blocks.begin(), blocks.end());
+        for_each_block_by_score(blocks_to_place, block_scores, [&](ClusterBlockId blk_id) {
             auto blk_id_type = cluster_ctx.clb_nlist.block_type(blk_id);
 
             if constexpr (VTR_ENABLE_DEBUG_LOGGING_CONST_EXPR) {
@@ -1475,8 +1499,6 @@ static void place_all_blocks(const t_placer_opts& placer_opts,
 
             VTR_LOGV_DEBUG(g_vpr_ctx.placement().f_placer_debug, "Popped Block %d\n", size_t(blk_id));
 
-            blocks_placed_since_heap_update++;
-
             bool block_placed = place_one_block(blk_id,
                                                 pad_loc_type,
                                                 &blk_types_empty_locs_in_grid[blk_id_type->index],
@@ -1486,12 +1508,6 @@ static void place_all_blocks(const t_placer_opts& placer_opts,
                                                 flat_placement_info,
                                                 rng);
 
-            //update heap based on update_heap_freq calculated above
-            if (blocks_placed_since_heap_update % (update_heap_freq) == 0) {
-                std::make_heap(heap_blocks.begin(), heap_blocks.end(), criteria);
-                blocks_placed_since_heap_update = 0;
-            }
-
             if (!block_placed) {
                 VTR_LOGV_DEBUG(g_vpr_ctx.placement().f_placer_debug, "Didn't find a location the block\n", size_t(blk_id));
                 //add current block to list to ensure it will be placed sooner in the next iteration in initial placement
@@ -1502,7 +1518,7 @@ static void place_all_blocks(const t_placer_opts& placer_opts,
                     unplaced_blk_type_in_curr_itr.insert(blk_id_type->index);
                 }
             }
-        }
+        });
 
         //current iteration could place all of design's blocks, initial placement succeed
         if (number_of_unplaced_blks_in_curr_itr == 0) {
@@ -1520,6 +1536,157 @@ static void place_all_blocks(const t_placer_opts& placer_opts,
     }
 }
 
+template<typename F>
+static void for_each_block_by_score(const std::vector<ClusterBlockId>& blocks,
+                                    const vtr::vector<ClusterBlockId, t_block_score>& block_scores,
+                                    F&& place_block) {
+    auto criteria = [&block_scores](ClusterBlockId lhs, ClusterBlockId rhs) {
+        int lhs_score = block_scores[lhs].macro_size + block_scores[lhs].number_of_placed_connections + SORT_WEIGHT_PER_TILES_OUTSIDE_OF_PR * block_scores[lhs].tiles_outside_of_floorplan_constraints + SORT_WEIGHT_PER_FAILED_BLOCK * block_scores[lhs].failed_to_place_in_prev_attempts;
+        int rhs_score = block_scores[rhs].macro_size + block_scores[rhs].number_of_placed_connections + SORT_WEIGHT_PER_TILES_OUTSIDE_OF_PR * block_scores[rhs].tiles_outside_of_floorplan_constraints + SORT_WEIGHT_PER_FAILED_BLOCK * block_scores[rhs].failed_to_place_in_prev_attempts;
+
+        return lhs_score < rhs_score;
+    };
+
+    //calculate heap update frequency based on number of blocks in the design
+    int update_heap_freq = std::max((int)(blocks.size() / 100), 1);
+
+    int blocks_placed_since_heap_update = 0;
+
+    std::vector<ClusterBlockId> heap_blocks(blocks);
+    std::make_heap(heap_blocks.begin(), heap_blocks.end(), criteria);
+
+    while (!heap_blocks.empty()) {
+        std::pop_heap(heap_blocks.begin(), heap_blocks.end(), criteria);
+        auto blk_id = heap_blocks.back();
+        heap_blocks.pop_back();
+
+        blocks_placed_since_heap_update++;
+
+        place_block(blk_id);
+
+        //update heap based on update_heap_freq calculated above
+        if (blocks_placed_since_heap_update % (update_heap_freq) == 0) {
+            std::make_heap(heap_blocks.begin(), heap_blocks.end(), criteria);
+            blocks_placed_since_heap_update = 0;
+        }
+    }
+}
+
+static std::vector<std::vector<ClusterBlockId>> partition_unplaced_blocks_by_domain(const BlkLocRegistry& blk_loc_registry) {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& block_locs = blk_loc_registry.block_locs();
+
+    // Merge the logical block types sharing a physical tile type with a union-find
+    const size_t num_logical_types = device_ctx.logical_block_types.size();
+    std::vector<int> type_parent(num_logical_types);
+    std::iota(type_parent.begin(), type_parent.end(), 0);
+
+    auto find_root = [&type_parent](int itype) {
+        while (type_parent[itype] != itype) {
+            type_parent[itype] = type_parent[type_parent[itype]];
+            itype = type_parent[itype];
+        }
+        return itype;
+    };
+
+    std::vector<int> tile_first_type(device_ctx.physical_tile_types.size(), UNDEFINED);
+    for (const t_logical_block_type& logical_type : device_ctx.logical_block_types) {
+        for (t_physical_tile_type_ptr tile : logical_type.equivalent_tiles) {
+            if (tile_first_type[tile->index] == UNDEFINED) {
+                tile_first_type[tile->index] = logical_type.index;
+            } else {
+                type_parent[find_root(logical_type.index)] = find_root(tile_first_type[tile->index]);
+            }
+        }
+    }
+
+    std::vector<int> root_domain(num_logical_types, UNDEFINED);
+    std::vector<std::vector<ClusterBlockId>> domain_blocks;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (is_block_placed(blk_id, block_locs)) {
+            continue;
+        }
+
+        int root = find_root(cluster_ctx.clb_nlist.block_type(blk_id)->index);
+        if (root_domain[root] == UNDEFINED) {
+            root_domain[root] = (int)domain_blocks.size();
+            domain_blocks.emplace_back();
+        }
+        domain_blocks[root_domain[root]].push_back(blk_id);
+    }
+
+    return domain_blocks;
+}
+
+static void place_domains_in_parallel(const vtr::vector<ClusterBlockId, t_block_score>& block_scores,
+                                      e_pad_loc_type pad_loc_type,
+                                      BlkLocRegistry& blk_loc_registry,
+                                      const PlaceMacros& place_macros,
+                                      const FlatPlacementInfo& flat_placement_info,
+                                      vtr::RngContainer& rng) {
+    const std::vector<std::vector<ClusterBlockId>> domain_blocks = partition_unplaced_blocks_by_domain(blk_loc_registry);
+    const size_t num_domains = domain_blocks.size();
+
+    if (num_domains < 2) {
+        return;
+    }
+
+    std::vector<int> domain_seeds(num_domains);
+    for (int& seed : domain_seeds) {
+        seed = rng.irand(std::numeric_limits<int>::max() / 2);
+    }
+
+    // The device partition region is built the first time it is requested, so build it before the threads read it
+    get_device_partition_region();
+
+    std::vector<std::unique_ptr<BlkLocRegistry>> domain_blk_loc_registries(num_domains);
+
+    auto place_domain = [&](size_t idomain) {
+        domain_blk_loc_registries[idomain] = std::make_unique<BlkLocRegistry>();
+        BlkLocRegistry& domain_blk_loc_registry = *domain_blk_loc_registries[idomain];
+        domain_blk_loc_registry = blk_loc_registry;
+
+        vtr::RngContainer domain_rng(domain_seeds[idomain]);
+        vtr::vector<ClusterBlockId, t_block_score> domain_block_scores = block_scores;
+
+        // Dense placement is only used in the later, serial iterations
+        std::vector<t_grid_empty_locs_block_type> no_empty_locs;
+
+        for_each_block_by_score(domain_blocks[idomain], domain_block_scores, [&](ClusterBlockId blk_id) {
+            place_one_block(blk_id,
+                            pad_loc_type,
+                            &no_empty_locs,
+                            &domain_block_scores,
+                            domain_blk_loc_registry,
+                            place_macros,
+                            flat_placement_info,
+                            domain_rng);
+        });
+    };
+
+    // Each domain only writes to its own copy of the placement, so the result is the same with or without threads
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_domains, place_domain);
+#else
+    for (size_t idomain = 0; idomain < num_domains; idomain++) {
+        place_domain(idomain);
+    }
+#endif
+
+    // The domains use disjoint grid locations, so their placements can be combined in any order
+    auto& block_locs = blk_loc_registry.mutable_block_locs();
+    for (size_t idomain = 0; idomain < num_domains; idomain++) {
+        const auto& domain_block_locs = domain_blk_loc_registries[idomain]->block_locs();
+        for (ClusterBlockId blk_id : domain_blocks[idomain]) {
+            if (is_block_placed(blk_id, domain_block_locs)) {
+                blk_loc_registry.set_block_location(blk_id, domain_block_locs[blk_id].loc);
+                block_locs[blk_id].is_fixed = domain_block_locs[blk_id].is_fixed;
+            }
+        }
+    }
+}
+
 /**
  * @brief Gets or creates a macro for the given blk_id.
  *
@@ -0,0 +1,134 @@
+#include "group_move_generator.h"
+
+#include "globals.h"
+#include "place_constraints.h"
+#include "place_macro.h"
+#include "place_multilevel.h"
+#include "placer_state.h"
+#include "move_utils.h"
+#include "vtr_random.h"
+
+GroupMoveGenerator::GroupMoveGenerator(PlacerState& placer_state,
+                                       const PlaceMacros& place_macros,
+                                       const NetCostHandler& net_cost_handler,
+                                       const t_place_coarse_level& coarse_level,
+                                       e_reward_function reward_function,
+                                       vtr::RngContainer& rng)
+    : MoveGenerator(placer_state, place_macros, net_cost_handler, reward_function, rng)
+    , coarse_level_(coarse_level) {}
+
+e_create_move GroupMoveGenerator::propose_move(t_pl_blocks_to_be_moved& blocks_affected,
+                                               t_propose_action& proposed_action,
+                                               float rlim,
+                                               const t_placer_opts& /*placer_opts*/,
+                                               const PlacerCriticalities* /*criticalities*/) {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& placer_state = placer_state_.get();
+    const auto& block_locs = placer_state.block_locs();
+    const auto& blk_loc_registry = placer_state.blk_loc_registry();
+    const GridBlock& grid_blocks = blk_loc_registry.grid_blocks();
+
+    if (coarse_level_.groups.empty()) {
+        return e_create_move::ABORT;
+    }
+
+    const int igroup = rng_.irand((int)coarse_level_.groups.size() - 1);
+    const std::vector<ClusterBlockId>& group = coarse_level_.groups[igroup];
+
+    // All the blocks of a group have the same type, so they can be translated in the same compressed grid
+    const ClusterBlockId anchor_blk = group[0];
+    const t_logical_block_type_ptr group_type = cluster_ctx.clb_nlist.block_type(anchor_blk);
+    proposed_action.move_type = e_move_type::UNIFORM;
+    proposed_action.logical_blk_type_index = group_type->index;
+
+    const t_pl_loc anchor_from = block_locs[anchor_blk].loc;
+    t_pl_loc anchor_to;
+    if (!find_to_loc_uniform(group_type, rlim, anchor_from, anchor_to, anchor_blk, blk_loc_registry, rng_)) {
+        return e_create_move::ABORT;
+    }
+
+    // Only used on single layer devices, so the group stays in its layer
+    VTR_ASSERT_SAFE(anchor_to.layer == anchor_from.layer);
+
+    const t_compressed_block_grid& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[group_type->index];
+    const t_physical_tile_loc anchor_from_compressed = compressed_block_grid.grid_loc_to_compressed_loc({anchor_from.x, anchor_from.y, anchor_from.layer});
+    const t_physical_tile_loc anchor_to_compressed = compressed_block_grid.grid_loc_to_compressed_loc({anchor_to.x, anchor_to.y, anchor_to.layer});
+    const int delta_cx = anchor_to_compressed.x - anchor_from_compressed.x;
+    const int delta_cy = anchor_to_compressed.y - anchor_from_compressed.y;
+
+    if (delta_cx == 0 && delta_cy == 0) {
+        blocks_affected.move_abortion_logger.log_move_abort("group move without offset");
+        return e_create_move::ABORT;
+    }
+
+    displaced_blocks_.clear();
+
+    for (ClusterBlockId blk : group) {
+        const t_pl_loc from = block_locs[blk].loc;
+        const t_physical_tile_loc from_compressed = compressed_block_grid.grid_loc_to_compressed_loc({from.x, from.y, from.layer});
+
+        // The translated location must exist in the compressed grid, which may have partial columns
+        const int to_cx = from_compressed.x + delta_cx;
+        const int to_cy = from_compressed.y + delta_cy;
+        if (to_cx < 0 || to_cx >= (int)compressed_block_grid.get_num_columns(from.layer)) {
+            blocks_affected.move_abortion_logger.log_move_abort("group move off the compressed grid");
+            return e_create_move::ABORT;
+        }
+
+        const auto& block_rows = compressed_block_grid.get_column_block_map(to_cx, from.layer);
+        auto to_itr = block_rows.find(to_cy);
+        if (to_itr == block_rows.end()) {
+            blocks_affected.move_abortion_logger.log_move_abort("group move off the compressed grid");
+            return e_create_move::ABORT;
+        }
+
+        const t_pl_loc to(to_itr->second.x, to_itr->second.y, from.sub_tile, from.layer);
+        if (!is_legal_swap_to_location(blk, to, blk_loc_registry)) {
+            blocks_affected.move_abortion_logger.log_move_abort("group move to location illegal");
+            return e_create_move::ABORT;
+        }
+
+        ClusterBlockId blk_to = grid_blocks.block_at_location(to);
+        if (blocks_affected.record_block_move(blk, to, blk_loc_registry) != e_block_move_result::VALID) {
+            return e_create_move::ABORT;
+        }
+
+        // Blocks of the same group move out of the way by themselves
+        if (blk_to && coarse_level_.block_group[blk_to] != igroup) {
+            displaced_blocks_.emplace_back(blk_to, from);
+        }
+    }
+
+    // Swap each displaced block with the group block that displaced it. If another
+    // group block moves into that location, use one of the other vacated locations.
+    const std::vector<t_pl_loc>& empty_locs = blocks_affected.determine_locations_emptied_by_move();
+    size_t iempty_loc = 0;
+
+    for (const auto& [blk, swap_loc] : displaced_blocks_) {
+        t_pl_loc to = swap_loc;
+        if (blocks_affected.is_moved_to(to)) {
+            while (iempty_loc < empty_locs.size() && blocks_affected.is_moved_to(empty_locs[iempty_loc])) {
+                ++iempty_loc;
+            }
+            VTR_ASSERT(iempty_loc < empty_locs.size());
+            to = empty_locs[iempty_loc];
+        }
+
+        // Moving part of a macro would break it apart
+        if (place_macros_.get_imacro_from_iblk(blk) != -1 || !is_legal_swap_to_location(blk, to, blk_loc_registry)) {
+            blocks_affected.move_abortion_logger.log_move_abort("group move displaced block illegal");
+            return e_create_move::ABORT;
+        }
+
+        if (blocks_affected.record_block_move(blk, to, blk_loc_registry) != e_block_move_result::VALID) {
+            return e_create_move::ABORT;
+        }
+    }
+
+    //Check that all the blocks affected by the move would still be in a legal floorplan region after the swap
+    if (!floorplan_legal(blocks_affected)) {
+        return e_create_move::ABORT;
+    }
+
+    return e_create_move::VALID;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "move_generator.h"
+
+#include <utility>
+#include <vector>
+
+class PlaceMacros;
+struct t_place_coarse_level;
+
+/**
+ * @brief Moves the block groups of a coarse level of a multilevel placement
+ *
+ * Picks a random group and translates all of its blocks by the same offset in the
+ * compressed grid of their logical block type, so the connections inside the group
+ * keep their length. The offset is found by moving the group's anchor block to a
+ * random location within the range limit. Blocks displaced by the group are moved
+ * into the locations the group vacates.
+ *
+ * Precondition: the device has a single layer. Groups are translated within the
+ * compressed grid of one layer, so multilevel placement is only run on single
+ * layer devices (see Placer).
+ */
+class GroupMoveGenerator : public MoveGenerator {
+  public:
+    GroupMoveGenerator() = delete;
+    GroupMoveGenerator(PlacerState& placer_state,
+                       const PlaceMacros& place_macros,
+                       const NetCostHandler& net_cost_handler,
+                       const t_place_coarse_level& coarse_level,
+                       e_reward_function reward_function,
+                       vtr::RngContainer& rng);
+
+  private:
+    e_create_move propose_move(t_pl_blocks_to_be_moved& blocks_affected,
+                               t_propose_action& proposed_action,
+                               float rlim,
+                               const t_placer_opts& /*placer_opts*/,
+                               const PlacerCriticalities* /*criticalities*/) override;
+
+  private:
+    const t_place_coarse_level& coarse_level_;
+    /// Blocks displaced by the group being moved, with the location the group block that displaced them moves from
+    std::vector<std::pair<ClusterBlockId, t_pl_loc>> displaced_blocks_;
+};
@@ -5,6 +5,7 @@
 #include "PlacerCriticalities.h"
 
 #include <functional>
+#include <iosfwd>
 #include <limits>
 
 class PlaceMacros;
@@ -146,6 +147,18 @@ class MoveGenerator {
      */
     virtual void process_outcome(double /*reward*/, e_reward_function /*reward_fun*/) {}
 
+    /**
+     * @brief Writes the learned state of the move generator's RL agent, if it has one
+     */
+    virtual void write_agent_state(std::ostream& /*os*/) {}
+
+    /**
+     * @brief Warm-starts the move generator's RL agent from a state written by write_agent_state()
+     *
+     * @return false if the move generator has no agent or the state does not match its agent
+     */
+    virtual bool read_agent_state(std::istream& /*is*/) { return false; }
+
     /**
      * @brief Calculates the agent's reward and the total process outcome
      *
@@ -6,7 +6,11 @@
 #include "vtr_time.h"
 
 #include <algorithm>
+#include <cmath>
+#include <istream>
+#include <limits>
 #include <numeric>
+#include <ostream>
 #include <utility>
 
 /* File-scope routines */
@@ -31,6 +35,14 @@ void SimpleRLMoveGenerator::process_outcome(double reward, e_reward_function rew
     karmed_bandit_agent->process_outcome(reward, reward_fun);
 }
 
+void SimpleRLMoveGenerator::write_agent_state(std::ostream& os) {
+    karmed_bandit_agent->write_state(os);
+}
+
+bool SimpleRLMoveGenerator::read_agent_state(std::istream& is) {
+    return karmed_bandit_agent->read_state(is);
+}
+
 /*                                        *
  *                                        *
  *  K-Armed bandit agent implementation   *
@@ -73,7 +85,7 @@ KArmedBanditAgent::KArmedBanditAgent(std::vector<e_move_type> available_moves,
  *    while (action_idx / num_available_moves_) determines the block type.
  *
  */
-e_move_type KArmedBanditAgent::action_to_move_type_(const size_t action_idx) {
+e_move_type KArmedBanditAgent::action_to_move_type_(const size_t action_idx) const {
     e_move_type move_type = e_move_type::INVALID_MOVE;
 
     if (action_idx < num_available_actions_) {
@@ -83,7 +95,7 @@ e_move_type KArmedBanditAgent::action_to_move_type_(const size_t action_idx) {
     return move_type;
 }
 
-int KArmedBanditAgent::action_to_blk_type_(const size_t action_idx) {
+int KArmedBanditAgent::action_to_blk_type_(const size_t action_idx) const {
     if (propose_blk_type_) {
         return action_logical_blk_type_.at(action_idx / available_moves_.size());
     } else { // the agent doesn't select the move type
@@ -118,12 +130,26 @@ std::vector<int> KArmedBanditAgent::get_available_logical_blk_types_(const std::
 }
 
 void KArmedBanditAgent::process_outcome(double reward, e_reward_function reward_fun) {
-    ++num_action_chosen_[last_action_];
     if (reward_fun == e_reward_function::RUNTIME_AWARE || reward_fun == e_reward_function::WL_BIASED_RUNTIME_AWARE) {
         e_move_type move_type = action_to_move_type_(last_action_);
         reward /= time_elapsed_[move_type];
     }
 
+    if (batch_size_ > 1) {
+        //Defer the Q-table update to the end of the batch
+        batch_reward_sum_[last_action_] += reward;
+        ++num_batch_rewards_[last_action_];
+        if (++num_batch_moves_ >= batch_size_) {
+            update_q_batch_();
+            if (agent_info_file_) {
+                write_agent_info(last_action_, reward);
+            }
+        }
+        return;
+    }
+
+    ++num_action_chosen_[last_action_];
+
     //Determine step size
     float step = 0.;
     if (exp_alpha_ < 0.) {
@@ -186,6 +212,94 @@ void KArmedBanditAgent::set_step(float gamma, int move_lim) {
     }
 }
 
+void KArmedBanditAgent::set_batch_size(int batch_size) {
+    if (num_batch_moves_ > 0) {
+        update_q_batch_();
+    }
+
+    batch_size_ = std::max(batch_size, 1);
+    batch_reward_sum_.assign(num_available_actions_, 0.);
+    num_batch_rewards_.assign(num_available_actions_, 0);
+    num_batch_moves_ = 0;
+}
+
+void KArmedBanditAgent::update_q_batch_() {
+    for (size_t action = 0; action < num_available_actions_; ++action) {
+        size_t num_rewards = num_batch_rewards_[action];
+        if (num_rewards == 0) {
+            continue;
+        }
+
+        num_action_chosen_[action] += num_rewards;
+        double mean_reward = batch_reward_sum_[action] / num_rewards;
+
+        if (exp_alpha_ < 0.) {
+            //Incremental average: the same result as applying the rewards one at a time
+            q_[action] += (float)num_rewards / num_action_chosen_[action] * (mean_reward - q_[action]);
+        } else {
+            //Exponentially weighted average: the rewards of the batch are weighted as if they were all the mean reward
+            float decay = std::pow(1 - exp_alpha_, (float)num_rewards);
+            q_[action] = decay * q_[action] + (1 - decay) * mean_reward;
+        }
+
+        batch_reward_sum_[action] = 0.;
+        num_batch_rewards_[action] = 0;
+    }
+    num_batch_moves_ = 0;
+
+    q_updated_();
+}
+
+void KArmedBanditAgent::write_state(std::ostream& os) {
+    if (num_batch_moves_ > 0) {
+        update_q_batch_();
+    }
+
+    //Write the Q-values with enough digits to read back exactly the same values
+    std::streamsize precision = os.precision(std::numeric_limits<float>::max_digits10);
+
+    os << num_available_actions_ << "\n";
+    for (size_t action = 0; action < num_available_actions_; ++action) {
+        os << (int)action_to_move_type_(action) << " "
+           << action_to_blk_type_(action) << " "
+           << q_[action] << " "
+           << num_action_chosen_[action] << "\n";
+    }
+
+    os.precision(precision);
+}
+
+bool KArmedBanditAgent::read_state(std::istream& is) {
+    size_t num_actions = 0;
+    if (!(is >> num_actions) || num_actions != num_available_actions_) {
+        return false;
+    }
+
+    std::vector<float> q(num_available_actions_);
+    std::vector<size_t> num_action_chosen(num_available_actions_);
+    for (size_t action = 0; action < num_available_actions_; ++action) {
+        int move_type = 0;
+        int blk_type = 0;
+        if (!(is >> move_type >> blk_type >> q[action] >> num_action_chosen[action])) {
+            return false;
+        }
+
+        //The actions must be the same, e.g. not from a run with a different netlist or agent space
+        if (move_type != (int)action_to_move_type_(action) || blk_type != action_to_blk_type_(action)) {
+            return false;
+        }
+    }
+
+    q_ = std::move(q);
+    num_action_chosen_ = std::move(num_action_chosen);
+    std::fill(batch_reward_sum_.begin(), batch_reward_sum_.end(), 0.);
+    std::fill(num_batch_rewards_.begin(), num_batch_rewards_.end(), 0);
+    num_batch_moves_ = 0;
+
+    q_updated_();
+    return true;
+}
+
 int KArmedBanditAgent::agent_to_phy_blk_type(const int idx) {
     return action_logical_blk_type_.at(idx);
 }
@@ -258,6 +372,10 @@ t_propose_action EpsilonGreedyAgent::propose_action() {
         //Mark the q_table location that agent used to update its value after processing the move outcome
         last_action_ = action_type_q_pos;
 
+    } else if (batch_size_ > 1) {
+        /* Greedy (Exploit)
+         * The Q-table only changes between batches, so the greedy action is cached */
+        last_action_ = greedy_action_;
     } else {
         /* Greedy (Exploit)
          * For probability 1-epsilon, choose the greedy move_type */
@@ -277,6 +395,10 @@ t_propose_action EpsilonGreedyAgent::propose_action() {
     return proposed_action;
 }
 
+void EpsilonGreedyAgent::q_updated_() {
+    greedy_action_ = std::max_element(q_.begin(), q_.end()) - q_.begin();
+}
+
 void EpsilonGreedyAgent::set_epsilon(float epsilon) {
     VTR_LOG("Setting egreedy epsilon: %g\n", epsilon);
     epsilon_ = epsilon;
@@ -337,7 +459,10 @@ void SoftmaxAgent::init_q_scores_(const std::vector<int>& num_movable_blocks_per
 }
 
 t_propose_action SoftmaxAgent::propose_action() {
-    set_action_prob_();
+    //In batch mode, the action probabilities are only recomputed when the Q-table is updated
+    if (batch_size_ <= 1) {
+        set_action_prob_();
+    }
 
     float p = rng_.frand();
     auto itr = std::lower_bound(cumm_action_prob_.begin(), cumm_action_prob_.end(), p);
@@ -354,6 +479,10 @@ t_propose_action SoftmaxAgent::propose_action() {
     return proposed_action;
 }
 
+void SoftmaxAgent::q_updated_() {
+    set_action_prob_();
+}
+
 void SoftmaxAgent::set_block_ratio_(const std::vector<int>& num_movable_blocks_per_type) {
     size_t num_movable_total_blocks = std::max(1, std::accumulate(num_movable_blocks_per_type.begin(), num_movable_blocks_per_type.end(), 0));
 
@@ -55,7 +55,44 @@ class KArmedBanditAgent {
      */
     void set_step(float gamma, int move_lim);
 
+    /**
+     * @brief Set the number of moves between Q-table updates
+     *
+     * With a batch size of 1, the Q-table is updated after every move. With a larger batch size, the rewards
+     * are accumulated and applied to the Q-table (and the action probabilities recomputed) once every
+     * batch_size moves, so actions are sampled from precomputed probabilities in between.
+     *
+     *   @param batch_size Number of moves per batch, can be specified by the command-line option "--place_agent_batch_size"
+     */
+    void set_batch_size(int batch_size);
+
+    /**
+     * @brief Writes the agent's Q-table and action counts, so that later runs can be warm-started from them
+     *
+     * Each line holds the move type, logical block type index (-1 if the agent doesn't propose block types),
+     * estimated value and number of times chosen of one action. The rewards of a partially completed batch are
+     * applied to the Q-table first, so that they are part of the written state.
+     */
+    void write_state(std::ostream& os);
+
+    /**
+     * @brief Reads a Q-table and action counts written by write_state()
+     *
+     * @return false if the state does not match the actions of this agent, in which case the agent is left unchanged
+     */
+    bool read_state(std::istream& is);
+
   protected:
+    /**
+     * @brief Called when the Q-table has been updated, so that the agents can update the data derived from it
+     */
+    virtual void q_updated_() {}
+
+    /**
+     * @brief Applies the rewards accumulated since the last batch update to the Q-table
+     */
+    void update_q_batch_();
+
     /**
      * @brief Converts an action index to a move type.
      *
@@ -63,7 +100,7 @@ class KArmedBanditAgent {
      *
      * @return The move type associated with the selected action.
      */
-    inline e_move_type action_to_move_type_(size_t action_idx);
+    inline e_move_type action_to_move_type_(size_t action_idx) const;
 
     /**
      * @brief Converts an action index to a logical block type index.
@@ -72,7 +109,7 @@ class KArmedBanditAgent {
      *
      * @return The logical block type index associated with the selected action.
      */
-    inline int action_to_blk_type_(size_t action_idx);
+    inline int action_to_blk_type_(size_t action_idx) const;
 
     /**
      * @brief Converts an agent block type index to a logical block type index.
@@ -97,6 +134,10 @@ class KArmedBanditAgent {
     std::vector<size_t> num_action_chosen_;    //Number of times each arm has been pulled (n)
     std::vector<float> q_;                     //Estimated value of each arm (Q)
     size_t last_action_;                       //type of the last action (move type) proposed
+    size_t batch_size_ = 1;                    //Number of moves between Q-table updates
+    size_t num_batch_moves_ = 0;               //Number of moves since the last Q-table update
+    std::vector<double> batch_reward_sum_;     //Sum of the rewards received by each arm since the last Q-table update
+    std::vector<size_t> num_batch_rewards_;    //Number of rewards received by each arm since the last Q-table update
     /* Ratios of the average runtime to calculate each move type              */
     /* These ratios are useful for different reward functions                 *
      * The vector is calculated by averaging many runs on different circuits  */
@@ -158,9 +199,13 @@ class EpsilonGreedyAgent : public KArmedBanditAgent {
      */
     void init_q_scores_();
 
+    ///@brief Caches the greedy action of the updated Q-table
+    void q_updated_() override;
+
   private:
     float epsilon_ = 0.1;                         //How often to perform a non-greedy exploration action
     std::vector<float> cumm_epsilon_action_prob_; //The accumulative probability of choosing each action
+    size_t greedy_action_ = 0;                    //The action with the highest estimated value, only kept up to date in batch mode
 };
 
 /**
@@ -204,6 +249,9 @@ class SoftmaxAgent : public KArmedBanditAgent {
      */
     void set_action_prob_();
 
+    ///@brief Recomputes the action probabilities from the updated Q-table
+    void q_updated_() override;
+
   private:
     std::vector<float> exp_q_;            //The clipped and scaled exponential of the estimated Q value for each action
     std::vector<float> action_prob_;      //The probability of choosing each action
@@ -252,6 +300,9 @@ class SimpleRLMoveGenerator : public MoveGenerator {
 
     // Receives feedback about the outcome of the previously proposed move
     void process_outcome(double reward, e_reward_function reward_fun) override;
+
+    void write_agent_state(std::ostream& os) override;
+    bool read_agent_state(std::istream& is) override;
 };
 
 template<class T, class>
@@ -5,8 +5,12 @@
 #include "grid_block.h"
 #include "vtr_assert.h"
 
+#include <algorithm>
+
 t_pl_blocks_to_be_moved::t_pl_blocks_to_be_moved(size_t max_blocks) {
     moved_blocks.reserve(max_blocks);
+    sorted_new_locs_.reserve(max_blocks);
+    emptied_locs_.reserve(max_blocks);
 }
 
 size_t t_pl_blocks_to_be_moved::get_size_and_increment() {
@@ -19,17 +23,18 @@ size_t t_pl_blocks_to_be_moved::get_size_and_increment() {
 e_block_move_result t_pl_blocks_to_be_moved::record_block_move(ClusterBlockId blk,
                                                                t_pl_loc to,
                                                                const BlkLocRegistry& blk_loc_registry) {
-    auto [to_it, to_success] = moved_to.emplace(to);
-    if (!to_success) {
+    if (loc_mark_offsets_.empty()) {
+        init_loc_marks(blk_loc_registry.grid_blocks());
+    }
+
+    if (is_moved_to(to)) {
         move_abortion_logger.log_move_abort("duplicate block move to location");
         return e_block_move_result::ABORT;
     }
 
     t_pl_loc from = blk_loc_registry.block_locs()[blk].loc;
 
-    auto [_, from_success] = moved_from.emplace(from);
-    if (!from_success) {
-        moved_to.erase(to_it);
+    if (is_moved_from(from)) {
         move_abortion_logger.log_move_abort("duplicate block move from location");
         return e_block_move_result::ABORT;
     }
@@ -42,35 +47,100 @@ e_block_move_result t_pl_blocks_to_be_moved::record_block_move(ClusterBlockId bl
     moved_blocks[imoved_blk].old_loc = from;
     moved_blocks[imoved_blk].new_loc = to;
 
+    if (num_marked_blocks_ + 1 == moved_blocks.size()) {
+        moved_from_marks_[loc_mark_index(from)] = move_epoch_;
+        moved_to_marks_[loc_mark_index(to)] = move_epoch_;
+        num_marked_blocks_++;
+    }
+
     return e_block_move_result::VALID;
 }
 
 //Examines the currently proposed move and determine any empty locations
-std::set<t_pl_loc> t_pl_blocks_to_be_moved::determine_locations_emptied_by_move() {
-    std::set<t_pl_loc> moved_from_set;
-    std::set<t_pl_loc> moved_to_set;
+const std::vector<t_pl_loc>& t_pl_blocks_to_be_moved::determine_locations_emptied_by_move() {
+    sorted_new_locs_.clear();
+    emptied_locs_.clear();
+
+    for (const t_pl_moved_block& moved_block : moved_blocks) {
+        //Any block moved to a position fills it
+        sorted_new_locs_.push_back(moved_block.new_loc);
+    }
+    std::sort(sorted_new_locs_.begin(), sorted_new_locs_.end());
 
     for (const t_pl_moved_block& moved_block : moved_blocks) {
         //When a block is moved its old location becomes free
-        moved_from_set.emplace(moved_block.old_loc);
+        if (!std::binary_search(sorted_new_locs_.begin(), sorted_new_locs_.end(), moved_block.old_loc)) {
+            emptied_locs_.push_back(moved_block.old_loc);
+        }
+    }
+
+    //Old locations are unique, so only the order needs fixing
+    std::sort(emptied_locs_.begin(), emptied_locs_.end());
+
+    return emptied_locs_;
+}
 
-        //But any block later moved to a position fills it
-        moved_to_set.emplace(moved_block.new_loc);
+bool t_pl_blocks_to_be_moved::is_moved_from(const t_pl_loc& loc) const {
+    return is_moved(loc, /*moved_from=*/true);
+}
+
+bool t_pl_blocks_to_be_moved::is_moved_to(const t_pl_loc& loc) const {
+    return is_moved(loc, /*moved_from=*/false);
+}
+
+bool t_pl_blocks_to_be_moved::is_moved(const t_pl_loc& loc, bool moved_from) const {
+    //Blocks filled into moved_blocks directly, rather than by record_block_move(), are not marked
+    if (num_marked_blocks_ != moved_blocks.size()) {
+        return std::any_of(moved_blocks.begin(), moved_blocks.end(), [&](const t_pl_moved_block& moved_block) {
+            return (moved_from ? moved_block.old_loc : moved_block.new_loc) == loc;
+        });
     }
 
-    std::set<t_pl_loc> empty_locs;
-    std::set_difference(moved_from_set.begin(), moved_from_set.end(),
-                        moved_to_set.begin(), moved_to_set.end(),
-                        std::inserter(empty_locs, empty_locs.begin()));
+    //Nothing is marked before the first recorded move
+    if (num_marked_blocks_ == 0) {
+        return false;
+    }
 
-    return empty_locs;
+    const std::vector<uint32_t>& marks = moved_from ? moved_from_marks_ : moved_to_marks_;
+    return marks[loc_mark_index(loc)] == move_epoch_;
+}
+
+void t_pl_blocks_to_be_moved::init_loc_marks(const GridBlock& grid_blocks) {
+    grid_width_ = grid_blocks.width();
+    grid_height_ = grid_blocks.height();
+    size_t num_layers = grid_blocks.num_layers();
+
+    loc_mark_offsets_.resize(num_layers * grid_width_ * grid_height_);
+    size_t num_sub_tiles = 0;
+    for (size_t layer = 0; layer < num_layers; layer++) {
+        for (size_t x = 0; x < grid_width_; x++) {
+            for (size_t y = 0; y < grid_height_; y++) {
+                loc_mark_offsets_[(layer * grid_width_ + x) * grid_height_ + y] = num_sub_tiles;
+                num_sub_tiles += grid_blocks.num_blocks_at_location({(int)x, (int)y, (int)layer});
+            }
+        }
+    }
+
+    moved_from_marks_.assign(num_sub_tiles, 0);
+    moved_to_marks_.assign(num_sub_tiles, 0);
+}
+
+size_t t_pl_blocks_to_be_moved::loc_mark_index(const t_pl_loc& loc) const {
+    size_t index = loc_mark_offsets_[(size_t(loc.layer) * grid_width_ + loc.x) * grid_height_ + loc.y] + loc.sub_tile;
+    VTR_ASSERT_SAFE(index < moved_from_marks_.size());
+    return index;
 }
 
 //Clears the current move so a new move can be proposed
 void t_pl_blocks_to_be_moved::clear_move_blocks() {
-    //Reset moved flags
-    moved_to.clear();
-    moved_from.clear();
+    //Unmark all the moved from/to locations by starting a new epoch. The
+    //marks are only reset when the epoch wraps around.
+    if (++move_epoch_ == 0) {
+        std::fill(moved_from_marks_.begin(), moved_from_marks_.end(), 0);
+        std::fill(moved_to_marks_.begin(), moved_to_marks_.end(), 0);
+        move_epoch_ = 1;
+    }
+    num_marked_blocks_ = 0;
 
     //For run-time, we just reset size of blocks_affected.moved_blocks to zero, but do not free the blocks_affected
     //array to avoid memory allocation
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "vpr_types.h"
 
 class BlkLocRegistry;
@@ -52,7 +54,10 @@ class MoveAbortionLogger {
  *               [0...max_blocks-1]                       *
  * affected_pins: pins affected by this move (used to           *
  *                incrementally invalidate parts of the timing  *
- *                graph.                                        */
+ *                graph.                                        *
+ *
+ * All the storage is reserved up front, so proposing, recording and    *
+ * clearing a move does not allocate memory.                            */
 struct t_pl_blocks_to_be_moved {
     explicit t_pl_blocks_to_be_moved(size_t max_blocks);
     t_pl_blocks_to_be_moved() = delete;
@@ -83,13 +88,53 @@ struct t_pl_blocks_to_be_moved {
                                           t_pl_loc to,
                                           const BlkLocRegistry& blk_loc_registry);
 
-    std::set<t_pl_loc> determine_locations_emptied_by_move();
+    /**
+     * @brief Returns the locations left empty by the currently recorded moves,
+     * i.e. the old locations no block is moved to, in ascending order.
+     *
+     * The returned reference is valid until the next call to this function.
+     */
+    const std::vector<t_pl_loc>& determine_locations_emptied_by_move();
+
+    /// @brief Returns true if a block is moved from loc by the current move.
+    bool is_moved_from(const t_pl_loc& loc) const;
+
+    /// @brief Returns true if a block is moved to loc by the current move.
+    bool is_moved_to(const t_pl_loc& loc) const;
 
     std::vector<t_pl_moved_block> moved_blocks;
-    std::unordered_set<t_pl_loc> moved_from;
-    std::unordered_set<t_pl_loc> moved_to;
 
     std::vector<ClusterPinId> affected_pins;
 
     MoveAbortionLogger move_abortion_logger;
+
+  private:
+    /// @brief Sizes the location marks for the grid of grid_blocks.
+    void init_loc_marks(const GridBlock& grid_blocks);
+
+    /// @brief Returns the index of loc in moved_from_marks_/moved_to_marks_.
+    size_t loc_mark_index(const t_pl_loc& loc) const;
+
+    /// @brief Returns true if loc is the old (moved_from) or new location of one of moved_blocks.
+    bool is_moved(const t_pl_loc& loc, bool moved_from) const;
+
+    /* The moved from/to locations of the current move are marked with the    *
+     * current move_epoch_ in these arrays, which have an entry per sub-tile   *
+     * of the grid. Clearing a move only increments the epoch, so recording a  *
+     * block move and looking up a location take constant time however many   *
+     * blocks are moved. The arrays are sized for the grid of the first block  *
+     * location registry a move is recorded with.                              */
+    std::vector<uint32_t> moved_from_marks_;
+    std::vector<uint32_t> moved_to_marks_;
+    uint32_t move_epoch_ = 1;
+    ///@brief Index of the first sub-tile of each [layer][x][y] grid location in the mark arrays
+    std::vector<size_t> loc_mark_offsets_;
+    size_t grid_width_ = 0;
+    size_t grid_height_ = 0;
+    ///@brief Number of leading moved_blocks which are marked, the others are looked up by scanning
+    size_t num_marked_blocks_ = 0;
+
+    ///@brief Scratch storage of determine_locations_emptied_by_move()
+    std::vector<t_pl_loc> sorted_new_locs_;
+    std::vector<t_pl_loc> emptied_locs_;
 };
@@ -16,24 +16,6 @@
 //Note: The flag is only effective if compiled with VTR_ENABLE_DEBUG_LOGGING
 bool f_placer_breakpoint_reached = false;
 
-/**
- * @brief Adjust the search range based on how many blocks are in the column.
- * If the number of blocks in the column is less than MIN_NUM_BLOCKS_IN_COLUMN,
- * expand the search range to cover the entire column.
- * 
- * @param block_type The type of the block to move
- * @param compressed_column_num The compressed column to move the block to
- * @param to_layer_num The layer that the block is moving to
- * @param is_range_fixed Whether the search range is fixed (e.g., in case of placement constraints)
- * @param search_range The search range to adjust
- * 
- */
-static void adjust_search_range(t_logical_block_type_ptr block_type,
-                                const int compressed_column_num,
-                                const int to_layer_num,
-                                const bool is_range_fixed,
-                                t_bb& search_range);
-
 //Accessor for f_placer_breakpoint_reached
 bool placer_breakpoint_reached() {
     return f_placer_breakpoint_reached;
@@ -458,7 +440,7 @@ e_block_move_result record_macro_self_swaps(t_pl_blocks_to_be_moved& blocks_affe
     std::copy_if(displaced_blocks.begin(), displaced_blocks.end(), std::back_inserter(non_macro_displaced_blocks), is_non_macro_block);
 
     //Based on the currently queued block moves, find the empty 'holes' left behind
-    auto empty_locs = blocks_affected.determine_locations_emptied_by_move();
+    const auto& empty_locs = blocks_affected.determine_locations_emptied_by_move();
 
     VTR_ASSERT_SAFE(empty_locs.size() >= non_macro_displaced_blocks.size());
 
@@ -682,14 +664,11 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
     t_bb search_range = get_compressed_grid_target_search_range(compressed_block_grid,
                                                                 compressed_locs[to_layer_num],
                                                                 rlim);
-    int delta_cx = search_range.xmax - search_range.xmin;
-
     bool block_constrained = is_cluster_constrained(b_from);
 
     if (block_constrained) {
         bool intersect = intersect_range_limit_with_floorplan_constraints(b_from,
                                                                           search_range,
-                                                                          delta_cx,
                                                                           to_layer_num);
         if (!intersect) {
             return false;
@@ -700,11 +679,9 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
     bool legal = false;
     //TODO: For now, we only move the blocks on the same tile
     legal = find_compatible_compressed_loc_in_range(type,
-                                                    delta_cx,
                                                     compressed_locs[to_layer_num],
                                                     search_range,
                                                     to_compressed_loc,
-                                                    /*is_median=*/false,
                                                     to_layer_num,
                                                     /*search_for_empty=*/false,
                                                     blk_loc_registry,
@@ -766,7 +743,6 @@ bool find_to_loc_median(t_logical_block_type_ptr blk_type,
     VTR_ASSERT(min_compressed_loc[to_layer_num].x >= 0);
     VTR_ASSERT(static_cast<int>(compressed_block_grid.get_num_columns(to_layer_num)) - 1 - max_compressed_loc[to_layer_num].x >= 0);
     VTR_ASSERT(max_compressed_loc[to_layer_num].x >= min_compressed_loc[to_layer_num].x);
-    int delta_cx = max_compressed_loc[to_layer_num].x - min_compressed_loc[to_layer_num].x;
 
     VTR_ASSERT(min_compressed_loc[to_layer_num].y >= 0);
     VTR_ASSERT(static_cast<int>(compressed_block_grid.get_num_rows(to_layer_num)) - 1 - max_compressed_loc[to_layer_num].y >= 0);
@@ -784,7 +760,6 @@ bool find_to_loc_median(t_logical_block_type_ptr blk_type,
     if (block_constrained) {
         bool intersect = intersect_range_limit_with_floorplan_constraints(b_from,
                                                                           search_range,
-                                                                          delta_cx,
                                                                           to_layer_num);
         if (!intersect) {
             return false;
@@ -794,11 +769,9 @@ bool find_to_loc_median(t_logical_block_type_ptr blk_type,
     t_physical_tile_loc to_compressed_loc;
     bool legal = false;
     legal = find_compatible_compressed_loc_in_range(blk_type,
-                                                    delta_cx,
                                                     from_compressed_locs[to_layer_num],
                                                     search_range,
                                                     to_compressed_loc,
-                                                    /*is_median=*/true,
                                                     to_layer_num,
                                                     /*search_for_empty=*/false,
                                                     blk_loc_registry,
@@ -863,7 +836,6 @@ bool find_to_loc_centroid(t_logical_block_type_ptr blk_type,
     }
 
     //Determine the valid compressed grid location ranges
-    int delta_cx;
     t_bb search_range;
 
     // If we are early in the anneal and the range limit still big enough --> search around the center location that the move proposed
@@ -878,14 +850,12 @@ bool find_to_loc_centroid(t_logical_block_type_ptr blk_type,
                                                                 compressed_loc_on_layer,
                                                                 std::min<float>(range_limiters.original_rlim, range_limiters.dm_rlim));
     }
-    delta_cx = search_range.xmax - search_range.xmin;
 
     bool block_constrained = is_cluster_constrained(b_from);
 
     if (block_constrained) {
         bool intersect = intersect_range_limit_with_floorplan_constraints(b_from,
                                                                           search_range,
-                                                                          delta_cx,
                                                                           to_layer_num);
         if (!intersect) {
             return false;
@@ -897,11 +867,9 @@ bool find_to_loc_centroid(t_logical_block_type_ptr blk_type,
 
     //TODO: For now, we only move the blocks on the same layer
     legal = find_compatible_compressed_loc_in_range(blk_type,
-                                                    delta_cx,
                                                     from_compressed_loc[to_layer_num],
                                                     search_range,
                                                     to_compressed_loc,
-                                                    /*is_median=*/false,
                                                     to_layer_num,
                                                     /*search_for_empty=*/false,
                                                     blk_loc_registry,
@@ -992,11 +960,9 @@ int find_empty_compatible_subtile(t_logical_block_type_ptr type,
 }
 
 bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
-                                             const int delta_cx,
                                              const t_physical_tile_loc& from_loc,
-                                             t_bb search_range,
+                                             const t_bb& search_range,
                                              t_physical_tile_loc& to_loc,
-                                             bool is_median,
                                              int to_layer_num,
                                              bool search_for_empty,
                                              const BlkLocRegistry& blk_loc_registry,
@@ -1005,84 +971,34 @@ bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
     //TODO For the time being, the blocks only moved in the same layer. This assertion should be removed after VPR is updated to move blocks between layers
     VTR_ASSERT(to_layer_num == from_loc.layer_num);
     const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[type->index];
-    to_loc.layer_num = to_layer_num;
-    std::unordered_set<int> tried_cx_to;
-    bool legal = false;
-    int possibilities;
-    if (is_median)
-        possibilities = delta_cx + 1;
-    else
-        possibilities = delta_cx;
-
-    while (!legal && (int)tried_cx_to.size() < possibilities) { //Until legal or all possibilities exhausted
-        //Pick a random x-location within [min_cx, max_cx],
-        //until we find a legal swap, or have exhausted all possibilities
-        to_loc.x = search_range.xmin + rng.irand(delta_cx);
-
-        VTR_ASSERT(to_loc.x >= search_range.xmin);
-        VTR_ASSERT(to_loc.x <= search_range.xmax);
-
-        //Record this x location as tried
-        auto res = tried_cx_to.insert(to_loc.x);
-        if (!res.second) {
-            continue; //Already tried this position
-        }
 
-        //Pick a random y location
-        //
-        //We are careful here to consider that there may be a sparse
-        //set of candidate blocks in the y-axis at this x location.
-        //
-        //The candidates are stored in a flat_map so we can efficiently find the set of valid
-        //candidates with upper/lower bound.
-        const auto& block_rows = compressed_block_grid.get_column_block_map(to_loc.x, to_layer_num);
-        adjust_search_range(type,
-                            to_loc.x,
-                            to_layer_num,
-                            is_range_fixed,
-                            search_range);
-        auto y_lower_iter = block_rows.lower_bound(search_range.ymin);
-        if (y_lower_iter == block_rows.end()) {
-            continue;
+    //Sparse columns (e.g. blocks on the perimeter of the FPGA, such as IO blocks) are searched
+    //entirely unless the search range is fixed
+    const bool expand_sparse_columns = !is_range_fixed;
+
+    //Count the candidate locations in range, leaving out the location the block moves from
+    const int num_locs = compressed_block_grid.num_locs_in_range(search_range, search_range.xmax, to_layer_num, expand_sparse_columns);
+    const int from_index = compressed_block_grid.loc_index_in_range(search_range, from_loc, expand_sparse_columns);
+    const int num_candidates = (from_index == UNDEFINED) ? num_locs : num_locs - 1;
+
+    //Pick a random candidate. If it must be empty, go through the next candidates until
+    //one has an empty sub-tile or all of them have been tried.
+    const int first_candidate = (num_candidates > 0) ? rng.irand(num_candidates - 1) : 0;
+    for (int icandidate = 0; icandidate < num_candidates; icandidate++) {
+        int index = (first_candidate + icandidate) % num_candidates;
+        if (from_index != UNDEFINED && index >= from_index) {
+            index++;
         }
-        auto y_upper_iter = block_rows.upper_bound(search_range.ymax);
-
-        int y_range = std::distance(y_lower_iter, y_upper_iter);
-        VTR_ASSERT(y_range >= 0);
-
-        //At this point we know y_lower_iter and y_upper_iter
-        //bound the range of valid blocks at this x-location, which
-        //are within rlim_y
-        std::unordered_set<int> tried_dy;
-        while (!legal && (int)tried_dy.size() < y_range) { //Until legal or all possibilities exhausted
-            //Randomly pick a y location
-            int dy = rng.irand(y_range - 1);
-
-            //Record this y location as tried
-            auto res2 = tried_dy.insert(dy);
-            if (!res2.second) {
-                continue; //Already tried this position
-            }
 
-            //Key in the y-dimension is the compressed index location
-            to_loc.y = (y_lower_iter + dy)->first;
+        to_loc = compressed_block_grid.loc_in_range(search_range, index, to_layer_num, expand_sparse_columns);
 
-            VTR_ASSERT(to_loc.y >= search_range.ymin);
-            VTR_ASSERT(to_loc.y <= search_range.ymax);
-
-            if (from_loc.x == to_loc.x && from_loc.y == to_loc.y && from_loc.layer_num == to_layer_num) {
-                continue;                  //Same from/to location -- try again for new y-position
-            } else if (search_for_empty) { // Check if the location has at least one empty sub-tile
-                legal = find_empty_compatible_subtile(type, to_loc, blk_loc_registry.grid_blocks(), rng) >= 0;
-            } else {
-                legal = true;
-            }
+        if (!search_for_empty || find_empty_compatible_subtile(type, to_loc, blk_loc_registry.grid_blocks(), rng) >= 0) {
+            return true;
         }
     }
-    if (!legal) {
-        VTR_LOGV_DEBUG(g_vpr_ctx.placement().f_placer_debug, "\tCouldn't find any legal position in the given search range\n");
-    }
-    return legal;
+
+    VTR_LOGV_DEBUG(g_vpr_ctx.placement().f_placer_debug, "\tCouldn't find any legal position in the given search range\n");
+    return false;
 }
 
 std::vector<t_physical_tile_loc> get_compressed_loc(const t_compressed_block_grid& compressed_block_grid,
@@ -1181,7 +1097,6 @@ t_bb get_compressed_grid_bounded_search_range(const t_compressed_block_grid& com
 
 bool intersect_range_limit_with_floorplan_constraints(ClusterBlockId b_from,
                                                       t_bb& search_range,
-                                                      int& delta_cx,
                                                       int layer_num) {
     const auto& floorplanning_ctx = g_vpr_ctx.floorplanning();
 
@@ -1214,7 +1129,6 @@ bool intersect_range_limit_with_floorplan_constraints(ClusterBlockId b_from,
             const auto [layer_low, layer_high] = compressed_intersect_reg.get_layer_range();
             VTR_ASSERT(layer_low == layer_num && layer_high == layer_num);
 
-            delta_cx = intersect_rect.xmax() - intersect_rect.xmin();
             std::tie(search_range.xmin, search_range.ymin,
                      search_range.xmax, search_range.ymax) = intersect_rect.coordinates();
             search_range.layer_min = layer_low;
@@ -1225,24 +1139,6 @@ bool intersect_range_limit_with_floorplan_constraints(ClusterBlockId b_from,
     return true;
 }
 
-static void adjust_search_range(t_logical_block_type_ptr block_type,
-                                const int compressed_column_num,
-                                const int to_layer_num,
-                                const bool is_range_fixed,
-                                t_bb& search_range) {
-    // The value is chosen empirically to expand the search range for sparse blocks,
-    // or blocks located on the perimeter of the FPGA (e.g., IO blocks)
-    constexpr int MIN_NUM_BLOCKS_IN_COLUMN = 3;
-
-    const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[block_type->index];
-
-    size_t num_blocks_in_column = compressed_block_grid.get_column_block_map(compressed_column_num, to_layer_num).size();
-
-    if (num_blocks_in_column < MIN_NUM_BLOCKS_IN_COLUMN && !is_range_fixed) {
-        search_range.ymin = 0;
-        search_range.ymax = compressed_block_grid.get_num_rows(to_layer_num) - 1;
-    }
-}
 
 std::string e_move_result_to_string(e_move_result move_outcome) {
     switch (move_outcome) {
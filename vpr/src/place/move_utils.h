@@ -319,22 +319,22 @@ int find_empty_compatible_subtile(t_logical_block_type_ptr type,
 
 /**
  * @brief find compressed location in a compressed range for a specific type in the given layer (to_layer_num)
+ *
+ * A location is picked uniformly at random among the compatible locations in range, using the
+ * location counts of the compressed grid, so no probing of empty parts of the range is needed.
  * 
  * type: defines the moving block type
  * search_range: the minimum and maximum coordinates of the search range in the compressed grid
  * from_loc: the coordinates of the old location
  * to_loc: the coordinates of the new location on the compressed grid
- * is_median: true if this is called from find_to_loc_median
  * to_layer_num: the layer number of the new location (set by the caller)
  * search_for_empty: indicates that the returned location must be empty
  * is_range_fixed: indicates that the search range is fixed and should not be adjusted
  */
 bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
-                                             int delta_cx,
                                              const t_physical_tile_loc& from_loc,
-                                             t_bb search_range,
+                                             const t_bb& search_range,
                                              t_physical_tile_loc& to_loc,
-                                             bool is_median,
                                              int to_layer_num,
                                              bool search_for_empty,
                                              const BlkLocRegistry& blk_loc_registry,
@@ -418,7 +418,6 @@ t_bb get_compressed_grid_bounded_search_range(const t_compressed_block_grid& com
  */
 bool intersect_range_limit_with_floorplan_constraints(ClusterBlockId b_from,
                                                       t_bb& search_range,
-                                                      int& delta_cx,
                                                       int layer_num);
 
 std::string e_move_result_to_string(e_move_result move_outcome);
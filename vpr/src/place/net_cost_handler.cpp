@@ -375,9 +375,10 @@ void NetCostHandler::update_td_delta_costs_(const PlaceDelayModel* delay_model,
 
     if (cluster_ctx.clb_nlist.pin_type(pin) == PinType::DRIVER) {
         /* This pin is a net driver on a moved block. */
-        /* Recompute all point to point connection delays for the net sinks. */
+        /* Recompute all point to point connection delays for the net sinks in one batch. */
+        comp_td_net_connection_delays(delay_model, block_locs, net, ts_delay_batch_);
         for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net).size(); ipin++) {
-            float temp_delay = comp_td_single_connection_delay(delay_model, block_locs, net, ipin);
+            float temp_delay = ts_delay_batch_.delays[ipin - 1];
             /* If the delay hasn't changed, do not mark this pin as affected */
             if (temp_delay == connection_delay[net][ipin]) {
                 continue;
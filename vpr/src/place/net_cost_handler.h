@@ -194,6 +194,8 @@ class NetCostHandler {
     vtr::Matrix<int> ts_layer_sink_pin_count_;
     /* [0...num_affected_nets] -> net_id of the affected nets */
     std::vector<ClusterNetId> ts_nets_to_update_;
+    /* Scratch storage for looking up the delays of all the sink connections of a net whose driver moved */
+    t_place_delay_batch ts_delay_batch_;
 
     // [0..cluster_ctx.clb_nlist.nets().size()-1]. Store the number of blocks on each of a net's bounding box (to allow efficient updates)
     vtr::vector<ClusterNetId, t_bb> bb_num_on_edges_;
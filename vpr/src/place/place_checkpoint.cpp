@@ -13,29 +13,28 @@ double t_placement_checkpoint::get_cp_bb_cost() const { return costs_.bb_cost; }
 
 bool t_placement_checkpoint::cp_is_valid() const { return valid_; }
 
-void t_placement_checkpoint::save_placement(const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
+void t_placement_checkpoint::save_placement(BlkLocRegistry& blk_loc_registry,
                                             const t_placer_costs& placement_costs,
                                             const float critical_path_delay) {
-    block_locs_ = block_locs;
+    blk_loc_registry.start_move_journal();
     valid_ = true;
     cpd_ = critical_path_delay;
     costs_ = placement_costs;
 }
 
-t_placer_costs t_placement_checkpoint::restore_placement(vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
-                                                         GridBlock& grid_blocks) {
-    block_locs = block_locs_;
-    grid_blocks.load_from_block_locs(block_locs);
+t_placer_costs t_placement_checkpoint::restore_placement(BlkLocRegistry& blk_loc_registry) {
+    VTR_ASSERT(valid_ && blk_loc_registry.move_journal_active());
+    blk_loc_registry.rollback_move_journal();
     return costs_;
 }
 
-void save_placement_checkpoint_if_needed(const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
+void save_placement_checkpoint_if_needed(BlkLocRegistry& blk_loc_registry,
                                          t_placement_checkpoint& placement_checkpoint,
                                          const std::shared_ptr<SetupTimingInfo>& timing_info,
                                          t_placer_costs& costs,
                                          float cpd) {
     if (!placement_checkpoint.cp_is_valid() || (timing_info->least_slack_critical_path().delay() < placement_checkpoint.get_cp_cpd() && costs.bb_cost <= placement_checkpoint.get_cp_bb_cost())) {
-        placement_checkpoint.save_placement(block_locs, costs, cpd);
+        placement_checkpoint.save_placement(blk_loc_registry, costs, cpd);
         VTR_LOG("Checkpoint saved: bb_costs=%g, TD costs=%g, CPD=%7.3f (ns) \n", costs.bb_cost, costs.timing_cost, 1e9 * cpd);
     }
 }
@@ -58,7 +57,7 @@ void restore_best_placement(PlacerState& placer_state,
     if (placement_checkpoint.cp_is_valid() && timing_info->least_slack_critical_path().delay() > placement_checkpoint.get_cp_cpd() && costs.bb_cost * 1.05 > placement_checkpoint.get_cp_bb_cost()) {
         //restore the latest placement checkpoint
 
-        costs = placement_checkpoint.restore_placement(placer_state.mutable_block_locs(), placer_state.mutable_grid_blocks());
+        costs = placement_checkpoint.restore_placement(placer_state.mutable_blk_loc_registry());
 
         //recompute timing from scratch
         placer_criticalities.get()->set_recompute_required();
@@ -85,4 +84,7 @@ void restore_best_placement(PlacerState& placer_state,
 
         VTR_LOG("\nCheckpoint restored\n");
     }
+
+    // No more checkpoints will be restored, so stop tracking block moves
+    placer_state.mutable_blk_loc_registry().stop_move_journal();
 }
@@ -8,6 +8,7 @@
 #include "place_delay_model.h"
 #include "place_timing_update.h"
 
+class BlkLocRegistry;
 class NocCostHandler;
 
 /**
@@ -15,37 +16,41 @@ class NocCostHandler;
  *
  * The placement checkpoints are very useful to solve the problem of critical 
  * delay oscillations, especially very late in the annealer.
- *   @param block_locs_ saves the location of each block
+ *
+ * Rather than copying the location of every block, the checkpoint relies on the
+ * move journal of the BlkLocRegistry, which records the blocks moved since the
+ * checkpoint was saved. Saving and restoring a checkpoint therefore takes time
+ * proportional to the number of blocks moved in between.
+ *
  *   @param cpd_ Saves the critical path delay of the current checkpoint
  *   @param valid_ a flag to show whether the current checkpoint is initialized or not
  *   @param costs_ The weighted average of the wiring cost and the timing cost.
  */
 class t_placement_checkpoint {
   private:
-    vtr::vector_map<ClusterBlockId, t_block_loc> block_locs_;
     float cpd_;
     bool valid_ = false;
     t_placer_costs costs_;
 
   public:
     /**
-     * @brief Saves the given block locations and their corresponding placement cost and CPD
-     * @param block_locs The block locations to be saved.
+     * @brief Saves the current placement and its corresponding placement cost and CPD
+     * @param blk_loc_registry The placement to be saved. Its move journal is (re)started
+     * to track the block moves made after this checkpoint.
      * @param placement_costs Different cost terms associated with the given placement.
      * @param critical_path_delay The critical path delay associated with the given placement.
      */
-    void save_placement(const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
+    void save_placement(BlkLocRegistry& blk_loc_registry,
                         const t_placer_costs& placement_costs,
                         const float critical_path_delay);
 
     /**
-     * @brief Restores the placement solution saved in the checkpoint and update the placement context accordingly
-     * @param block_locs To be filled with the saved placement.
-     * @param grid_blocks To be filled with grid location to clustered block mapping of the saved placement.
+     * @brief Restores the placement solution saved in the checkpoint by undoing the block
+     * moves made since the checkpoint was saved.
+     * @param blk_loc_registry The placement to be restored (block locations and grid blocks).
      * @return Different cost terms associated with the saved placement.
      */
-    t_placer_costs restore_placement(vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
-                                     GridBlock& grid_blocks);
+    t_placer_costs restore_placement(BlkLocRegistry& blk_loc_registry);
 
     //return the critical path delay of the saved checkpoint
     float get_cp_cpd() const;
@@ -58,13 +63,13 @@ class t_placement_checkpoint {
 };
 
 //save placement checkpoint if checkpointing is enabled and checkpoint conditions occurred
-void save_placement_checkpoint_if_needed(const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
+void save_placement_checkpoint_if_needed(BlkLocRegistry& blk_loc_registry,
                                          t_placement_checkpoint& placement_checkpoint,
                                          const std::shared_ptr<SetupTimingInfo>& timing_info,
                                          t_placer_costs& costs,
                                          float cpd);
 
-//restore the checkpoint if it's better than the latest placement solution
+//restore the checkpoint if it's better than the latest placement solution, and stop tracking block moves
 void restore_best_placement(PlacerState& placer_state,
                             t_placement_checkpoint& placement_checkpoint,
                             std::shared_ptr<SetupTimingInfo>& timing_info,
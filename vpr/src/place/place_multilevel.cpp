@@ -0,0 +1,134 @@
+#include "place_multilevel.h"
+
+#include <utility>
+
+#include "clustered_netlist.h"
+#include "vpr_types.h"
+
+/// Nets with more pins than this barely constrain where their blocks go, so they are not used to pick the groups to merge
+static constexpr size_t COARSEN_MAX_NET_PINS = 64;
+
+/// Coarsening stops once a new level would keep more than this fraction of the groups of the previous level
+static constexpr float COARSEN_MIN_GROUP_REDUCTION = 0.9f;
+
+/**
+ * @brief Builds the next coarser level by merging each group of prev_level with its
+ *        most strongly connected unmatched neighbouring group of the same logical type.
+ */
+static t_place_coarse_level coarsen_level(const ClusteredNetlist& clb_nlist,
+                                          const t_place_coarse_level& prev_level);
+
+static t_place_coarse_level coarsen_level(const ClusteredNetlist& clb_nlist,
+                                          const t_place_coarse_level& prev_level) {
+    const size_t num_prev_groups = prev_level.groups.size();
+
+    t_place_coarse_level level;
+    level.block_group.resize(prev_level.block_group.size(), UNDEFINED);
+
+    std::vector<bool> is_matched(num_prev_groups, false);
+    // Connection weights from the group being matched to its unmatched neighbouring groups
+    std::vector<float> neighbour_weights(num_prev_groups, 0.f);
+    std::vector<int> neighbours;
+
+    for (size_t igroup = 0; igroup < num_prev_groups; igroup++) {
+        if (is_matched[igroup]) {
+            continue;
+        }
+        is_matched[igroup] = true;
+
+        const std::vector<ClusterBlockId>& group = prev_level.groups[igroup];
+        const t_logical_block_type_ptr group_type = clb_nlist.block_type(group[0]);
+
+        // A net with n pins adds 1/(n-1) for each of its other pins, as in the clique net model
+        for (ClusterBlockId blk : group) {
+            for (ClusterPinId pin : clb_nlist.block_pins(blk)) {
+                ClusterNetId net = clb_nlist.pin_net(pin);
+                if (!net || clb_nlist.net_is_ignored(net)) {
+                    continue;
+                }
+
+                const size_t num_net_pins = clb_nlist.net_pins(net).size();
+                if (num_net_pins < 2 || num_net_pins > COARSEN_MAX_NET_PINS) {
+                    continue;
+                }
+
+                const float weight = 1.f / (num_net_pins - 1);
+                for (ClusterPinId net_pin : clb_nlist.net_pins(net)) {
+                    const int ineighbour = prev_level.block_group[clb_nlist.pin_block(net_pin)];
+                    if (ineighbour == UNDEFINED || is_matched[ineighbour]
+                        || clb_nlist.block_type(prev_level.groups[ineighbour][0]) != group_type) {
+                        continue;
+                    }
+
+                    if (neighbour_weights[ineighbour] == 0.f) {
+                        neighbours.push_back(ineighbour);
+                    }
+                    neighbour_weights[ineighbour] += weight;
+                }
+            }
+        }
+
+        // Normalize by the merged size so that small groups are merged first and the group sizes stay balanced
+        int best_neighbour = UNDEFINED;
+        float best_score = 0.f;
+        for (int ineighbour : neighbours) {
+            const float score = neighbour_weights[ineighbour] / (group.size() + prev_level.groups[ineighbour].size());
+            if (best_neighbour == UNDEFINED || score > best_score || (score == best_score && ineighbour < best_neighbour)) {
+                best_neighbour = ineighbour;
+                best_score = score;
+            }
+            neighbour_weights[ineighbour] = 0.f;
+        }
+        neighbours.clear();
+
+        std::vector<ClusterBlockId> new_group = group;
+        if (best_neighbour != UNDEFINED) {
+            is_matched[best_neighbour] = true;
+            const std::vector<ClusterBlockId>& neighbour_group = prev_level.groups[best_neighbour];
+            new_group.insert(new_group.end(), neighbour_group.begin(), neighbour_group.end());
+        }
+
+        const int inew_group = (int)level.groups.size();
+        for (ClusterBlockId blk : new_group) {
+            level.block_group[blk] = inew_group;
+        }
+        level.groups.push_back(std::move(new_group));
+    }
+
+    return level;
+}
+
+std::vector<t_place_coarse_level> coarsen_placement_netlist(const ClusteredNetlist& clb_nlist,
+                                                            const vtr::vector_map<ClusterBlockId, bool>& is_movable,
+                                                            int max_num_levels) {
+    std::vector<t_place_coarse_level> levels;
+    if (max_num_levels <= 0) {
+        return levels;
+    }
+    // prev_level points into levels, so it must never be reallocated
+    levels.reserve(max_num_levels);
+
+    // The flat netlist, where every movable block is a group on its own
+    t_place_coarse_level flat_level;
+    flat_level.block_group.resize(clb_nlist.blocks().size(), UNDEFINED);
+    for (ClusterBlockId blk : clb_nlist.blocks()) {
+        if (is_movable[blk]) {
+            flat_level.block_group[blk] = (int)flat_level.groups.size();
+            flat_level.groups.push_back({blk});
+        }
+    }
+
+    const t_place_coarse_level* prev_level = &flat_level;
+    while ((int)levels.size() < max_num_levels) {
+        t_place_coarse_level level = coarsen_level(clb_nlist, *prev_level);
+
+        if (level.groups.size() >= COARSEN_MIN_GROUP_REDUCTION * prev_level->groups.size()) {
+            break;
+        }
+
+        levels.push_back(std::move(level));
+        prev_level = &levels.back();
+    }
+
+    return levels;
+}
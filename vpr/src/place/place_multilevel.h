@@ -0,0 +1,44 @@
+#pragma once
+/**
+ * @file place_multilevel.h
+ * @brief Connectivity based coarsening of the clustered netlist for multilevel
+ *        annealing placement.
+ *
+ * A coarse level partitions the movable clustered blocks into groups of strongly
+ * connected blocks of the same logical type. The annealer places a coarse level by
+ * translating whole groups (see GroupMoveGenerator), so the connections inside a
+ * group keep their length and far fewer moves are needed to reach a good global
+ * arrangement than when annealing the flat netlist. Each level is built from the
+ * previous one by merging pairs of strongly connected groups (heavy-edge matching).
+ */
+
+#include <vector>
+
+#include "clustered_netlist_fwd.h"
+#include "vtr_vector_map.h"
+
+class ClusteredNetlist;
+
+struct t_place_coarse_level {
+    ///@brief The blocks of each group. The first block of a group is its anchor.
+    std::vector<std::vector<ClusterBlockId>> groups;
+    ///@brief The group of each block, or UNDEFINED if the block is not moved at this level (e.g. fixed blocks).
+    vtr::vector_map<ClusterBlockId, int> block_group;
+};
+
+/**
+ * @brief Coarsens the clustered netlist into at most max_num_levels levels.
+ *
+ * Coarsening stops early once merging groups no longer reduces their number
+ * significantly, so fewer levels may be returned.
+ *
+ *   @param clb_nlist       The clustered netlist.
+ *   @param is_movable      Whether each block may be moved together with other blocks.
+ *                          Blocks which are not movable do not belong to any group.
+ *   @param max_num_levels  The maximum number of coarse levels to build.
+ *
+ *   @return The coarse levels, from the finest to the coarsest.
+ */
+std::vector<t_place_coarse_level> coarsen_placement_netlist(const ClusteredNetlist& clb_nlist,
+                                                            const vtr::vector_map<ClusterBlockId, bool>& is_movable,
+                                                            int max_num_levels);
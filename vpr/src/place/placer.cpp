@@ -20,6 +20,9 @@
 #include "annealer.h"
 #include "RL_agent_util.h"
 #include "place_checkpoint.h"
+#include "place_multilevel.h"
+#include "place_util.h"
+#include "group_move_generator.h"
 #include "tatum/echo_writer.hpp"
 
 #ifndef NO_GRAPHICS
@@ -95,6 +98,10 @@ Placer::Placer(const Netlist<>& net_list,
                                                                     noc_opts.noc_centroid_weight,
                                                                     rng_);
 
+    if (!placer_opts.read_place_agent_state.empty()) {
+        read_agent_states(placer_opts.read_place_agent_state, *move_generator, *move_generator2);
+    }
+
     if (!placer_opts.write_initial_place_file.empty()) {
         print_place(nullptr, nullptr, placer_opts.write_initial_place_file.c_str(), placer_state_.block_locs());
     }
@@ -149,6 +156,17 @@ Placer::Placer(const Netlist<>& net_list,
 
     log_printer_.print_initial_placement_stats();
 
+    // In multilevel placement, the coarse levels are annealed first so that the annealer
+    // of the flat netlist starts from their placement (and at a lower temperature).
+    // Block groups are only moved within a layer, so this needs a single layer device.
+    if (placer_opts.place_multilevel_levels > 0 && !quench_only_) {
+        if (g_vpr_ctx.device().grid.get_num_layers() == 1) {
+            anneal_coarse_levels_(place_macros, anneal_auto_init_t_scale);
+        } else {
+            VTR_LOG_WARN("Multilevel placement only supports single layer devices and is skipped.\n");
+        }
+    }
+
     annealer_ = std::make_unique<PlacementAnnealer>(placer_opts_, placer_state_, place_macros, costs_, net_cost_handler_, noc_cost_handler_,
                                                     noc_opts_, rng_, std::move(move_generator), std::move(move_generator2), place_delay_model_.get(),
                                                     placer_criticalities_.get(), placer_setup_slacks_.get(), timing_info_.get(), pin_timing_invalidator_.get(),
@@ -216,6 +234,69 @@ void Placer::alloc_and_init_timing_objects_(const Netlist<>& net_list,
     }
 }
 
+void Placer::anneal_coarse_levels_(const PlaceMacros& place_macros,
+                                   float anneal_auto_init_t_scale) {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& block_locs = placer_state_.block_locs();
+
+    vtr::ScopedStartFinishTimer timer("Multilevel Placement of Coarse Levels");
+
+    // Fixed blocks and placement macros are only moved when the flat netlist is annealed
+    vtr::vector_map<ClusterBlockId, bool> is_movable(block_locs.size(), false);
+    for (const ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        is_movable[blk_id] = !block_locs[blk_id].is_fixed && place_macros.get_imacro_from_iblk(blk_id) == -1;
+    }
+
+    const std::vector<t_place_coarse_level> coarse_levels = coarsen_placement_netlist(cluster_ctx.clb_nlist,
+                                                                                      is_movable,
+                                                                                      placer_opts_.place_multilevel_levels);
+    const size_t num_blocks = cluster_ctx.clb_nlist.blocks().size();
+    const e_reward_function reward_function = string_to_reward(placer_opts_.place_reward_fun);
+
+    // Anneal from the coarsest level to the finest one
+    for (int ilevel = (int)coarse_levels.size() - 1; ilevel >= 0; ilevel--) {
+        const t_place_coarse_level& coarse_level = coarse_levels[ilevel];
+
+        VTR_LOGV(!log_printer_.quiet(),
+                 "\nMultilevel placement level %d: %zu block groups\n", ilevel + 1, coarse_level.groups.size());
+
+        // Scale the number of moves per temperature to the number of groups rather than blocks
+        t_placer_opts level_placer_opts = placer_opts_;
+        const float move_lim_exponent = (placer_opts_.effort_scaling == e_place_effort_scaling::CIRCUIT) ? 4.f / 3.f : 2.f / 3.f;
+        level_placer_opts.anneal_sched.inner_num *= std::pow((float)coarse_level.groups.size() / num_blocks, move_lim_exponent);
+        level_placer_opts.placement_saves_per_temperature = 0;
+        level_placer_opts.move_stats_file.clear();
+
+        const int level_move_lim = get_place_inner_loop_num_move(level_placer_opts, level_placer_opts.anneal_sched);
+
+        annealer_ = std::make_unique<PlacementAnnealer>(level_placer_opts, placer_state_, place_macros, costs_, net_cost_handler_, noc_cost_handler_,
+                                                        noc_opts_, rng_,
+                                                        std::make_unique<GroupMoveGenerator>(placer_state_, place_macros, net_cost_handler_, coarse_level, reward_function, rng_),
+                                                        std::make_unique<GroupMoveGenerator>(placer_state_, place_macros, net_cost_handler_, coarse_level, reward_function, rng_),
+                                                        place_delay_model_.get(), placer_criticalities_.get(), placer_setup_slacks_.get(), timing_info_.get(),
+                                                        pin_timing_invalidator_.get(), anneal_auto_init_t_scale, level_move_lim);
+
+        log_printer_.print_place_status_header();
+
+        do {
+            vtr::Timer temperature_timer;
+
+            annealer_->outer_loop_update_timing_info();
+
+            if (placer_opts_.place_algorithm.is_timing_driven()) {
+                critical_path_ = timing_info_->least_slack_critical_path();
+            }
+
+            annealer_->placement_inner_loop();
+
+            log_printer_.print_place_status(temperature_timer.elapsed_sec());
+        } while (annealer_->outer_loop_update_state());
+
+        // The annealer refers to level_placer_opts
+        annealer_.reset();
+    }
+}
+
 void Placer::check_place_() {
     const ClusteredNetlist& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
     const DeviceGrid& device_grid = g_vpr_ctx.device().grid;
@@ -297,7 +378,7 @@ void Placer::place() {
 
                 // see if we should save the current placement solution as a checkpoint
                 if (placer_opts_.place_checkpointing && annealer_->get_agent_state() == e_agent_state::LATE_IN_THE_ANNEAL) {
-                    save_placement_checkpoint_if_needed(placer_state_.mutable_block_locs(),
+                    save_placement_checkpoint_if_needed(placer_state_.mutable_blk_loc_registry(),
                                                         placement_checkpoint_,
                                                         timing_info_, costs_, critical_path_.delay());
                 }
@@ -333,6 +414,10 @@ void Placer::place() {
     }
     post_quench_timing_stats_ = timing_ctx.stats;
 
+    if (!placer_opts_.write_place_agent_state.empty()) {
+        annealer_->write_agent_states(placer_opts_.write_place_agent_state);
+    }
+
     // Final timing analysis
     const t_annealing_state& annealing_state = annealer_->get_annealing_state();
     PlaceCritParams crit_params;
@@ -33,6 +33,7 @@
 #include "vtr_random.h"
 
 class BlkLocRegistry;
+class PlaceMacros;
 class FlatPlacementInfo;
 namespace vtr {
 class ScopedStartFinishTimer;
@@ -169,6 +170,21 @@ class Placer {
     void alloc_and_init_timing_objects_(const Netlist<>& net_list,
                                         const t_analysis_opts& analysis_opts);
 
+    /**
+     * @brief Anneals the coarse levels of a multilevel placement.
+     *
+     * The clustered netlist is coarsened into levels of connected block groups
+     * (see place_multilevel.h). Starting from the coarsest level, each level is
+     * annealed with a GroupMoveGenerator, which moves whole groups. The flat
+     * netlist is then annealed by the regular annealer, starting from the
+     * resulting placement.
+     *
+     * @param place_macros Placement macros, whose blocks are not grouped.
+     * @param anneal_auto_init_t_scale Scales the initial temperature of each level.
+     */
+    void anneal_coarse_levels_(const PlaceMacros& place_macros,
+                               float anneal_auto_init_t_scale);
+
     /**
      * Checks that the placement has not confused our data structures.
      * i.e. the clb and block structures agree about the locations of
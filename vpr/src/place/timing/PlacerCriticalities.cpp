@@ -4,6 +4,10 @@
 #include "timing_info.h"
 #include "timing_util.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
 PlacerCriticalities::PlacerCriticalities(const ClusteredNetlist& clb_nlist,
                                          const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
                                          std::shared_ptr<const SetupTimingInfo> timing_info)
@@ -35,13 +39,34 @@ void PlacerCriticalities::update_criticalities(const PlaceCritParams& crit_param
      * For every pin on every net (or, equivalently, for every tedge ending
      * in that pin), timing_place_crit_ = criticality^(criticality exponent) */
 
+    /* Calculating the new criticalities of the affected pins only reads the
+     * timing info, so it is done in parallel. The results are then applied
+     * serially in the order of the modified pins, which keeps the highly
+     * critical pins container identical to a serial update. */
+    auto modified_pins = cluster_pins_with_modified_criticality_.begin();
+    const size_t num_modified_pins = cluster_pins_with_modified_criticality_.size();
+    new_crits_.resize(num_modified_pins);
+
+    auto calc_new_crit = [&](size_t ipin) {
+        float clb_pin_crit = calculate_clb_net_pin_criticality(*timing_info_, pin_lookup_, ParentPinId(size_t(modified_pins[ipin])), /*is_flat=*/false);
+        new_crits_[ipin] = pow(clb_pin_crit, crit_params.crit_exponent);
+    };
+
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), num_modified_pins, calc_new_crit);
+#else
+    for (size_t ipin = 0; ipin < num_modified_pins; ipin++) {
+        calc_new_crit(ipin);
+    }
+#endif
+
     // Update the affected pins
-    for (ClusterPinId clb_pin : cluster_pins_with_modified_criticality_) {
+    for (size_t ipin = 0; ipin < num_modified_pins; ipin++) {
+        ClusterPinId clb_pin = modified_pins[ipin];
         ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
         int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
 
-        float clb_pin_crit = calculate_clb_net_pin_criticality(*timing_info_, pin_lookup_, ParentPinId(size_t(clb_pin)), /*is_flat=*/false);
-        float new_crit = pow(clb_pin_crit, crit_params.crit_exponent);
+        float new_crit = new_crits_[ipin];
 
         /* Update the highly critical pins container
          *
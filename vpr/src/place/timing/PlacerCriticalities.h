@@ -177,6 +177,9 @@ class PlacerCriticalities {
     ///@brief Set of pins with criticalities modified by last call to update_criticalities().
     vtr::vec_id_set<ClusterPinId> cluster_pins_with_modified_criticality_;
 
+    ///@brief New criticalities of cluster_pins_with_modified_criticality_ (in the same order), computed in parallel.
+    std::vector<float> new_crits_;
+
     /**
      * @brief Collect the cluster pins which need to be updated based on the latest timing
      *        analysis so that incremental updates to criticalities can be performed.
@@ -4,6 +4,10 @@
 #include "timing_util.h"
 #include "timing_info.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for_each.h>
+#endif
+
 PlacerSetupSlacks::PlacerSetupSlacks(const ClusteredNetlist& clb_nlist,
                                      const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
                                      std::shared_ptr<const SetupTimingInfo> timing_info)
@@ -28,15 +32,23 @@ void PlacerSetupSlacks::update_setup_slacks() {
         recompute_setup_slacks();
     }
 
-    // Update the affected pins
-    for (ClusterPinId clb_pin : cluster_pins_with_modified_setup_slack_) {
+    // Update the affected pins. Each pin is a different connection, so they are updated in parallel
+    auto update_pin_setup_slack = [this](ClusterPinId clb_pin) {
         ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
         int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
 
         float clb_pin_setup_slack = calculate_clb_net_pin_setup_slack(*timing_info_, pin_lookup_, clb_pin);
 
         timing_place_setup_slacks_[clb_net][pin_index_in_net] = clb_pin_setup_slack;
+    };
+
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for_each(cluster_pins_with_modified_setup_slack_.begin(), cluster_pins_with_modified_setup_slack_.end(), update_pin_setup_slack);
+#else
+    for (ClusterPinId clb_pin : cluster_pins_with_modified_setup_slack_) {
+        update_pin_setup_slack(clb_pin);
     }
+#endif
 
     /* Setup slacks updated. In sync with timing info.
      * Can be incrementally updated on the next iteration. */
@@ -1,6 +1,8 @@
 
 #include "PlacerTimingCosts.h"
 
+#include "vtr_memory.h"
+
 PlacerTimingCosts::PlacerTimingCosts(const ClusteredNetlist& nlist) {
     auto nets = nlist.nets();
 
@@ -47,6 +49,7 @@ PlacerTimingCosts::PlacerTimingCosts(const ClusteredNetlist& nlist) {
 
     // Reserve space for connection costs and intermediate node values
     connection_costs_ = std::vector<double>(num_nodes, std::numeric_limits<double>::quiet_NaN());
+    vtr::apply_numa_policy(connection_costs_);
 
     // The net start indices we calculated earlier didn't account for intermediate binary tree nodes
     // Shift the start indices after the intermediate nodes
@@ -12,6 +12,10 @@
 #include "place_util.h"
 #include "vtr_time.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/task_group.h>
+#endif
+
 /* Routines local to place_timing_update.cpp */
 static double comp_td_connection_cost(const PlaceDelayModel* delay_model,
                                       const PlacerCriticalities& place_crit,
@@ -143,11 +147,22 @@ void update_timing_classes(const PlaceCritParams& crit_params,
     /* Run STA to update slacks and adjusted/relaxed criticalities. */
     timing_info->update();
 
+    /* The criticalities and setup slacks only read the timing info,
+     * so they are updated concurrently. */
+#if defined(VPR_USE_TBB)
+    tbb::task_group g;
+    /* Update the placer's criticalities (e.g. sharpen with crit_exponent). */
+    g.run([&] { criticalities->update_criticalities(crit_params); });
+    /* Update the placer's raw setup slacks. */
+    g.run([&] { setup_slacks->update_setup_slacks(); });
+    g.wait();
+#else
     /* Update the placer's criticalities (e.g. sharpen with crit_exponent). */
     criticalities->update_criticalities(crit_params);
 
     /* Update the placer's raw setup slacks. */
     setup_slacks->update_setup_slacks();
+#endif
 
     /* Clear invalidation state. */
     pin_timing_invalidator->reset();
@@ -7,6 +7,7 @@
 #include "vpr_utils.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 #include "vtr_time.h"
 
 #include "vpr_types.h"
@@ -86,6 +87,106 @@ static void check_net_for_stubs(const Netlist<>& net_list,
 
 /************************ Subroutine definitions ****************************/
 
+/* Number of nets checked by a single (possibly concurrent) task */
+constexpr size_t CHECK_ROUTE_NET_CHUNK_SIZE = 64;
+
+/* Calls check_chunk() on consecutive chunks of the nets of net_list. With TBB the
+ * chunks are checked concurrently, and the error of the first failing chunk is
+ * reported, which is the error a serial check would have stopped at. */
+template<typename CheckChunk>
+static void check_nets(const Netlist<>& net_list, const CheckChunk& check_chunk) {
+    const std::vector<ParentNetId> nets(net_list.nets().begin(), net_list.nets().end());
+    const size_t num_chunks = (nets.size() + CHECK_ROUTE_NET_CHUNK_SIZE - 1) / CHECK_ROUTE_NET_CHUNK_SIZE;
+
+    auto check_one_chunk = [&](size_t ichunk) {
+        size_t chunk_begin = ichunk * CHECK_ROUTE_NET_CHUNK_SIZE;
+        size_t chunk_end = std::min(nets.size(), chunk_begin + CHECK_ROUTE_NET_CHUNK_SIZE);
+        check_chunk(vtr::Range<std::vector<ParentNetId>::const_iterator>(nets.begin() + chunk_begin, nets.begin() + chunk_end));
+    };
+
+    // Demoted errors are logged as warnings as they are found, so keep them in order
+    if (has_demoted_errors()) {
+        for (size_t ichunk = 0; ichunk < num_chunks; ++ichunk) {
+            check_one_chunk(ichunk);
+        }
+    } else {
+        vtr::parallel_for_first_error(num_chunks, check_one_chunk);
+    }
+}
+
+/* Checks that the routing of net_id is a properly connected path which connects
+ * all the pins of the net. pin_done must have room for all the pins of the net. */
+static void check_net_routing(const Netlist<>& net_list,
+                              ParentNetId net_id,
+                              enum e_route_type route_type,
+                              size_t num_switches,
+                              bool is_flat,
+                              bool* pin_done) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    if (net_list.net_is_ignored(net_id) || net_list.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
+        return;
+
+    std::fill_n(pin_done, net_list.net_pins(net_id).size(), false);
+
+    if (!route_ctx.route_trees[net_id]) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %d has no routing.\n", size_t(net_id));
+    }
+
+    /* Check the SOURCE of the net. */
+    RRNodeId source_inode = route_ctx.route_trees[net_id].value().root().inode;
+    check_node_and_range(source_inode, route_type, is_flat);
+    check_source(net_list, source_inode, net_id, is_flat);
+
+    pin_done[0] = true;
+
+    /* Check the rest of the net */
+    size_t num_sinks = 0;
+    for (const RouteTreeNode& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+        RRNodeId inode = rt_node.inode;
+        int net_pin_index = rt_node.net_pin_index;
+        check_node_and_range(inode, route_type, is_flat);
+        check_switch(rt_node, num_switches);
+
+        if (rt_node.parent()) {
+            bool connects = check_adjacent(rt_node.parent()->inode, rt_node.inode, is_flat);
+            if (!connects) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
+                          "  %s\n"
+                          "  %s\n",
+                          size_t(net_id),
+                          describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, rt_node.parent()->inode, is_flat).c_str(),
+                          describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str());
+            }
+        }
+
+        if (rr_graph.node_type(inode) == e_rr_type::SINK) {
+            check_sink(net_list, inode, net_pin_index, net_id, pin_done);
+            num_sinks += 1;
+        }
+    }
+
+    if (num_sinks != net_list.net_sinks(net_id).size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
+                        size_t(net_id), net_list.net_name(net_id).c_str(),
+                        num_sinks, net_list.net_sinks(net_id).size());
+    }
+
+    for (size_t ipin = 0; ipin < net_list.net_pins(net_id).size(); ipin++) {
+        if (!pin_done[ipin]) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
+        }
+    }
+
+    check_net_for_stubs(net_list, net_id, is_flat);
+}
+
 void check_route(const Netlist<>& net_list,
                  enum e_route_type route_type,
                  e_check_route_option check_route_option,
@@ -131,70 +232,13 @@ void check_route(const Netlist<>& net_list,
     for (auto net_id : net_list.nets())
         max_pins = std::max(max_pins, (int)net_list.net_pins(net_id).size());
 
-    auto pin_done = std::make_unique<bool[]>(max_pins);
-
     /* Now check that all nets are indeed connected. */
-    for (auto net_id : net_list.nets()) {
-        if (net_list.net_is_ignored(net_id) || net_list.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
-            continue;
-
-        std::fill_n(pin_done.get(), net_list.net_pins(net_id).size(), false);
-
-        if (!route_ctx.route_trees[net_id]) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %d has no routing.\n", size_t(net_id));
-        }
-
-        /* Check the SOURCE of the net. */
-        RRNodeId source_inode = route_ctx.route_trees[net_id].value().root().inode;
-        check_node_and_range(source_inode, route_type, is_flat);
-        check_source(net_list, source_inode, net_id, is_flat);
-
-        pin_done[0] = true;
-
-        /* Check the rest of the net */
-        size_t num_sinks = 0;
-        for (const RouteTreeNode& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
-            RRNodeId inode = rt_node.inode;
-            int net_pin_index = rt_node.net_pin_index;
-            check_node_and_range(inode, route_type, is_flat);
-            check_switch(rt_node, num_switches);
-
-            if (rt_node.parent()) {
-                bool connects = check_adjacent(rt_node.parent()->inode, rt_node.inode, is_flat);
-                if (!connects) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
-                              "  %s\n"
-                              "  %s\n",
-                              size_t(net_id),
-                              describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, rt_node.parent()->inode, is_flat).c_str(),
-                              describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str());
-                }
-            }
-
-            if (rr_graph.node_type(inode) == e_rr_type::SINK) {
-                check_sink(net_list, inode, net_pin_index, net_id, pin_done.get());
-                num_sinks += 1;
-            }
+    check_nets(net_list, [&](vtr::Range<std::vector<ParentNetId>::const_iterator> nets) {
+        auto pin_done = std::make_unique<bool[]>(max_pins);
+        for (ParentNetId net_id : nets) {
+            check_net_routing(net_list, net_id, route_type, num_switches, is_flat, pin_done.get());
         }
-
-        if (num_sinks != net_list.net_sinks(net_id).size()) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
-                            size_t(net_id), net_list.net_name(net_id).c_str(),
-                            num_sinks, net_list.net_sinks(net_id).size());
-        }
-
-        for (size_t ipin = 0; ipin < net_list.net_pins(net_id).size(); ipin++) {
-            if (!pin_done[ipin]) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
-            }
-        }
-
-        check_net_for_stubs(net_list, net_id, is_flat);
-    } /* End for each net */
+    });
 
     if (check_route_option == e_check_route_option::FULL) {
         check_all_non_configurable_edges(net_list, is_flat);
@@ -612,13 +656,15 @@ static void check_all_non_configurable_edges(const Netlist<>& net_list, bool is_
         }
     }
 
-    for (auto net_id : net_list.nets()) {
-        check_non_configurable_edges(net_list,
-                                     net_id,
-                                     non_configurable_rr_sets,
-                                     rrnode_set_ids,
-                                     is_flat);
-    }
+    check_nets(net_list, [&](vtr::Range<std::vector<ParentNetId>::const_iterator> nets) {
+        for (ParentNetId net_id : nets) {
+            check_non_configurable_edges(net_list,
+                                         net_id,
+                                         non_configurable_rr_sets,
+                                         rrnode_set_ids,
+                                         is_flat);
+        }
+    });
 }
 
 static bool check_non_configurable_edges(const Netlist<>& net_list,
@@ -846,7 +892,7 @@ void check_net_for_stubs(const Netlist<>& net_list,
 }
 
 bool StubFinder::CheckNet(ParentNetId net) {
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    const auto& route_ctx = g_vpr_ctx.routing();
     stub_nodes_.clear();
 
     if (!route_ctx.route_trees[net])
@@ -10,6 +10,7 @@
 #include "physical_types_util.h"
 #include "route_export.h"
 #include "vpr_utils.h"
+#include "vtr_memory.h"
 #include "route_utilization.h"
 
 #if defined(VPR_USE_TBB)
@@ -425,6 +426,7 @@ void alloc_and_load_rr_node_route_structs(const t_router_opts& router_opts) {
     const auto& device_ctx = g_vpr_ctx.device();
 
     route_ctx.rr_node_route_inf.resize(device_ctx.rr_graph.num_nodes());
+    vtr::apply_numa_policy(route_ctx.rr_node_route_inf);
     route_ctx.non_configurable_bitset.resize(device_ctx.rr_graph.num_nodes());
     route_ctx.non_configurable_bitset.fill(false);
 
@@ -44,6 +44,11 @@
 #include "rr_types.h"
 #include "rr_node_indices.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
 //#define VERBOSE
 //used for getting the exact count of each edge type and printing it to std out.
 
@@ -311,30 +316,69 @@ static void add_intra_tile_edges_rr_graph(RRGraphBuilder& rr_graph_builder,
                                           t_physical_tile_type_ptr physical_tile,
                                           const t_physical_tile_loc& root_loc);
 
-static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
-                          const int layer,
-                          const int x_coord,
-                          const int y_coord,
-                          const e_rr_type chan_type,
-                          const t_track_to_pin_lookup& track_to_pin_lookup,
-                          t_sb_connection_map* sb_conn_map,
-                          const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
-                          vtr::NdMatrix<int, 2>& num_of_3d_conns_custom_SB,
-                          const int cost_index_offset,
-                          const t_chan_width& nodes_per_chan,
-                          const DeviceGrid& grid,
-                          const int tracks_per_chan,
-                          t_sblock_pattern& sblock_pattern,
-                          const int Fs_per_side,
-                          const t_chan_details& chan_details_x,
-                          const t_chan_details& chan_details_y,
-                          t_rr_edge_info_set& rr_edges_to_create,
-                          t_rr_edge_info_set& des_3d_rr_edges_to_create,
-                          const int wire_to_ipin_switch,
-                          const int wire_to_pin_between_dice_switch,
-                          const int custom_3d_sb_fanin_fanout,
-                          const int delayless_switch,
-                          const enum e_directionality directionality);
+/**
+ * @brief Collects the edges driven by the wire segments which start in the specified channel segment.
+ *
+ * Apart from the lazily filled entries of sblock_pattern (which are only written for the
+ * driving wires, so each entry is owned by the channel segment a wire starts in) and the
+ * 3D custom switch block bookkeeping (num_of_3d_conns_custom_SB, des_3d_rr_edges_to_create),
+ * this only reads shared data, so different channel segments can be processed concurrently
+ * when the device has no 3D custom switch blocks.
+ */
+static void build_rr_chan_edges(RRGraphBuilder& rr_graph_builder,
+                                const int layer,
+                                const int x_coord,
+                                const int y_coord,
+                                const e_rr_type chan_type,
+                                const t_track_to_pin_lookup& track_to_pin_lookup,
+                                t_sb_connection_map* sb_conn_map,
+                                const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
+                                vtr::NdMatrix<int, 2>& num_of_3d_conns_custom_SB,
+                                const t_chan_width& nodes_per_chan,
+                                const DeviceGrid& grid,
+                                const int tracks_per_chan,
+                                t_sblock_pattern& sblock_pattern,
+                                const int Fs_per_side,
+                                const t_chan_details& chan_details_x,
+                                const t_chan_details& chan_details_y,
+                                t_rr_edge_info_set& rr_edges_to_create,
+                                t_rr_edge_info_set& des_3d_rr_edges_to_create,
+                                const int wire_to_ipin_switch,
+                                const int wire_to_pin_between_dice_switch,
+                                const int custom_3d_sb_fanin_fanout,
+                                const int delayless_switch,
+                                const enum e_directionality directionality);
+
+/**
+ * @brief Initializes the properties (cost index, capacity, coordinates, RC data, ...) of the
+ *        wire segments which start in the specified channel segment.
+ *
+ * Not thread safe: shared RC data is created on demand (find_create_rr_rc_data()).
+ */
+static void load_rr_chan_nodes(RRGraphBuilder& rr_graph_builder,
+                               const int layer,
+                               const int x_coord,
+                               const int y_coord,
+                               const e_rr_type chan_type,
+                               const int cost_index_offset,
+                               const int tracks_per_chan,
+                               const t_chan_details& chan_details_x,
+                               const t_chan_details& chan_details_y);
+
+/**
+ * @brief Returns the node of the given track if its wire segment starts in the specified
+ *        channel segment (invalid id otherwise), along with the segment's start and end
+ *        coordinates along the channel.
+ */
+static RRNodeId get_rr_chan_seg_start_node(RRGraphBuilder& rr_graph_builder,
+                                           const int layer,
+                                           const int x_coord,
+                                           const int y_coord,
+                                           const e_rr_type chan_type,
+                                           const int track,
+                                           const t_chan_seg_details* seg_details,
+                                           int& start,
+                                           int& end);
 
 /**
  * @brief builds the extra length-0 CHANX nodes to handle 3D custom switchblocks edges in the RR graph.
@@ -1525,10 +1569,58 @@ static std::function<void(t_chan_width*)> alloc_and_load_rr_graph(RRGraphBuilder
 
     t_rr_edge_info_set des_3d_rr_edges_to_create;
 
-    for (size_t i = 0; i < grid.width() - 1; ++i) {
+    // Edges of the channel segments in column i, in (y, layer, CHANX/CHANY) order.
+    // Only reads shared data (see build_rr_chan_edges()), except for the 3D custom switch block bookkeeping.
+    auto build_column_chan_edges = [&](size_t i, std::vector<t_rr_edge_info_set>& column_rr_edges_to_create) {
+        const auto& device_ctx = g_vpr_ctx.device();
+        for (size_t j = 0; j < grid.height() - 1; ++j) {
+            for (int layer = 0; layer < (int)grid.get_num_layers(); ++layer) {
+                // Skip the current die if architecture file specifies that it doesn't require inter-cluster programmable resource routing
+                if (!device_ctx.inter_cluster_prog_routing_resources.at(layer)) {
+                    continue;
+                }
+
+                if (i > 0) {
+                    int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.x_list[j]);
+                    t_rr_edge_info_set& chan_rr_edges_to_create = column_rr_edges_to_create.emplace_back();
+                    build_rr_chan_edges(rr_graph_builder, layer, i, j, e_rr_type::CHANX, track_to_pin_lookup_x, sb_conn_map,
+                                        switch_block_conn,
+                                        num_of_3d_conns_custom_SB,
+                                        chan_width, grid, tracks_per_chan,
+                                        sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
+                                        chan_rr_edges_to_create, des_3d_rr_edges_to_create,
+                                        wire_to_ipin_switch,
+                                        wire_to_pin_between_dice_switch,
+                                        custom_3d_sb_fanin_fanout,
+                                        delayless_switch,
+                                        directionality);
+                    uniquify_edges(chan_rr_edges_to_create);
+                }
+                if (j > 0) {
+                    int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.y_list[i]);
+                    t_rr_edge_info_set& chan_rr_edges_to_create = column_rr_edges_to_create.emplace_back();
+                    build_rr_chan_edges(rr_graph_builder, layer, i, j, e_rr_type::CHANY, track_to_pin_lookup_y, sb_conn_map,
+                                        switch_block_conn,
+                                        num_of_3d_conns_custom_SB,
+                                        chan_width, grid, tracks_per_chan,
+                                        sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
+                                        chan_rr_edges_to_create, des_3d_rr_edges_to_create,
+                                        wire_to_ipin_switch,
+                                        wire_to_pin_between_dice_switch,
+                                        custom_3d_sb_fanin_fanout,
+                                        delayless_switch,
+                                        directionality);
+                    uniquify_edges(chan_rr_edges_to_create);
+                }
+            }
+        }
+    };
+
+    // Initializes the channel nodes of column i and creates the actual CHAN->CHAN edges collected by build_column_chan_edges()
+    auto load_column_chans = [&](size_t i, std::vector<t_rr_edge_info_set>& column_rr_edges_to_create) {
+        const auto& device_ctx = g_vpr_ctx.device();
         for (size_t j = 0; j < grid.height() - 1; ++j) {
             for (int layer = 0; layer < (int)grid.get_num_layers(); ++layer) {
-                const auto& device_ctx = g_vpr_ctx.device();
                 // Skip the current die if architecture file specifies that it doesn't require inter-cluster programmable resource routing
                 if (!device_ctx.inter_cluster_prog_routing_resources.at(layer)) {
                     continue;
@@ -1546,48 +1638,59 @@ static std::function<void(t_chan_width*)> alloc_and_load_rr_graph(RRGraphBuilder
 
                 if (i > 0) {
                     int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.x_list[j]);
-                    build_rr_chan(rr_graph_builder, layer, i, j, e_rr_type::CHANX, track_to_pin_lookup_x, sb_conn_map,
-                                  switch_block_conn,
-                                  num_of_3d_conns_custom_SB, CHANX_COST_INDEX_START,
-                                  chan_width, grid, tracks_per_chan,
-                                  sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
-                                  rr_edges_to_create, des_3d_rr_edges_to_create,
-                                  wire_to_ipin_switch,
-                                  wire_to_pin_between_dice_switch,
-                                  custom_3d_sb_fanin_fanout,
-                                  delayless_switch,
-                                  directionality);
-
-                    //Create the actual CHAN->CHAN edges
-                    uniquify_edges(rr_edges_to_create);
-                    alloc_and_load_edges(rr_graph_builder, rr_edges_to_create);
-                    num_edges += rr_edges_to_create.size();
-
-                    rr_edges_to_create.clear();
+                    load_rr_chan_nodes(rr_graph_builder, layer, i, j, e_rr_type::CHANX, CHANX_COST_INDEX_START,
+                                       tracks_per_chan, chan_details_x, chan_details_y);
                 }
                 if (j > 0) {
                     int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.y_list[i]);
-                    build_rr_chan(rr_graph_builder, layer, i, j, e_rr_type::CHANY, track_to_pin_lookup_y, sb_conn_map,
-                                  switch_block_conn,
-                                  num_of_3d_conns_custom_SB, CHANX_COST_INDEX_START + num_seg_types_x,
-                                  chan_width, grid, tracks_per_chan,
-                                  sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
-                                  rr_edges_to_create, des_3d_rr_edges_to_create,
-                                  wire_to_ipin_switch,
-                                  wire_to_pin_between_dice_switch,
-                                  custom_3d_sb_fanin_fanout,
-                                  delayless_switch,
-                                  directionality);
+                    load_rr_chan_nodes(rr_graph_builder, layer, i, j, e_rr_type::CHANY, CHANX_COST_INDEX_START + num_seg_types_x,
+                                       tracks_per_chan, chan_details_x, chan_details_y);
+                }
+            }
+        }
 
-                    //Create the actual CHAN->CHAN edges
-                    uniquify_edges(rr_edges_to_create);
-                    alloc_and_load_edges(rr_graph_builder, rr_edges_to_create);
-                    num_edges += rr_edges_to_create.size();
+        for (t_rr_edge_info_set& chan_rr_edges_to_create : column_rr_edges_to_create) {
+            alloc_and_load_edges(rr_graph_builder, chan_rr_edges_to_create);
+            num_edges += chan_rr_edges_to_create.size();
+        }
+    };
 
-                    rr_edges_to_create.clear();
-                }
+    // The edges of different columns are collected concurrently, in batches to bound the memory
+    // held by the pending edges, and are then created serially in column order, so the resulting
+    // RR graph is identical to the one of a serial build.
+    // With 3D custom switch blocks the inter-die connections are numbered in the order they are
+    // found (num_of_3d_conns_custom_SB), so the columns are processed serially in that case.
+    const size_t num_columns = grid.width() - 1;
+    size_t columns_per_batch = 1;
+#ifdef VPR_USE_TBB
+    const bool parallel_chan_edges = !(grid.get_num_layers() > 1 && sb_conn_map != nullptr);
+    if (parallel_chan_edges) {
+        columns_per_batch = 4 * tbb::this_task_arena::max_concurrency();
+    }
+#endif
+    std::vector<std::vector<t_rr_edge_info_set>> batch_rr_edges_to_create(columns_per_batch);
+
+    for (size_t batch_begin = 0; batch_begin < num_columns; batch_begin += columns_per_batch) {
+        size_t batch_end = std::min(num_columns, batch_begin + columns_per_batch);
+
+        auto build_batch_column = [&](size_t i) {
+            build_column_chan_edges(i, batch_rr_edges_to_create[i - batch_begin]);
+        };
+#ifdef VPR_USE_TBB
+        if (parallel_chan_edges) {
+            tbb::parallel_for(batch_begin, batch_end, build_batch_column);
+        } else
+#endif
+        {
+            for (size_t i = batch_begin; i < batch_end; ++i) {
+                build_batch_column(i);
             }
         }
+
+        for (size_t i = batch_begin; i < batch_end; ++i) {
+            load_column_chans(i, batch_rr_edges_to_create[i - batch_begin]);
+            batch_rr_edges_to_create[i - batch_begin].clear();
+        }
     }
 
     if (grid.get_num_layers() > 1 && sb_conn_map != nullptr) {
@@ -1794,39 +1897,36 @@ void free_rr_graph() {
     invalidate_router_lookahead_cache();
 }
 
-/* Allocates/loads edges for nodes belonging to specified channel segment and initializes
- * node properties such as cost, occupancy and capacity */
-static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
-                          const int layer,
-                          const int x_coord,
-                          const int y_coord,
-                          const e_rr_type chan_type,
-                          const t_track_to_pin_lookup& track_to_pin_lookup,
-                          t_sb_connection_map* sb_conn_map,
-                          const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
-                          vtr::NdMatrix<int, 2>& num_of_3d_conns_custom_SB,
-                          const int cost_index_offset,
-                          const t_chan_width& nodes_per_chan,
-                          const DeviceGrid& grid,
-                          const int tracks_per_chan,
-                          t_sblock_pattern& sblock_pattern,
-                          const int Fs_per_side,
-                          const t_chan_details& chan_details_x,
-                          const t_chan_details& chan_details_y,
-                          t_rr_edge_info_set& rr_edges_to_create,
-                          t_rr_edge_info_set& des_3d_rr_edges_to_create,
-                          const int wire_to_ipin_switch,
-                          const int wire_to_pin_between_dice_switch,
-                          const int custom_3d_sb_fanin_fanout,
-                          const int delayless_switch,
-                          const enum e_directionality directionality) {
+/* Adds the edges of the nodes belonging to the specified channel segment to rr_edges_to_create.
+ * The node properties are initialized separately by load_rr_chan_nodes() */
+static void build_rr_chan_edges(RRGraphBuilder& rr_graph_builder,
+                                const int layer,
+                                const int x_coord,
+                                const int y_coord,
+                                const e_rr_type chan_type,
+                                const t_track_to_pin_lookup& track_to_pin_lookup,
+                                t_sb_connection_map* sb_conn_map,
+                                const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
+                                vtr::NdMatrix<int, 2>& num_of_3d_conns_custom_SB,
+                                const t_chan_width& nodes_per_chan,
+                                const DeviceGrid& grid,
+                                const int tracks_per_chan,
+                                t_sblock_pattern& sblock_pattern,
+                                const int Fs_per_side,
+                                const t_chan_details& chan_details_x,
+                                const t_chan_details& chan_details_y,
+                                t_rr_edge_info_set& rr_edges_to_create,
+                                t_rr_edge_info_set& des_3d_rr_edges_to_create,
+                                const int wire_to_ipin_switch,
+                                const int wire_to_pin_between_dice_switch,
+                                const int custom_3d_sb_fanin_fanout,
+                                const int delayless_switch,
+                                const enum e_directionality directionality) {
     // this function builds both x and y-directed channel segments, so set up our coordinates based on channel type
 
     const auto& device_ctx = g_vpr_ctx.device();
-    auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
 
     // Initially assumes CHANX
-    int seg_coord = x_coord;                           //The absolute coordinate of this segment within the channel
     int chan_coord = y_coord;                          //The absolute coordinate of this channel within the device
     int seg_dimension = device_ctx.grid.width() - 2;   //-2 for no perim channels
     int chan_dimension = device_ctx.grid.height() - 2; //-2 for no perim channels
@@ -1835,7 +1935,7 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
     e_rr_type opposite_chan_type = e_rr_type::CHANY;
     if (chan_type == e_rr_type::CHANY) {
         //Swap values since CHANX was assumed above
-        std::swap(seg_coord, chan_coord);
+        chan_coord = x_coord;
         std::swap(seg_dimension, chan_dimension);
         opposite_chan_type = e_rr_type::CHANX;
     }
@@ -1851,19 +1951,12 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
 
     // Loads up all the routing resource nodes in the current channel segment
     for (int track = 0; track < tracks_per_chan; ++track) {
-        if (seg_details[track].length() == 0)
-            continue;
-
-        // Start and end coordinates of this segment along the length of the channel
-        // Note that these values are in the VPR coordinate system (and do not consider
-        // wire directionality), so start correspond to left/bottom and end corresponds to right/top
-        int start = get_seg_start(seg_details, track, chan_coord, seg_coord);
-        int end = get_seg_end(seg_details, track, start, chan_coord, seg_dimension);
+        int start, end;
+        RRNodeId node = get_rr_chan_seg_start_node(rr_graph_builder, layer, x_coord, y_coord, chan_type, track, seg_details, start, end);
 
-        if (seg_coord > start) {
-            continue; // Only process segments which start at this location
+        if (!node) {
+            continue;
         }
-        VTR_ASSERT(seg_coord == start);
 
         const t_chan_seg_details* from_seg_details = nullptr;
         if (chan_type == e_rr_type::CHANY) {
@@ -1872,12 +1965,6 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
             from_seg_details = chan_details_x[start][y_coord].data();
         }
 
-        RRNodeId node = rr_graph_builder.node_lookup().find_node(layer, x_coord, y_coord, chan_type, track);
-
-        if (!node) {
-            continue;
-        }
-
         // Add the edges from this track to all it's connected pins into the list
         get_track_to_pins(rr_graph_builder, layer, start, chan_coord, track, tracks_per_chan, node, rr_edges_to_create,
                           track_to_pin_lookup, seg_details, chan_type, seg_dimension,
@@ -1958,7 +2045,70 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
             }
         }
 
-        // Edge arrays have now been built up.  Do everything else.
+    }
+}
+
+static RRNodeId get_rr_chan_seg_start_node(RRGraphBuilder& rr_graph_builder,
+                                           const int layer,
+                                           const int x_coord,
+                                           const int y_coord,
+                                           const e_rr_type chan_type,
+                                           const int track,
+                                           const t_chan_seg_details* seg_details,
+                                           int& start,
+                                           int& end) {
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    if (seg_details[track].length() == 0) {
+        return RRNodeId::INVALID();
+    }
+
+    // Initially assumes CHANX
+    int seg_coord = x_coord;                           //The absolute coordinate of this segment within the channel
+    int chan_coord = y_coord;                          //The absolute coordinate of this channel within the device
+    int seg_dimension = device_ctx.grid.width() - 2;   //-2 for no perim channels
+    if (chan_type == e_rr_type::CHANY) {
+        //Swap values since CHANX was assumed above
+        std::swap(seg_coord, chan_coord);
+        seg_dimension = device_ctx.grid.height() - 2;
+    }
+
+    // Start and end coordinates of this segment along the length of the channel
+    // Note that these values are in the VPR coordinate system (and do not consider
+    // wire directionality), so start correspond to left/bottom and end corresponds to right/top
+    start = get_seg_start(seg_details, track, chan_coord, seg_coord);
+    end = get_seg_end(seg_details, track, start, chan_coord, seg_dimension);
+
+    if (seg_coord > start) {
+        return RRNodeId::INVALID(); // Only process segments which start at this location
+    }
+    VTR_ASSERT(seg_coord == start);
+
+    return rr_graph_builder.node_lookup().find_node(layer, x_coord, y_coord, chan_type, track);
+}
+
+static void load_rr_chan_nodes(RRGraphBuilder& rr_graph_builder,
+                               const int layer,
+                               const int x_coord,
+                               const int y_coord,
+                               const e_rr_type chan_type,
+                               const int cost_index_offset,
+                               const int tracks_per_chan,
+                               const t_chan_details& chan_details_x,
+                               const t_chan_details& chan_details_y) {
+    auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
+
+    const t_chan_details& from_chan_details = (chan_type == e_rr_type::CHANX) ? chan_details_x : chan_details_y;
+    const t_chan_seg_details* seg_details = from_chan_details[x_coord][y_coord].data();
+
+    for (int track = 0; track < tracks_per_chan; ++track) {
+        int start, end;
+        RRNodeId node = get_rr_chan_seg_start_node(rr_graph_builder, layer, x_coord, y_coord, chan_type, track, seg_details, start, end);
+
+        if (!node) {
+            continue;
+        }
+
         // AA: The cost_index should be w.r.t the index of the segment to its **parallel** segment_inf vector.
         // Note that when building channels, we use the indices w.r.t segment_inf_x and segment_inf_y as
         // computed earlier in build_rr_graph so it's fine to use .index() for to get the correct index.
@@ -15,6 +15,11 @@
 #include "tileable_rr_graph_gsb.h"
 #include "tileable_rr_graph_edge_builder.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
 /************************************************************************
  * Build the edges for all the SOURCE and SINKs nodes:
  * 1. create edges between SOURCE and OPINs
@@ -318,38 +323,73 @@ void build_rr_graph_regular_edges(const RRGraphView& rr_graph,
 
     vtr::Point<size_t> gsb_range(grids.width() - 1, grids.height() - 1);
 
-    /* Go Switch Block by Switch Block */
-    for (size_t ix = 0; ix <= gsb_range.x(); ++ix) {
-        for (size_t iy = 0; iy <= gsb_range.y(); ++iy) {
-            //vpr_printf(TIO_MESSAGE_INFO, "Building edges for GSB[%lu][%lu]\n", ix, iy);
-
-            vtr::Point<size_t> gsb_coord(ix, iy);
-            /* Create a GSB object */
-            const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
-                                                            device_chan_width, segment_inf_x, segment_inf_y,
-                                                            layer, gsb_coord, perimeter_cb);
+    /* Collect the edges of one GSB. This only reads the RR graph, so different GSBs can be processed concurrently */
+    auto build_one_gsb_edges = [&](const vtr::Point<size_t>& gsb_coord, t_rr_edge_info_set& gsb_edges_to_create) {
+        /* Create a GSB object */
+        const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
+                                                        device_chan_width, segment_inf_x, segment_inf_y,
+                                                        layer, gsb_coord, perimeter_cb);
 
-            /* adapt the track_to_ipin_lookup for the GSB nodes */
-            t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
-            track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in);
-
-            /* adapt the opin_to_track_map for the GSB nodes */
-            t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
-            opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out, opin2all_sides);
-
-            /* adapt the switch_block_conn for the GSB nodes */
-            t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
-            sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb,
-                                                   sb_type, Fs, sb_subtype, sub_fs, concat_wire, wire_opposite_side,
-                                                   segment_inf);
-
-            /* Build edges for a GSB */
-            /* Build edges for a GSB */
-            build_edges_for_one_tileable_rr_gsb(rr_graph_builder, rr_gsb,
-                                                track2ipin_map, opin2track_map,
-                                                sb_conn, rr_node_driver_switches, num_edges_to_create);
-            /* Finish this GSB, go to the next*/
-            rr_graph_builder.build_edges(true);
+        /* adapt the track_to_ipin_lookup for the GSB nodes */
+        t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
+        track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in);
+
+        /* adapt the opin_to_track_map for the GSB nodes */
+        t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
+        opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out, opin2all_sides);
+
+        /* adapt the switch_block_conn for the GSB nodes */
+        t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
+        sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb,
+                                               sb_type, Fs, sb_subtype, sub_fs, concat_wire, wire_opposite_side,
+                                               segment_inf);
+
+        /* Build edges for a GSB */
+        build_edges_for_one_tileable_rr_gsb(gsb_edges_to_create, rr_gsb,
+                                            track2ipin_map, opin2track_map,
+                                            sb_conn, rr_node_driver_switches);
+        /* Sort and remove duplicates here, so that build_edges() below gets an already uniquified set */
+        uniquify_edges(gsb_edges_to_create);
+    };
+
+    /* Go Switch Block by Switch Block.
+     * The edges of a batch of GSB columns are collected concurrently and then
+     * added to the graph GSB by GSB in the same order as a serial build,
+     * so the resulting graph does not depend on the number of threads.
+     * The batches bound the memory held by the pending edges.
+     */
+    size_t columns_per_batch = 1;
+#ifdef VPR_USE_TBB
+    columns_per_batch = 4 * tbb::this_task_arena::max_concurrency();
+#endif
+    const size_t num_gsb_rows = gsb_range.y() + 1;
+    std::vector<t_rr_edge_info_set> batch_edges_to_create(columns_per_batch * num_gsb_rows);
+
+    for (size_t batch_begin = 0; batch_begin <= gsb_range.x(); batch_begin += columns_per_batch) {
+        size_t batch_end = std::min(gsb_range.x() + 1, batch_begin + columns_per_batch);
+
+        auto build_one_gsb_column_edges = [&](size_t ix) {
+            for (size_t iy = 0; iy <= gsb_range.y(); ++iy) {
+                build_one_gsb_edges(vtr::Point<size_t>(ix, iy), batch_edges_to_create[(ix - batch_begin) * num_gsb_rows + iy]);
+            }
+        };
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(batch_begin, batch_end, build_one_gsb_column_edges);
+#else
+        for (size_t ix = batch_begin; ix < batch_end; ++ix) {
+            build_one_gsb_column_edges(ix);
+        }
+#endif
+
+        for (size_t ix = batch_begin; ix < batch_end; ++ix) {
+            for (size_t iy = 0; iy <= gsb_range.y(); ++iy) {
+                t_rr_edge_info_set& gsb_edges_to_create = batch_edges_to_create[(ix - batch_begin) * num_gsb_rows + iy];
+                rr_graph_builder.create_edges_in_cache(gsb_edges_to_create);
+                num_edges_to_create += gsb_edges_to_create.size();
+                gsb_edges_to_create.clear();
+                /* Finish this GSB, go to the next*/
+                rr_graph_builder.build_edges(true);
+            }
         }
     }
 }
@@ -1174,15 +1174,15 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
  * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks)
  * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks)
  * 3. create edges between OPINs and IPINs (direct-connections)
+ * The edges are appended to rr_edges_to_create rather than to the edge cache
+ * of the RRGraphBuilder, so that different GSBs can be processed concurrently
  ***********************************************************************/
-void build_edges_for_one_tileable_rr_gsb(RRGraphBuilder& rr_graph_builder,
+void build_edges_for_one_tileable_rr_gsb(t_rr_edge_info_set& rr_edges_to_create,
                                          const RRGSB& rr_gsb,
                                          const t_track2pin_map& track2ipin_map,
                                          const t_pin2track_map& opin2track_map,
                                          const t_track2track_map& track2track_map,
-                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches,
-                                         size_t& num_edges_to_create) {
-    size_t edge_count = 0;
+                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
     /* Walk through each sides */
     for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
         SideManager side_manager(side);
@@ -1196,8 +1196,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraphBuilder& rr_graph_builder,
                 /* 1. create edges between OPINs and CHANX|CHANY, using opin2track_map */
                 /* add edges to the opin_node */
                 for (const RRNodeId& track_node : opin2track_map[gsb_side][inode][to_side]) {
-                    rr_graph_builder.create_edge_in_cache(opin_node, track_node, rr_node_driver_switches[track_node], false);
-                    edge_count++;
+                    rr_edges_to_create.emplace_back(opin_node, track_node, size_t(rr_node_driver_switches[track_node]), false);
                 }
             }
         }
@@ -1212,8 +1211,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraphBuilder& rr_graph_builder,
             for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
                 const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode);
                 for (const RRNodeId& ipin_node : track2ipin_map[gsb_side][inode]) {
-                    rr_graph_builder.create_edge_in_cache(chan_node, ipin_node, rr_node_driver_switches[ipin_node], false);
-                    edge_count++;
+                    rr_edges_to_create.emplace_back(chan_node, ipin_node, size_t(rr_node_driver_switches[ipin_node]), false);
                 }
             }
         }
@@ -1222,13 +1220,10 @@ void build_edges_for_one_tileable_rr_gsb(RRGraphBuilder& rr_graph_builder,
         for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
             const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode);
             for (const RRNodeId& track_node : track2track_map[gsb_side][inode]) {
-                rr_graph_builder.create_edge_in_cache(chan_node, track_node, rr_node_driver_switches[track_node], false);
-                edge_count++;
+                rr_edges_to_create.emplace_back(chan_node, track_node, size_t(rr_node_driver_switches[track_node]), false);
             }
         }
     }
-
-    num_edges_to_create += edge_count;
 }
 
 void build_edges_for_one_tileable_rr_gsb_vib(RRGraphBuilder& rr_graph_builder,
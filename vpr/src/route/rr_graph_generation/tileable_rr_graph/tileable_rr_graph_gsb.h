@@ -16,6 +16,7 @@
 #include "rr_graph.h"
 #include "rr_graph_view.h"
 #include "rr_graph_builder.h"
+#include "rr_edge.h"
 
 /********************************************************************
  * Function declaration
@@ -61,13 +62,12 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
                                 const vtr::Point<size_t>& gsb_coordinate,
                                 const bool& perimeter_cb);
 
-void build_edges_for_one_tileable_rr_gsb(RRGraphBuilder& rr_graph_builder,
+void build_edges_for_one_tileable_rr_gsb(t_rr_edge_info_set& rr_edges_to_create,
                                          const RRGSB& rr_gsb,
                                          const t_track2pin_map& track2ipin_map,
                                          const t_pin2track_map& opin2track_map,
                                          const t_track2track_map& track2track_map,
-                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches,
-                                         size_t& num_edges);
+                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches);
 
 void build_edges_for_one_tileable_rr_gsb_vib(RRGraphBuilder& rr_graph_builder,
                                              const RRGSB& rr_gsb,
@@ -7,21 +7,21 @@
  *
  *  The class LazyPopUniquePriorityQueue is a priority queue that allows for lazy deletion of elements.
  *  The elements are pair of key and sort-value. The key is a unique value to identify the item, and the sort-value is used to sort the item.
- *  It is implemented using a vector and 2 sets, one set keeps track of the elements in the queue, and the other set keeps track of the elements that are pending deletion, 
+ *  It is implemented using a vector and a map, the map keeps track of the elements in the queue and whether they are pending deletion,
  *  so that they can be removed from the queue when they are popped.
  * 
  *  Currently, the class supports the following functions:
- *      LazyPopUniquePriorityQueue::push(): Pushes a key-sort-value (K-SV) pair into the priority queue and adds the key to the tracking set.
+ *      LazyPopUniquePriorityQueue::push(): Pushes a key-sort-value (K-SV) pair into the priority queue and adds the key to the tracking map.
  *      LazyPopUniquePriorityQueue::pop(): Returns the K-SV pair with the highest SV whose key is not pending deletion.
  *      LazyPopUniquePriorityQueue::remove(): Removes an element from the priority queue immediately.
  *      LazyPopUniquePriorityQueue::remove_at_pop_time(): Removes an element from the priority queue when it is popped.
  *      LazyPopUniquePriorityQueue::empty(): Returns whether the queue is empty.
- *      LazyPopUniquePriorityQueue::clear(): Clears the priority queue vector and the tracking sets.
+ *      LazyPopUniquePriorityQueue::clear(): Clears the priority queue vector and the tracking map.
  *      LazyPopUniquePriorityQueue::size(): Returns the number of elements in the queue.
  *      LazyPopUniquePriorityQueue::contains(): Returns true if the key is in the queue, false otherwise.
  */
 
-#include <unordered_set>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 
@@ -32,8 +32,9 @@
  * and sorted by the sort value.
  * 
  * It uses a vector to store the key and sort value pair. 
- * It uses a set to store the keys that are in the vector for uniqueness checking
- * and a set to store the delete pending keys which will be removed at pop time.
+ * It uses a map from the keys that are in the vector to whether they are pending
+ * deletion, both for uniqueness checking and to remove pending keys at pop time.
+ * Every operation needs a single lookup into the map.
  */
 
 template<typename T_key, typename T_sort>
@@ -53,11 +54,12 @@ class LazyPopUniquePriorityQueue {
     /// @brief The vector maintained as heap to store the key and sort value pair.
     std::vector<std::pair<T_key, T_sort>> heap;
 
-    /// @brief The set to store the keys that are in the queue. This is used to ensure uniqueness
-    std::unordered_set<T_key> content_set;
+    /// @brief The map from the keys that are in the queue to whether the item
+    ///        is pending deletion. This is used to ensure uniqueness.
+    std::unordered_map<T_key, bool> content_map;
 
-    /// @brief The set to store the delete pending item from the queue refered by the key.
-    std::unordered_set<T_key> delete_pending_set;
+    /// @brief The number of items in the queue which are pending deletion.
+    size_t num_delete_pending = 0;
 
     /**
      * @brief Push the key and the sort value as a pair into the priority queue.
@@ -69,16 +71,15 @@ class LazyPopUniquePriorityQueue {
      */
     void push(T_key key, T_sort value) {
         // Insert the key and sort value pair into the queue if it is not already present
-        if (content_set.find(key) != content_set.end()) {
+        if (!content_map.try_emplace(key, false).second) {
             // If the key is already in the queue, do nothing
             return;
         }
-        // Insert the key and sort value pair into the heap and track the key
+        // Insert the key and sort value pair into the heap.
         // The new item is added to the end of the vector and then the push_heap function is call
         // to push the item to the correct position in the heap structure.
         heap.emplace_back(key, value);
         std::push_heap(heap.begin(), heap.end(), LazyPopUniquePriorityQueueCompare());
-        content_set.insert(key);
     }
 
     /**
@@ -90,18 +91,20 @@ class LazyPopUniquePriorityQueue {
         std::pair<T_key, T_sort> top_pair;
         while (heap.size() > 0) {
             top_pair = heap.front();
-            // Remove the key from the heap and the tracking set.
+            // Remove the key from the heap and the tracking map.
             // The pop_heap function will move the top item in the heap structure to the end of the vector container.
             // Then the pop_back function will remove the last item.
             std::pop_heap(heap.begin(), heap.end(), LazyPopUniquePriorityQueueCompare());
             heap.pop_back();
-            content_set.erase(top_pair.first);
+            auto it = content_map.find(top_pair.first);
+            bool is_delete_pending = it->second;
+            content_map.erase(it);
 
-            // Checking if the key with the highest sort value is in the delete pending set.
-            // If it is, ignore the current top item and remove the key from the delete pending set. Then get the next top item.
+            // Checking if the key with the highest sort value is pending deletion.
+            // If it is, ignore the current top item. Then get the next top item.
             // Otherwise, the top item found, break the loop.
-            if (delete_pending_set.find(top_pair.first) != delete_pending_set.end()) {
-                delete_pending_set.erase(top_pair.first);
+            if (is_delete_pending) {
+                num_delete_pending--;
                 top_pair = std::pair<T_key, T_sort>();
             } else {
                 break;
@@ -129,10 +132,12 @@ class LazyPopUniquePriorityQueue {
     void remove(T_key key) {
         // If the key is in the priority queue, remove it from the heap and reheapify.
         // Otherwise, do nothing.
-        if (content_set.find(key) != content_set.end()) {
-            content_set.erase(key);
-            delete_pending_set.erase(key);
-            for (int i = 0; i < heap.size(); i++) {
+        auto it = content_map.find(key);
+        if (it != content_map.end()) {
+            if (it->second)
+                num_delete_pending--;
+            content_map.erase(it);
+            for (size_t i = 0; i < heap.size(); i++) {
                 if (heap[i].first == key) {
                     heap.erase(heap.begin() + i);
                     break;
@@ -151,7 +156,7 @@ class LazyPopUniquePriorityQueue {
 
     /**
      * @brief Remove the item with matching key value from the priority queue at pop time.
-     *        Add the key to the delete pending set for tracking, 
+     *        Mark the key as pending deletion,
      *        and it will be deleted when it is popped.
      *      
      *        This function will not immediately delete the key from the
@@ -161,10 +166,12 @@ class LazyPopUniquePriorityQueue {
      *             The key of the item to be delected from the queue at pop time.
      */
     void remove_at_pop_time(T_key key) {
-        // If the key is in the list, start tracking it in the delete pending list.
+        // If the key is in the list and not already pending deletion, mark it as pending deletion.
         // Otherwise, do nothing.
-        if (content_set.find(key) != content_set.end()) {
-            delete_pending_set.insert(key);
+        auto it = content_map.find(key);
+        if (it != content_map.end() && !it->second) {
+            it->second = true;
+            num_delete_pending++;
 
             // If this marks the last non-pending-delete item as to-be-deleted, clear the queue
             if (empty()) {
@@ -178,19 +185,19 @@ class LazyPopUniquePriorityQueue {
      *
      *  @return True if the priority queue is empty, false otherwise.
      */
-    bool empty() {
+    bool empty() const {
         return size() == 0;
     }
 
     /**
-     * @brief Clears the priority queue and the tracking sets.
+     * @brief Clears the priority queue and the tracking map.
      *
      *  @return None
      */
     void clear() {
         heap.clear();
-        content_set.clear();
-        delete_pending_set.clear();
+        content_map.clear();
+        num_delete_pending = 0;
     }
 
     /**
@@ -198,8 +205,8 @@ class LazyPopUniquePriorityQueue {
      *
      *  @return The number of non-pending-delete items in the priority queue.
      */
-    size_t size() {
-        return heap.size() - delete_pending_set.size();
+    size_t size() const {
+        return heap.size() - num_delete_pending;
     }
 
     /**
@@ -209,7 +216,7 @@ class LazyPopUniquePriorityQueue {
      *              The key of the item.
      *  @return True if the key is in the priority queue, false otherwise.
      */
-    bool contains(T_key key) {
-        return content_set.find(key) != content_set.end();
+    bool contains(T_key key) const {
+        return content_map.find(key) != content_map.end();
     }
 };
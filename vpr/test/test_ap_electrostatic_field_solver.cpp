@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @date    October 2026
+ * @brief   Unit tests for the ElectrostaticFieldSolver
+ *
+ * Checks the field computed by the solver against the analytical solution of
+ * Poisson's equation for densities made of the cosine basis functions.
+ */
+
+#include <cmath>
+#include <numbers>
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "electrostatic_field_solver.h"
+#include "vtr_ndmatrix.h"
+
+namespace {
+
+TEST_CASE("test_ap_electrostatic_field_solver", "[vpr_ap]") {
+    constexpr size_t nx = 32;
+    constexpr size_t ny = 16;
+    constexpr double width = 40.0;
+    constexpr double height = 10.0;
+    const double pi = std::numbers::pi;
+
+    ElectrostaticFieldSolver solver(nx, ny, width, height);
+    REQUIRE(solver.bin_width() == Catch::Approx(width / nx));
+    REQUIRE(solver.bin_height() == Catch::Approx(height / ny));
+
+    vtr::NdMatrix<double, 2> density({nx, ny}, 0.0);
+    vtr::NdMatrix<double, 2> field_x;
+    vtr::NdMatrix<double, 2> field_y;
+
+    auto bin_center_x = [&](size_t i) { return (i + 0.5) * solver.bin_width(); };
+    auto bin_center_y = [&](size_t j) { return (j + 0.5) * solver.bin_height(); };
+
+    SECTION("A uniform density has no field") {
+        density.fill(3.0);
+        solver.compute_field(density, field_x, field_y);
+        for (size_t i = 0; i < nx; i++) {
+            for (size_t j = 0; j < ny; j++) {
+                REQUIRE(field_x[i][j] == Catch::Approx(0.0).margin(1e-9));
+                REQUIRE(field_y[i][j] == Catch::Approx(0.0).margin(1e-9));
+            }
+        }
+    }
+
+    SECTION("The field of a cosine density matches the analytical solution") {
+        // rho = cos(wx * x) * cos(wy * y)
+        // phi = rho / (wx^2 + wy^2)
+        // E = -grad(phi)
+        const double wx = 2.0 * pi / width;
+        const double wy = pi / height;
+        for (size_t i = 0; i < nx; i++) {
+            for (size_t j = 0; j < ny; j++) {
+                density[i][j] = std::cos(wx * bin_center_x(i)) * std::cos(wy * bin_center_y(j));
+            }
+        }
+        solver.compute_field(density, field_x, field_y);
+
+        const double phi_scale = 1.0 / (wx * wx + wy * wy);
+        for (size_t i = 0; i < nx; i++) {
+            for (size_t j = 0; j < ny; j++) {
+                double x = bin_center_x(i);
+                double y = bin_center_y(j);
+                double expected_x = phi_scale * wx * std::sin(wx * x) * std::cos(wy * y);
+                double expected_y = phi_scale * wy * std::cos(wx * x) * std::sin(wy * y);
+                REQUIRE(field_x[i][j] == Catch::Approx(expected_x).margin(1e-9));
+                REQUIRE(field_y[i][j] == Catch::Approx(expected_y).margin(1e-9));
+            }
+        }
+    }
+
+    SECTION("The field pushes charge away from a dense bin") {
+        const size_t ci = nx / 2;
+        const size_t cj = ny / 2;
+        density[ci][cj] = 1.0;
+        solver.compute_field(density, field_x, field_y);
+
+        REQUIRE(field_x[ci - 2][cj] < 0.0);
+        REQUIRE(field_x[ci + 2][cj] > 0.0);
+        REQUIRE(field_y[ci][cj - 2] < 0.0);
+        REQUIRE(field_y[ci][cj + 2] > 0.0);
+    }
+}
+
+} // namespace
@@ -0,0 +1,172 @@
+/**
+ * @file
+ * @date    October 2026
+ * @brief   Benchmark of the Bi-Partitioning Partial Legalizer against the
+ *          number of threads it may use
+ *
+ * A synthetic netlist of LUTs is clumped in the middle of the device, so the
+ * legalizer has to spread it through many levels of windows.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "ap_netlist.h"
+#include "flat_placement_density_manager.h"
+#include "gen_ap_netlist_from_atoms.h"
+#include "globals.h"
+#include "partial_legalizer.h"
+#include "partial_placement.h"
+#include "prepack.h"
+#include "setup_grid.h"
+#include "vpr_api.h"
+
+#ifdef VPR_USE_TBB
+#include <tbb/global_control.h>
+#endif
+
+namespace {
+
+static constexpr const char kArchFile[] = "test_post_verilog_arch.xml";
+static constexpr const char kCircuitFile[] = "test_ap_partial_legalizer.blif";
+
+/**
+ * @brief Writes a netlist of num_luts 4-input LUTs. Each LUT is driven by the
+ *        previous one and by random earlier signals, so no LUT is swept.
+ */
+void write_lut_circuit(const char* file_name, int num_inputs, int num_luts) {
+    std::ofstream os(file_name);
+    os << ".model lut_circuit\n";
+    os << ".inputs";
+    for (int i = 0; i < num_inputs; i++) {
+        os << " in" << i;
+    }
+    os << "\n.outputs out\n";
+
+    std::mt19937 rand_num_gen(1);
+    std::vector<std::string> signals;
+    for (int i = 0; i < num_inputs; i++) {
+        signals.push_back("in" + std::to_string(i));
+    }
+    for (int i = 0; i < num_luts; i++) {
+        std::uniform_int_distribution<size_t> signal_dist(0, signals.size() - 1);
+        os << ".names " << signals.back();
+        for (int ipin = 1; ipin < 4; ipin++) {
+            os << " " << signals[signal_dist(rand_num_gen)];
+        }
+        signals.push_back("n" + std::to_string(i));
+        os << " " << signals.back() << "\n1111 1\n";
+    }
+    os << ".names " << signals.back() << " out\n1 1\n";
+    os << ".end\n";
+}
+
+t_logical_block_type_ptr find_logical_block_type(const std::string& name) {
+    for (const t_logical_block_type& type : g_vpr_ctx.device().logical_block_types) {
+        if (type.name == name) {
+            return &type;
+        }
+    }
+    return nullptr;
+}
+
+TEST_CASE("bench_ap_partial_legalizer", "[vpr_ap][.benchmark]") {
+    constexpr int num_inputs = 64;
+    constexpr int num_luts = 10000;
+    write_lut_circuit(kCircuitFile, num_inputs, num_luts);
+
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        kCircuitFile,
+        "--analytical_place",
+        "--route_chan_width", "100"};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+    std::remove(kCircuitFile);
+
+    // Size the device for the LUTs and IOs of the circuit, as packing would.
+    std::map<t_logical_block_type_ptr, size_t> num_type_instances;
+    num_type_instances[find_logical_block_type("clb")] = num_luts / 10;
+    num_type_instances[find_logical_block_type("io")] = num_inputs + 1;
+    DeviceContext& device_ctx = g_vpr_ctx.mutable_device();
+    device_ctx.grid = create_device_grid(vpr_setup.device_layout,
+                                         arch.grid_layouts,
+                                         num_type_instances,
+                                         vpr_setup.PackerOpts.target_device_utilization);
+
+    const AtomNetlist& atom_nlist = g_vpr_ctx.atom().netlist();
+    const Prepacker prepacker(atom_nlist, arch.models, device_ctx.logical_block_types);
+    APNetlist ap_netlist = gen_ap_netlist_from_atoms(atom_nlist,
+                                                     prepacker,
+                                                     g_vpr_ctx.floorplanning().constraints,
+                                                     vpr_setup.APOpts.ap_high_fanout_threshold);
+    auto density_manager = std::make_shared<FlatPlacementDensityManager>(ap_netlist,
+                                                                         prepacker,
+                                                                         atom_nlist,
+                                                                         device_ctx.grid,
+                                                                         device_ctx.logical_block_types,
+                                                                         device_ctx.physical_tile_types,
+                                                                         arch.models,
+                                                                         vpr_setup.APOpts.ap_partial_legalizer_target_density,
+                                                                         /*log_verbosity=*/0);
+    BiPartitioningPartialLegalizer legalizer(ap_netlist, density_manager, prepacker, arch.models, /*log_verbosity=*/0);
+
+    // Clump every block in the middle quarter of the device.
+    PartialPlacement initial_placement(ap_netlist);
+    std::mt19937 rand_num_gen(2);
+    std::uniform_real_distribution<double> x_dist(device_ctx.grid.width() * 0.375, device_ctx.grid.width() * 0.625);
+    std::uniform_real_distribution<double> y_dist(device_ctx.grid.height() * 0.375, device_ctx.grid.height() * 0.625);
+    for (APBlockId blk_id : ap_netlist.blocks()) {
+        initial_placement.block_x_locs[blk_id] = x_dist(rand_num_gen);
+        initial_placement.block_y_locs[blk_id] = y_dist(rand_num_gen);
+    }
+
+    PartialPlacement serial_placement = initial_placement;
+    {
+#ifdef VPR_USE_TBB
+        tbb::global_control c(tbb::global_control::max_allowed_parallelism, 1);
+#endif
+        legalizer.legalize(serial_placement);
+    }
+
+    for (size_t num_threads : {1, 2, 4, 8}) {
+#ifdef VPR_USE_TBB
+        tbb::global_control c(tbb::global_control::max_allowed_parallelism, num_threads);
+#else
+        // Without TBB the legalizer always runs serially.
+        if (num_threads > 1) {
+            break;
+        }
+#endif
+        // The windows are merged in a fixed order, so the result does not
+        // depend on the number of threads.
+        PartialPlacement p_placement = initial_placement;
+        legalizer.legalize(p_placement);
+        for (APBlockId blk_id : ap_netlist.blocks()) {
+            REQUIRE(p_placement.block_x_locs[blk_id] == serial_placement.block_x_locs[blk_id]);
+            REQUIRE(p_placement.block_y_locs[blk_id] == serial_placement.block_y_locs[blk_id]);
+        }
+
+        // The copy of the placement is timed too; it is small next to the
+        // legalization.
+        BENCHMARK("Bi-partitioning legalizer with " + std::to_string(num_threads) + " thread(s)") {
+            PartialPlacement bench_placement = initial_placement;
+            legalizer.legalize(bench_placement);
+            return bench_placement.block_x_locs.size();
+        };
+    }
+
+    vpr_free_all(arch, vpr_setup);
+}
+
+} // namespace
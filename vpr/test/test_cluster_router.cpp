@@ -0,0 +1,214 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include "cluster_router.h"
+#include "pack_types.h"
+#include "physical_types.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief A small lb rr graph, with the storage of its edges.
+ *
+ * Two sources share a single intermediate node of capacity 1 to reach their
+ * sinks:
+ *
+ *   0 (source A) --\         /--> 3 (sink A)
+ *                   2 (mid) -
+ *   1 (source B) --/         \--> 4 (sink B)
+ */
+struct SharedNodeGraph {
+    std::vector<t_lb_type_rr_node> nodes;
+    std::vector<std::vector<t_lb_type_rr_node_edge>> edges;
+    std::vector<t_lb_type_rr_node_edge*> edge_ptrs;
+    std::vector<short> num_fanout;
+
+    SharedNodeGraph()
+        : nodes(5)
+        , edges(5)
+        , edge_ptrs(5)
+        , num_fanout(5) {
+        edges[0] = {{2, 1.}};
+        edges[1] = {{2, 1.}};
+        edges[2] = {{3, 1.}, {4, 1.}};
+
+        for (size_t inode = 0; inode < nodes.size(); inode++) {
+            num_fanout[inode] = edges[inode].size();
+            edge_ptrs[inode] = edges[inode].data();
+
+            t_lb_type_rr_node& node = nodes[inode];
+            node.capacity = 1;
+            node.num_modes = 1;
+            node.num_fanout = &num_fanout[inode];
+            node.outedges = &edge_ptrs[inode];
+            node.intrinsic_cost = 1.;
+        }
+        nodes[0].type = LB_SOURCE;
+        nodes[1].type = LB_SOURCE;
+        nodes[2].type = LB_INTERMEDIATE;
+        nodes[3].type = LB_SINK;
+        nodes[4].type = LB_SINK;
+    }
+};
+
+void add_net(t_lb_router_data* router_data, int source, int sink) {
+    t_intra_lb_net net;
+    net.terminals = {source, sink};
+    router_data->intra_lb_nets->push_back(net);
+}
+
+bool routes_are_reset(const t_lb_router_data* router_data) {
+    for (const t_intra_lb_net& net : *router_data->intra_lb_nets) {
+        if (net.rt_tree != nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("test_intra_lb_route_failure_cache", "[vpr_cluster_router]") {
+    SharedNodeGraph graph;
+    t_logical_block_type lb_type;
+    lb_type.index = 0;
+
+    IntraLbRouteFailureCache cache;
+    t_lb_router_data* router_data = alloc_and_load_router_data(&graph.nodes, &lb_type);
+    router_data->route_failure_cache = &cache;
+
+    SECTION("A cached failure gives the same result as the router") {
+        // Both nets need the intermediate node, so the route fails on congestion
+        add_net(router_data, 0, 3);
+        add_net(router_data, 1, 4);
+
+        t_mode_selection_status routed_status;
+        bool is_routed = try_intra_lb_route(router_data, 0, &routed_status);
+        REQUIRE(!is_routed);
+        REQUIRE(cache.contains(router_data->route_signature));
+        REQUIRE(routes_are_reset(router_data));
+
+        t_mode_selection_status cached_status;
+        bool is_routed_cached = try_intra_lb_route(router_data, 0, &cached_status);
+        REQUIRE(is_routed_cached == is_routed);
+        REQUIRE(cached_status.is_mode_conflict == routed_status.is_mode_conflict);
+        REQUIRE(cached_status.try_expand_all_modes == routed_status.try_expand_all_modes);
+        REQUIRE(cached_status.expand_all_modes == routed_status.expand_all_modes);
+        REQUIRE(routes_are_reset(router_data));
+
+        const std::vector<t_intra_lb_net>& nets = *router_data->intra_lb_nets;
+        REQUIRE(nets.size() == 2);
+        REQUIRE((nets[0].terminals == std::vector<int>{0, 3}));
+        REQUIRE((nets[1].terminals == std::vector<int>{1, 4}));
+        REQUIRE(router_data->saved_lb_nets == nullptr);
+    }
+
+    SECTION("A successful route is not cached") {
+        add_net(router_data, 0, 3);
+
+        t_mode_selection_status mode_status;
+        REQUIRE(try_intra_lb_route(router_data, 0, &mode_status));
+        REQUIRE(!cache.contains(router_data->route_signature));
+        REQUIRE(router_data->saved_lb_nets != nullptr);
+    }
+
+    free_router_data(router_data);
+}
+
+TEST_CASE("test_isolated_illegal_modes", "[vpr_cluster_router]") {
+    SharedNodeGraph graph;
+    t_logical_block_type lb_type;
+    lb_type.index = 0;
+
+    // The intermediate node is a pin of a pb_graph_node which already has an
+    // illegal mode, shared by every cluster of the type
+    t_pb_graph_node pb_graph_node;
+    pb_graph_node.illegal_modes = {1};
+    t_pb_graph_pin pin;
+    pin.parent_node = &pb_graph_node;
+    graph.nodes[2].pb_graph_pin = &pin;
+
+    t_lb_router_data* router_data = alloc_and_load_router_data(&graph.nodes, &lb_type);
+    isolate_illegal_modes(router_data);
+    REQUIRE(router_data->has_own_illegal_modes);
+    REQUIRE(router_data->own_illegal_modes.at(&pb_graph_node) == std::vector<int>{1});
+
+    SECTION("Resetting an isolated route does not clear the shared modes") {
+        reset_intra_lb_route(router_data);
+        REQUIRE(router_data->own_illegal_modes.empty());
+        REQUIRE(pb_graph_node.illegal_modes == std::vector<int>{1});
+
+        REQUIRE(!rejoin_illegal_modes(router_data, true));
+        REQUIRE(pb_graph_node.illegal_modes == std::vector<int>{1});
+    }
+
+    SECTION("New illegal modes are only shared when merged") {
+        // As recorded by a route of the isolated cluster
+        router_data->own_illegal_modes[&pb_graph_node].push_back(2);
+        REQUIRE(rejoin_illegal_modes(router_data, false));
+        REQUIRE(!router_data->has_own_illegal_modes);
+        REQUIRE(pb_graph_node.illegal_modes == std::vector<int>{1});
+
+        isolate_illegal_modes(router_data);
+        router_data->own_illegal_modes[&pb_graph_node].push_back(2);
+        REQUIRE(rejoin_illegal_modes(router_data, true));
+        REQUIRE((pb_graph_node.illegal_modes == std::vector<int>{1, 2}));
+    }
+
+    SECTION("Resetting a shared route clears the shared modes") {
+        REQUIRE(!rejoin_illegal_modes(router_data, true));
+        reset_intra_lb_route(router_data);
+        REQUIRE(pb_graph_node.illegal_modes.empty());
+    }
+
+    free_router_data(router_data);
+}
+
+TEST_CASE("bench_intra_lb_route_failure_cache", "[vpr_cluster_router][.benchmark]") {
+    SharedNodeGraph graph;
+    t_logical_block_type lb_type;
+    lb_type.index = 0;
+
+    IntraLbRouteFailureCache cache;
+    t_lb_router_data* router_data = alloc_and_load_router_data(&graph.nodes, &lb_type);
+    add_net(router_data, 0, 3);
+    add_net(router_data, 1, 4);
+
+    BENCHMARK("Failed route without the cache") {
+        t_mode_selection_status mode_status;
+        return try_intra_lb_route(router_data, 0, &mode_status);
+    };
+
+    router_data->route_failure_cache = &cache;
+    BENCHMARK("Failed route with the cache") {
+        t_mode_selection_status mode_status;
+        return try_intra_lb_route(router_data, 0, &mode_status);
+    };
+
+    // Lookups of a cached failure from several threads at once, as when the
+    // clusters are routed in parallel.
+    const std::vector<int> signature = router_data->route_signature;
+    const unsigned num_threads = std::max(2u, std::thread::hardware_concurrency());
+    constexpr int num_lookups = 1000;
+    BENCHMARK("Concurrent lookups of a cached failure") {
+        std::vector<std::thread> threads;
+        std::vector<int> num_found(num_threads, 0);
+        for (unsigned ithread = 0; ithread < num_threads; ithread++) {
+            threads.emplace_back([&, ithread]() {
+                for (int i = 0; i < num_lookups; i++) {
+                    num_found[ithread] += cache.contains(signature);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        return num_found[0];
+    };
+
+    free_router_data(router_data);
+}
+
+} // namespace
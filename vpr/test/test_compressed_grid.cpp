@@ -1,5 +1,6 @@
 #include "arch_util.h"
 #include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
 
 #include "compressed_grid.h"
 #include "globals.h"
@@ -39,132 +40,118 @@ void set_tile_type_at_loc(const int x_anchor, const int y_anchor, vtr::NdMatrix<
     }
 }
 
-TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
-    // test device grid name
-    std::string device_grid_name = "test";
-
-    // creating a reference for the empty tile name and router name
-    char empty_tile_name[] = "empty";
-    char io_tile_name[] = "io";
-    char small_tile_name[] = "small";
-    char tall_tile_name[] = "tall";
-    char large_tile_name[] = "large";
+/**
+ * @brief A 100x100 test device with io tiles around the perimeter and small
+ *        tiles in the core, in which some columns have tall tiles and a few
+ *        large tiles. The device and its logical block types are set in the
+ *        global device context for the lifetime of the object, and the
+ *        compressed grids are built for them.
+ */
+struct TestDevice {
+    static constexpr int grid_width = 100;
+    static constexpr int grid_height = 100;
 
-    // device grid parameters
-    const int test_grid_width = 100;
-    const int test_grid_height = 100;
+    TestDevice();
+    ~TestDevice();
 
-    // create the test device grid (10x10)
-    auto test_grid = vtr::NdMatrix<t_grid_tile, 3>({1, test_grid_width, test_grid_height});
-
-    auto& logical_block_types = g_vpr_ctx.mutable_device().logical_block_types;
-    logical_block_types.clear();
+    TestDevice(const TestDevice&) = delete;
+    TestDevice& operator=(const TestDevice&) = delete;
 
     t_physical_tile_type empty_tile;
-    empty_tile.name = empty_tile_name;
-    empty_tile.height = 1;
-    empty_tile.width = 1;
-    empty_tile.sub_tiles.emplace_back();
-
-    t_logical_block_type EMPTY_LOGICAL_BLOCK_TYPE = get_empty_logical_type();
-    EMPTY_LOGICAL_BLOCK_TYPE.index = 0;
-    EMPTY_LOGICAL_BLOCK_TYPE.equivalent_tiles.push_back(&empty_tile);
-    logical_block_types.push_back(EMPTY_LOGICAL_BLOCK_TYPE);
-
-    g_vpr_ctx.mutable_device().EMPTY_PHYSICAL_TILE_TYPE = &empty_tile;
-
-    empty_tile.sub_tiles.back().index = 0;
-    empty_tile.sub_tiles.back().equivalent_sites.push_back(&EMPTY_LOGICAL_BLOCK_TYPE);
-
-    // create an io physical tile and assign its parameters
     t_physical_tile_type io_tile;
-    io_tile.name = io_tile_name;
-    io_tile.height = 1;
-    io_tile.width = 1;
-    io_tile.sub_tiles.emplace_back();
-
-    t_logical_block_type io_logical_type;
-    io_logical_type.index = 1;
-    io_logical_type.equivalent_tiles.push_back(&io_tile);
-    logical_block_types.push_back(io_logical_type);
-
-    io_tile.sub_tiles.back().index = 0;
-    io_tile.sub_tiles.back().equivalent_sites.push_back(&io_logical_type);
-
-    // create a small tile and assign its parameters
     t_physical_tile_type small_tile;
-    small_tile.name = small_tile_name;
-    small_tile.height = 1;
-    small_tile.width = 1;
-    small_tile.sub_tiles.emplace_back();
-
-    t_logical_block_type small_logical_type;
-    small_logical_type.index = 2;
-    small_logical_type.equivalent_tiles.push_back(&small_tile);
-    logical_block_types.push_back(small_logical_type);
-
-    small_tile.sub_tiles.back().index = 0;
-    small_tile.sub_tiles.back().equivalent_sites.push_back(&small_logical_type);
-
-    // create a small tile and assign its parameters
     t_physical_tile_type tall_tile;
-    tall_tile.name = tall_tile_name;
-    tall_tile.height = 4;
-    tall_tile.width = 1;
-    tall_tile.sub_tiles.emplace_back();
+    t_physical_tile_type large_tile;
 
+    t_logical_block_type empty_logical_type;
+    t_logical_block_type io_logical_type;
+    t_logical_block_type small_logical_type;
     t_logical_block_type tall_logical_type;
-    tall_logical_type.index = 3;
-    tall_logical_type.equivalent_tiles.push_back(&tall_tile);
-    logical_block_types.push_back(tall_logical_type);
+    t_logical_block_type large_logical_type;
 
-    tall_tile.sub_tiles.back().index = 0;
-    tall_tile.sub_tiles.back().equivalent_sites.push_back(&tall_logical_type);
+    std::vector<t_compressed_block_grid> compressed_grids;
+};
+
+// Gives tile_type a single sub-tile, and logical_type the index index and tile_type as its only equivalent tile
+void init_block_type(t_physical_tile_type& tile_type,
+                     const char* name,
+                     int width,
+                     int height,
+                     t_logical_block_type& logical_type,
+                     int index) {
+    tile_type.name = name;
+    tile_type.width = width;
+    tile_type.height = height;
+    tile_type.sub_tiles.emplace_back();
+    tile_type.sub_tiles.back().index = 0;
+    tile_type.sub_tiles.back().equivalent_sites.push_back(&logical_type);
+
+    logical_type.index = index;
+    logical_type.equivalent_tiles.push_back(&tile_type);
+    g_vpr_ctx.mutable_device().logical_block_types.push_back(logical_type);
+}
 
-    t_physical_tile_type large_tile;
-    large_tile.name = large_tile_name;
-    large_tile.height = 3;
-    large_tile.width = 3;
-    large_tile.sub_tiles.emplace_back();
+TestDevice::TestDevice()
+    : empty_logical_type(get_empty_logical_type()) {
+    auto test_grid = vtr::NdMatrix<t_grid_tile, 3>({1, grid_width, grid_height});
 
-    t_logical_block_type large_logical_type;
-    large_logical_type.index = 4;
-    large_logical_type.equivalent_tiles.push_back(&large_tile);
-    logical_block_types.push_back(large_logical_type);
+    auto& logical_block_types = g_vpr_ctx.mutable_device().logical_block_types;
+    logical_block_types.clear();
+
+    init_block_type(empty_tile, "empty", 1, 1, empty_logical_type, 0);
+    g_vpr_ctx.mutable_device().EMPTY_PHYSICAL_TILE_TYPE = &empty_tile;
 
-    large_tile.sub_tiles.back().index = 0;
-    large_tile.sub_tiles.back().equivalent_sites.push_back(&large_logical_type);
+    init_block_type(io_tile, "io", 1, 1, io_logical_type, 1);
+    init_block_type(small_tile, "small", 1, 1, small_logical_type, 2);
+    init_block_type(tall_tile, "tall", 1, 4, tall_logical_type, 3);
+    init_block_type(large_tile, "large", 3, 3, large_logical_type, 4);
 
-    for (int x = 0; x < test_grid_width; x++) {
-        for (int y = 0; y < test_grid_height; y++) {
+    for (int x = 0; x < grid_width; x++) {
+        for (int y = 0; y < grid_height; y++) {
             test_grid[0][x][y].type = &io_tile;
             test_grid[0][x][y].height_offset = 0;
             test_grid[0][x][y].width_offset = 0;
         }
     }
 
-    for (int x = 1; x < test_grid_width - 1; x++) {
-        for (int y = 1; y < test_grid_height - 1; y++) {
+    for (int x = 1; x < grid_width - 1; x++) {
+        for (int y = 1; y < grid_height - 1; y++) {
             set_tile_type_at_loc(x, y, test_grid, small_tile);
         }
     }
 
-    for (int x = 7; x < test_grid_width - 7; x += 10) {
-        for (int y = 5; y < test_grid_height - 5; y += 5) {
+    for (int x = 7; x < grid_width - 7; x += 10) {
+        for (int y = 5; y < grid_height - 5; y += 5) {
             set_tile_type_at_loc(x, y, test_grid, tall_tile);
         }
     }
 
-    for (int x = 8; x < test_grid_width - 8; x += 17) {
-        for (int y = 7; y < test_grid_height - 6; y += 13) {
+    for (int x = 8; x < grid_width - 8; x += 17) {
+        for (int y = 7; y < grid_height - 6; y += 13) {
             set_tile_type_at_loc(x, y, test_grid, large_tile);
         }
     }
 
-    auto& grid = g_vpr_ctx.mutable_device().grid;
-    grid = DeviceGrid("test_device_grid", test_grid);
+    g_vpr_ctx.mutable_device().grid = DeviceGrid("test_device_grid", test_grid);
+
+    compressed_grids = create_compressed_block_grids();
+}
+
+TestDevice::~TestDevice() {
+    g_vpr_ctx.mutable_device().logical_block_types.clear();
+}
+
+TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
+    TestDevice device;
+    const int test_grid_width = TestDevice::grid_width;
+    const int test_grid_height = TestDevice::grid_height;
+    const auto& logical_block_types = g_vpr_ctx.device().logical_block_types;
+    const std::vector<t_compressed_block_grid>& compressed_grids = device.compressed_grids;
 
-    std::vector<t_compressed_block_grid> compressed_grids = create_compressed_block_grids();
+    const t_logical_block_type& io_logical_type = device.io_logical_type;
+    const t_logical_block_type& small_logical_type = device.small_logical_type;
+    const t_logical_block_type& tall_logical_type = device.tall_logical_type;
+    const t_logical_block_type& large_logical_type = device.large_logical_type;
 
     SECTION("Check compressed grid sizes") {
         REQUIRE(compressed_grids[io_logical_type.index].compressed_to_grid_x[0].size() == 100);
@@ -316,7 +303,108 @@ TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
         REQUIRE(grid_loc == t_physical_tile_loc{98, 98, 0});
     }
 
-    logical_block_types.clear();
+    SECTION("Dense lookups match the compressed coordinates") {
+        for (const t_logical_block_type& logical_type : logical_block_types) {
+            const t_compressed_block_grid& compressed_grid = compressed_grids[logical_type.index];
+            const std::vector<int>& compressed_x = compressed_grid.compressed_to_grid_x[0];
+            const std::vector<int>& compressed_y = compressed_grid.compressed_to_grid_y[0];
+            if (compressed_x.empty()) {
+                continue;
+            }
+
+            // Includes coordinates outside the grid, which are clamped to it
+            for (int x = -2; x < test_grid_width + 2; x++) {
+                int y = x * test_grid_height / test_grid_width;
+                t_physical_tile_loc round_up = compressed_grid.grid_loc_to_compressed_loc_approx_round_up({x, y, 0});
+                t_physical_tile_loc round_down = compressed_grid.grid_loc_to_compressed_loc_approx_round_down({x, y, 0});
+
+                auto up_x = std::lower_bound(compressed_x.begin(), compressed_x.end(), x);
+                REQUIRE(round_up.x == (up_x == compressed_x.end() ? (int)compressed_x.size() - 1 : up_x - compressed_x.begin()));
+                auto down_x = std::upper_bound(compressed_x.begin(), compressed_x.end(), x);
+                REQUIRE(round_down.x == (down_x == compressed_x.begin() ? 0 : down_x - compressed_x.begin() - 1));
+
+                auto up_y = std::lower_bound(compressed_y.begin(), compressed_y.end(), y);
+                REQUIRE(round_up.y == (up_y == compressed_y.end() ? (int)compressed_y.size() - 1 : up_y - compressed_y.begin()));
+                auto down_y = std::upper_bound(compressed_y.begin(), compressed_y.end(), y);
+                REQUIRE(round_down.y == (down_y == compressed_y.begin() ? 0 : down_y - compressed_y.begin() - 1));
+            }
+
+            for (int cx = 0; cx < (int)compressed_x.size(); cx++) {
+                int cy = cx % compressed_y.size();
+                t_physical_tile_loc grid_loc = compressed_grid.compressed_loc_to_grid_loc({cx, cy, 0});
+                REQUIRE(compressed_grid.grid_loc_to_compressed_loc(grid_loc) == t_physical_tile_loc{cx, cy, 0});
+            }
+        }
+    }
+
+    SECTION("Locations in a search range are counted and indexed consistently") {
+        for (const t_logical_block_type& logical_type : logical_block_types) {
+            const t_compressed_block_grid& compressed_grid = compressed_grids[logical_type.index];
+            const int num_columns = compressed_grid.get_num_columns(0);
+            const int num_rows = compressed_grid.compressed_to_grid_y[0].size();
+            if (num_columns == 0) {
+                continue;
+            }
+
+            const t_bb search_range(num_columns / 4, (3 * num_columns) / 4, num_rows / 3, (2 * num_rows) / 3, 0, 0);
+            for (bool expand_sparse_columns : {false, true}) {
+                // Count the locations in range the slow way
+                int expected_num_locs = 0;
+                for (int cx = search_range.xmin; cx <= search_range.xmax; cx++) {
+                    for (const auto& [cy, grid_loc] : compressed_grid.get_column_block_map(cx, 0)) {
+                        bool in_range = cy >= search_range.ymin && cy <= search_range.ymax;
+                        if (in_range || (expand_sparse_columns && compressed_grid.is_sparse_column(cx, 0))) {
+                            expected_num_locs++;
+                        }
+                    }
+                }
+
+                const int num_locs = compressed_grid.num_locs_in_range(search_range, search_range.xmax, 0, expand_sparse_columns);
+                REQUIRE(num_locs == expected_num_locs);
+
+                for (int index = 0; index < num_locs; index++) {
+                    t_physical_tile_loc compressed_loc = compressed_grid.loc_in_range(search_range, index, 0, expand_sparse_columns);
+                    REQUIRE(compressed_loc.x >= search_range.xmin);
+                    REQUIRE(compressed_loc.x <= search_range.xmax);
+                    REQUIRE(compressed_grid.get_column_block_map(compressed_loc.x, 0).count(compressed_loc.y) == 1);
+                    REQUIRE(compressed_grid.loc_index_in_range(search_range, compressed_loc, expand_sparse_columns) == index);
+                }
+            }
+
+            if (search_range.xmin > 0) {
+                REQUIRE(compressed_grid.loc_index_in_range(search_range, {0, 0, 0}, false) == UNDEFINED);
+            }
+        }
+    }
+}
+
+// Measures the grid <-> compressed translations done by the move generators when they
+// compute the compressed range limits of a move; run with "test_vpr [.benchmark]"
+TEST_CASE("bench_compressed_grid_range_limits", "[.benchmark][vpr_compressed_grid]") {
+    TestDevice device;
+    // The tall tiles only exist in every 10th column
+    const t_compressed_block_grid& compressed_tall_grid = device.compressed_grids[device.tall_logical_type.index];
+
+    constexpr int NUM_MOVES = 1000;
+    constexpr int RANGE_LIMIT = 10;
+    std::vector<t_physical_tile_loc> from_locs;
+    for (int imove = 0; imove < NUM_MOVES; imove++) {
+        int cx = (imove * 7) % compressed_tall_grid.get_num_columns(0);
+        int cy = (imove * 13) % compressed_tall_grid.get_num_rows(0);
+        from_locs.push_back(compressed_tall_grid.compressed_loc_to_grid_loc({cx, cy, 0}));
+    }
+
+    BENCHMARK("1000 compressed range limits") {
+        int sum = 0;
+        for (const t_physical_tile_loc& from_loc : from_locs) {
+            t_physical_tile_loc from_compressed = compressed_tall_grid.grid_loc_to_compressed_loc(from_loc);
+            t_physical_tile_loc min_loc = compressed_tall_grid.grid_loc_to_compressed_loc_approx_round_up({from_loc.x - RANGE_LIMIT, from_loc.y - RANGE_LIMIT, 0});
+            t_physical_tile_loc max_loc = compressed_tall_grid.grid_loc_to_compressed_loc_approx_round_down({from_loc.x + RANGE_LIMIT, from_loc.y + RANGE_LIMIT, 0});
+            t_physical_tile_loc centroid = compressed_tall_grid.grid_loc_to_compressed_loc_approx({from_loc.x + 3, from_loc.y - 5, 0});
+            sum += from_compressed.x + min_loc.x + max_loc.y + centroid.x;
+        }
+        return sum;
+    };
 }
 
 } // namespace
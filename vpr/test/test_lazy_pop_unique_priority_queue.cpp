@@ -0,0 +1,228 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "lazy_pop_unique_priority_queue.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief The previous implementation of LazyPopUniquePriorityQueue, which
+ *        kept the keys in the queue and the keys pending deletion in two
+ *        sets. Used as the reference the queue must behave the same as.
+ */
+class TwoSetPriorityQueue {
+  public:
+    void push(int key, float value) {
+        if (content_set.count(key)) {
+            return;
+        }
+        heap.emplace_back(key, value);
+        std::push_heap(heap.begin(), heap.end(), Compare());
+        content_set.insert(key);
+    }
+
+    std::pair<int, float> pop() {
+        std::pair<int, float> top_pair;
+        while (heap.size() > 0) {
+            top_pair = heap.front();
+            std::pop_heap(heap.begin(), heap.end(), Compare());
+            heap.pop_back();
+            content_set.erase(top_pair.first);
+            if (delete_pending_set.count(top_pair.first)) {
+                delete_pending_set.erase(top_pair.first);
+                top_pair = std::pair<int, float>();
+            } else {
+                break;
+            }
+        }
+        if (empty()) {
+            clear();
+        }
+        return top_pair;
+    }
+
+    void remove(int key) {
+        if (content_set.count(key)) {
+            content_set.erase(key);
+            delete_pending_set.erase(key);
+            for (size_t i = 0; i < heap.size(); i++) {
+                if (heap[i].first == key) {
+                    heap.erase(heap.begin() + i);
+                    break;
+                }
+            }
+            if (empty()) {
+                clear();
+            } else {
+                std::make_heap(heap.begin(), heap.end(), Compare());
+            }
+        }
+    }
+
+    void remove_at_pop_time(int key) {
+        if (content_set.count(key)) {
+            delete_pending_set.insert(key);
+            if (empty()) {
+                clear();
+            }
+        }
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void clear() {
+        heap.clear();
+        content_set.clear();
+        delete_pending_set.clear();
+    }
+
+    size_t size() const { return heap.size() - delete_pending_set.size(); }
+
+    bool contains(int key) const { return content_set.count(key) != 0; }
+
+  private:
+    struct Compare {
+        bool operator()(const std::pair<int, float>& a, const std::pair<int, float>& b) const {
+            return a.second < b.second;
+        }
+    };
+
+    std::vector<std::pair<int, float>> heap;
+    std::unordered_set<int> content_set;
+    std::unordered_set<int> delete_pending_set;
+};
+
+void require_same_state(const LazyPopUniquePriorityQueue<int, float>& queue,
+                        const TwoSetPriorityQueue& reference,
+                        int num_keys) {
+    REQUIRE(queue.size() == reference.size());
+    REQUIRE(queue.empty() == reference.empty());
+    for (int key = 0; key < num_keys; key++) {
+        REQUIRE(queue.contains(key) == reference.contains(key));
+    }
+}
+
+TEST_CASE("test_lazy_pop_unique_priority_queue", "[vpr_util]") {
+    LazyPopUniquePriorityQueue<int, float> queue;
+
+    SECTION("Items pop by decreasing sort value and keys are unique") {
+        queue.push(1, 1.f);
+        queue.push(2, 3.f);
+        queue.push(3, 2.f);
+        queue.push(2, 10.f);
+        REQUIRE(queue.size() == 3);
+
+        REQUIRE(queue.pop() == std::make_pair(2, 3.f));
+        REQUIRE(queue.pop() == std::make_pair(3, 2.f));
+        REQUIRE(queue.pop() == std::make_pair(1, 1.f));
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("Items removed at pop time are skipped") {
+        queue.push(1, 1.f);
+        queue.push(2, 3.f);
+        queue.push(3, 2.f);
+
+        // Marking a key twice only removes it once
+        queue.remove_at_pop_time(2);
+        queue.remove_at_pop_time(2);
+        REQUIRE(queue.size() == 2);
+        REQUIRE(queue.contains(2));
+
+        REQUIRE(queue.pop() == std::make_pair(3, 2.f));
+        REQUIRE(!queue.contains(2));
+        REQUIRE(queue.size() == 1);
+        REQUIRE(queue.pop() == std::make_pair(1, 1.f));
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("Removing a key pending deletion removes it once") {
+        queue.push(1, 1.f);
+        queue.push(2, 3.f);
+        queue.push(3, 2.f);
+
+        queue.remove_at_pop_time(2);
+        queue.remove(2);
+        REQUIRE(queue.size() == 2);
+        REQUIRE(!queue.contains(2));
+
+        // The key can be pushed again, and is not pending deletion anymore
+        queue.push(2, 0.f);
+        REQUIRE(queue.size() == 3);
+        REQUIRE(queue.pop() == std::make_pair(3, 2.f));
+        REQUIRE(queue.pop() == std::make_pair(1, 1.f));
+        REQUIRE(queue.pop() == std::make_pair(2, 0.f));
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("Marking the last item for deletion empties the queue") {
+        queue.push(1, 1.f);
+        queue.push(2, 3.f);
+        queue.remove_at_pop_time(1);
+        queue.remove_at_pop_time(2);
+        REQUIRE(queue.empty());
+        REQUIRE(!queue.contains(1));
+        REQUIRE(!queue.contains(2));
+        REQUIRE(queue.heap.empty());
+    }
+
+    SECTION("Random operations match the two set implementation") {
+        // A few keys and sort values, so that keys are pushed again, marked
+        // and removed while they are in the queue, and sort values tie.
+        constexpr int num_keys = 16;
+        constexpr int num_operations = 20000;
+        std::mt19937 rand_num_gen(1);
+        std::uniform_int_distribution<int> operation_dist(0, 9);
+        std::uniform_int_distribution<int> key_dist(0, num_keys - 1);
+        std::uniform_int_distribution<int> value_dist(0, 4);
+
+        TwoSetPriorityQueue reference;
+        for (int i = 0; i < num_operations; i++) {
+            int key = key_dist(rand_num_gen);
+            switch (operation_dist(rand_num_gen)) {
+                case 0:
+                case 1:
+                case 2:
+                case 3: {
+                    float value = value_dist(rand_num_gen);
+                    queue.push(key, value);
+                    reference.push(key, value);
+                    break;
+                }
+                case 4:
+                case 5:
+                    REQUIRE(queue.pop() == reference.pop());
+                    break;
+                case 6:
+                    queue.remove(key);
+                    reference.remove(key);
+                    break;
+                case 7:
+                case 8:
+                    queue.remove_at_pop_time(key);
+                    reference.remove_at_pop_time(key);
+                    break;
+                default:
+                    if (i % 50 == 0) {
+                        queue.clear();
+                        reference.clear();
+                    }
+                    break;
+            }
+            require_same_state(queue, reference, num_keys);
+        }
+
+        while (!reference.empty()) {
+            REQUIRE(queue.pop() == reference.pop());
+            require_same_state(queue, reference, num_keys);
+        }
+        REQUIRE(queue.empty());
+    }
+}
+
+} // namespace
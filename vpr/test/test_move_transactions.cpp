@@ -0,0 +1,281 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include "blk_loc_registry.h"
+#include "globals.h"
+#include "move_transactions.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+
+namespace {
+
+constexpr int GRID_SIZE = 16;
+constexpr int NUM_SUB_TILES = 2;
+
+// Places one block at sub-tile 0 of every location of a GRID_SIZE x GRID_SIZE grid
+void init_blk_loc_registry(BlkLocRegistry& blk_loc_registry) {
+    GridBlock& grid_blocks = blk_loc_registry.mutable_grid_blocks();
+    grid_blocks = GridBlock(GRID_SIZE, GRID_SIZE, 1);
+
+    auto& block_locs = blk_loc_registry.mutable_block_locs();
+    block_locs.clear();
+
+    for (int x = 0; x < GRID_SIZE; x++) {
+        for (int y = 0; y < GRID_SIZE; y++) {
+            grid_blocks.initialized_grid_block_at_location({x, y, 0}, NUM_SUB_TILES);
+
+            ClusterBlockId blk(x * GRID_SIZE + y);
+            t_block_loc blk_loc;
+            blk_loc.loc = t_pl_loc(x, y, 0, 0);
+            block_locs.insert(blk, blk_loc);
+            grid_blocks.set_block_at_location(blk_loc.loc, blk);
+        }
+    }
+}
+
+ClusterBlockId block_at(int x, int y) {
+    return ClusterBlockId(x * GRID_SIZE + y);
+}
+
+// The locations emptied by a move, computed with ordered sets
+std::vector<t_pl_loc> reference_emptied_locs(const t_pl_blocks_to_be_moved& blocks_affected) {
+    std::set<t_pl_loc> moved_from_set;
+    std::set<t_pl_loc> moved_to_set;
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        moved_from_set.emplace(moved_block.old_loc);
+        moved_to_set.emplace(moved_block.new_loc);
+    }
+
+    std::vector<t_pl_loc> empty_locs;
+    std::set_difference(moved_from_set.begin(), moved_from_set.end(),
+                        moved_to_set.begin(), moved_to_set.end(),
+                        std::back_inserter(empty_locs));
+    return empty_locs;
+}
+
+TEST_CASE("test_record_block_move", "[vpr_move_transactions]") {
+    BlkLocRegistry blk_loc_registry;
+    init_blk_loc_registry(blk_loc_registry);
+
+    t_pl_blocks_to_be_moved blocks_affected(GRID_SIZE * GRID_SIZE);
+
+    SECTION("swap") {
+        REQUIRE(blocks_affected.record_block_move(block_at(0, 0), {1, 1, 0, 0}, blk_loc_registry) == e_block_move_result::VALID);
+        REQUIRE(blocks_affected.record_block_move(block_at(1, 1), {0, 0, 0, 0}, blk_loc_registry) == e_block_move_result::VALID);
+
+        REQUIRE(blocks_affected.moved_blocks.size() == 2);
+        REQUIRE(blocks_affected.is_moved_from({0, 0, 0, 0}));
+        REQUIRE(blocks_affected.is_moved_to({0, 0, 0, 0}));
+        REQUIRE(!blocks_affected.is_moved_from({0, 0, 1, 0}));
+        REQUIRE(!blocks_affected.is_moved_to({2, 2, 0, 0}));
+
+        REQUIRE(blocks_affected.determine_locations_emptied_by_move().empty());
+    }
+
+    SECTION("duplicate moves are aborted") {
+        REQUIRE(blocks_affected.record_block_move(block_at(0, 0), {1, 1, 1, 0}, blk_loc_registry) == e_block_move_result::VALID);
+        REQUIRE(blocks_affected.record_block_move(block_at(2, 2), {1, 1, 1, 0}, blk_loc_registry) == e_block_move_result::ABORT);
+        REQUIRE(blocks_affected.record_block_move(block_at(0, 0), {3, 3, 1, 0}, blk_loc_registry) == e_block_move_result::ABORT);
+
+        // The aborted moves must not be recorded
+        REQUIRE(blocks_affected.moved_blocks.size() == 1);
+        REQUIRE(!blocks_affected.is_moved_to({3, 3, 1, 0}));
+        REQUIRE(!blocks_affected.is_moved_from({2, 2, 0, 0}));
+
+        const std::vector<t_pl_loc>& empty_locs = blocks_affected.determine_locations_emptied_by_move();
+        REQUIRE(empty_locs.size() == 1);
+        REQUIRE(empty_locs[0] == t_pl_loc(0, 0, 0, 0));
+    }
+
+    SECTION("clear") {
+        REQUIRE(blocks_affected.record_block_move(block_at(0, 0), {1, 1, 1, 0}, blk_loc_registry) == e_block_move_result::VALID);
+        blocks_affected.clear_move_blocks();
+
+        REQUIRE(blocks_affected.moved_blocks.empty());
+        REQUIRE(!blocks_affected.is_moved_from({0, 0, 0, 0}));
+        REQUIRE(!blocks_affected.is_moved_to({1, 1, 1, 0}));
+        REQUIRE(blocks_affected.record_block_move(block_at(0, 0), {1, 1, 1, 0}, blk_loc_registry) == e_block_move_result::VALID);
+    }
+
+    SECTION("moved blocks filled in directly") {
+        blocks_affected.moved_blocks.resize(1);
+        blocks_affected.moved_blocks[0] = t_pl_moved_block(block_at(0, 0), {0, 0, 0, 0}, {1, 1, 1, 0});
+
+        REQUIRE(blocks_affected.is_moved_from({0, 0, 0, 0}));
+        REQUIRE(blocks_affected.is_moved_to({1, 1, 1, 0}));
+        REQUIRE(blocks_affected.record_block_move(block_at(2, 2), {1, 1, 1, 0}, blk_loc_registry) == e_block_move_result::ABORT);
+    }
+}
+
+TEST_CASE("test_determine_locations_emptied_by_move", "[vpr_move_transactions]") {
+    BlkLocRegistry blk_loc_registry;
+    init_blk_loc_registry(blk_loc_registry);
+
+    t_pl_blocks_to_be_moved blocks_affected(GRID_SIZE * GRID_SIZE);
+
+    std::mt19937 rand_num_gen(1);
+    std::uniform_int_distribution<int> coord_dist(0, GRID_SIZE - 1);
+    std::uniform_int_distribution<int> sub_tile_dist(0, NUM_SUB_TILES - 1);
+    std::uniform_int_distribution<int> num_blocks_dist(1, 3 * GRID_SIZE);
+
+    // Random (possibly aborted) multi-block moves, as a macro move would record them
+    for (int imove = 0; imove < 1000; imove++) {
+        int num_blocks = num_blocks_dist(rand_num_gen);
+        for (int iblk = 0; iblk < num_blocks; iblk++) {
+            ClusterBlockId blk = block_at(coord_dist(rand_num_gen), coord_dist(rand_num_gen));
+            t_pl_loc to(coord_dist(rand_num_gen), coord_dist(rand_num_gen), sub_tile_dist(rand_num_gen), 0);
+            blocks_affected.record_block_move(blk, to, blk_loc_registry);
+        }
+
+        REQUIRE(blocks_affected.determine_locations_emptied_by_move() == reference_emptied_locs(blocks_affected));
+
+        blocks_affected.clear_move_blocks();
+    }
+}
+
+TEST_CASE("test_move_journal_rollback", "[vpr_move_transactions]") {
+    // apply_move_blocks() and rollback_move_journal() look up the tile types in the device grid
+    t_physical_tile_type tile;
+    tile.name = "tile";
+    tile.width = 1;
+    tile.height = 1;
+    tile.capacity = NUM_SUB_TILES;
+
+    auto test_grid = vtr::NdMatrix<t_grid_tile, 3>({1, GRID_SIZE, GRID_SIZE});
+    for (int x = 0; x < GRID_SIZE; x++) {
+        for (int y = 0; y < GRID_SIZE; y++) {
+            test_grid[0][x][y].type = &tile;
+            test_grid[0][x][y].width_offset = 0;
+            test_grid[0][x][y].height_offset = 0;
+        }
+    }
+    g_vpr_ctx.mutable_device().grid = DeviceGrid("test_device_grid", test_grid);
+
+    BlkLocRegistry blk_loc_registry;
+    init_blk_loc_registry(blk_loc_registry);
+
+    t_pl_blocks_to_be_moved blocks_affected(GRID_SIZE * GRID_SIZE);
+
+    std::mt19937 rand_num_gen(1);
+    std::uniform_int_distribution<int> coord_dist(0, GRID_SIZE - 1);
+    std::uniform_int_distribution<int> sub_tile_dist(0, NUM_SUB_TILES - 1);
+
+    // Moves a random block to a random location, swapping with the block there (if any)
+    auto do_random_move = [&](bool commit) {
+        ClusterBlockId blk = block_at(coord_dist(rand_num_gen), coord_dist(rand_num_gen));
+        t_pl_loc from = blk_loc_registry.block_locs()[blk].loc;
+        t_pl_loc to(coord_dist(rand_num_gen), coord_dist(rand_num_gen), sub_tile_dist(rand_num_gen), 0);
+
+        if (blocks_affected.record_block_move(blk, to, blk_loc_registry) == e_block_move_result::VALID) {
+            ClusterBlockId other_blk = blk_loc_registry.grid_blocks().block_at_location(to);
+            if (other_blk && other_blk != blk) {
+                blocks_affected.record_block_move(other_blk, from, blk_loc_registry);
+            }
+
+            blk_loc_registry.apply_move_blocks(blocks_affected);
+            if (commit) {
+                blk_loc_registry.commit_move_blocks(blocks_affected);
+            } else {
+                blk_loc_registry.revert_move_blocks(blocks_affected);
+            }
+        }
+        blocks_affected.clear_move_blocks();
+    };
+
+    auto require_same_placement = [&](const vtr::vector_map<ClusterBlockId, t_block_loc>& expected_block_locs) {
+        for (int iblk = 0; iblk < GRID_SIZE * GRID_SIZE; iblk++) {
+            ClusterBlockId blk(iblk);
+            const t_pl_loc& loc = blk_loc_registry.block_locs()[blk].loc;
+            REQUIRE(loc == expected_block_locs[blk].loc);
+            REQUIRE(blk_loc_registry.grid_blocks().block_at_location(loc) == blk);
+        }
+
+        int num_placed_sub_tiles = 0;
+        for (int x = 0; x < GRID_SIZE; x++) {
+            for (int y = 0; y < GRID_SIZE; y++) {
+                num_placed_sub_tiles += blk_loc_registry.grid_blocks().get_usage({x, y, 0});
+            }
+        }
+        REQUIRE(num_placed_sub_tiles == GRID_SIZE * GRID_SIZE);
+    };
+
+    for (int imove = 0; imove < 100; imove++) {
+        do_random_move(true);
+    }
+
+    // Checkpoint, then make both committed and reverted moves
+    blk_loc_registry.start_move_journal();
+    const vtr::vector_map<ClusterBlockId, t_block_loc> checkpoint_block_locs = blk_loc_registry.block_locs();
+
+    for (int imove = 0; imove < 1000; imove++) {
+        do_random_move(imove % 3 != 0);
+    }
+
+    blk_loc_registry.rollback_move_journal();
+    require_same_placement(checkpoint_block_locs);
+
+    // The journal is restarted by a rollback
+    for (int imove = 0; imove < 10; imove++) {
+        do_random_move(true);
+    }
+    blk_loc_registry.rollback_move_journal();
+    require_same_placement(checkpoint_block_locs);
+
+    // Moves made after the journal is stopped are not recorded
+    blk_loc_registry.stop_move_journal();
+    REQUIRE(!blk_loc_registry.move_journal_active());
+
+    g_vpr_ctx.mutable_device().grid = DeviceGrid();
+}
+
+// Measures the number of proposed moves per second; run with "test_vpr [.benchmark]"
+TEST_CASE("bench_move_transactions", "[.benchmark][vpr_move_transactions]") {
+    BlkLocRegistry blk_loc_registry;
+    init_blk_loc_registry(blk_loc_registry);
+
+    t_pl_blocks_to_be_moved blocks_affected(GRID_SIZE * GRID_SIZE);
+
+    std::mt19937 rand_num_gen(1);
+    std::uniform_int_distribution<int> coord_dist(0, GRID_SIZE - 1);
+
+    constexpr int NUM_MOVES = 1000;
+    std::vector<std::pair<t_pl_loc, t_pl_loc>> swaps;
+    for (int imove = 0; imove < NUM_MOVES; imove++) {
+        swaps.emplace_back(t_pl_loc(coord_dist(rand_num_gen), coord_dist(rand_num_gen), 0, 0),
+                           t_pl_loc(coord_dist(rand_num_gen), coord_dist(rand_num_gen), 0, 0));
+    }
+
+    BENCHMARK("1000 two-block swaps") {
+        size_t num_empty_locs = 0;
+        for (const auto& [from, to] : swaps) {
+            blocks_affected.record_block_move(block_at(from.x, from.y), to, blk_loc_registry);
+            blocks_affected.record_block_move(block_at(to.x, to.y), from, blk_loc_registry);
+            num_empty_locs += blocks_affected.determine_locations_emptied_by_move().size();
+            blocks_affected.clear_move_blocks();
+        }
+        return num_empty_locs;
+    };
+
+    // A macro sized move: the blocks of an 8x8 region move to the free
+    // sub-tiles of the region next to them
+    constexpr int REGION_SIZE = 8;
+    BENCHMARK("1000 64-block moves") {
+        size_t num_empty_locs = 0;
+        for (int imove = 0; imove < NUM_MOVES; imove++) {
+            int x_offset = imove % (GRID_SIZE - REGION_SIZE);
+            for (int x = 0; x < REGION_SIZE; x++) {
+                for (int y = 0; y < REGION_SIZE; y++) {
+                    blocks_affected.record_block_move(block_at(x, y), {x + x_offset + 1, y, 1, 0}, blk_loc_registry);
+                }
+            }
+            num_empty_locs += blocks_affected.determine_locations_emptied_by_move().size();
+            blocks_affected.clear_move_blocks();
+        }
+        return num_empty_locs;
+    };
+}
+
+} // namespace
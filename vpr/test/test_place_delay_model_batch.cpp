@@ -0,0 +1,54 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "delta_delay_model.h"
+
+namespace {
+
+TEST_CASE("test_delta_delay_model_batch", "[vpr]") {
+    constexpr size_t kDimLayer = 2;
+    constexpr size_t kDimX = 10;
+    constexpr size_t kDimY = 7;
+    vtr::NdMatrix<float, 4> delays;
+    delays.resize({kDimLayer, kDimLayer, kDimX, kDimY});
+
+    for (size_t from_layer = 0; from_layer < kDimLayer; ++from_layer) {
+        for (size_t to_layer = 0; to_layer < kDimLayer; ++to_layer) {
+            for (size_t x = 0; x < kDimX; ++x) {
+                for (size_t y = 0; y < kDimY; ++y) {
+                    delays[from_layer][to_layer][x][y] = from_layer * 1000 + to_layer * 100 + x * 10 + y;
+                }
+            }
+        }
+    }
+
+    DeltaDelayModel model(/*min_cross_layer_delay=*/0., std::move(delays), /*is_flat=*/false);
+
+    t_place_delay_batch batch;
+    for (int from_layer = 0; from_layer < (int)kDimLayer; ++from_layer) {
+        for (int to_layer = 0; to_layer < (int)kDimLayer; ++to_layer) {
+            for (int from_x = 0; from_x < (int)kDimX; from_x += 3) {
+                for (int to_x = 0; to_x < (int)kDimX; ++to_x) {
+                    for (int from_y = 0; from_y < (int)kDimY; from_y += 2) {
+                        for (int to_y = 0; to_y < (int)kDimY; ++to_y) {
+                            batch.add({from_x, from_y, from_layer}, 0, {to_x, to_y, to_layer}, 1);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    model.delays(batch);
+
+    REQUIRE(batch.delays.size() == batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        CHECK(batch.delays[i] == model.delay(batch.from_locs[i], batch.from_pins[i], batch.to_locs[i], batch.to_pins[i]));
+    }
+
+    // Clearing keeps nothing from the previous batch
+    batch.clear();
+    model.delays(batch);
+    REQUIRE(batch.delays.empty());
+}
+
+} // namespace
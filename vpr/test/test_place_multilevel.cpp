@@ -0,0 +1,135 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "clustered_netlist.h"
+#include "place_multilevel.h"
+#include "vpr_types.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int CHAIN_LENGTH = 16;
+
+// Creates a block with a single output pin (logical pin 0) and a single input pin (logical pin 1)
+ClusterBlockId create_test_block(ClusteredNetlist& netlist, const std::string& name, t_pb* pb, t_logical_block_type_ptr type) {
+    ClusterBlockId blk = netlist.create_block(name.c_str(), pb, type);
+    netlist.create_port(blk, "O", 1, PortType::OUTPUT);
+    netlist.create_port(blk, "I", 1, PortType::INPUT);
+    return blk;
+}
+
+// Connects the output of driver to the input of sink
+void create_test_net(ClusteredNetlist& netlist, ClusterBlockId driver, ClusterBlockId sink) {
+    ClusterNetId net = netlist.create_net(netlist.block_name(driver) + "_to_" + netlist.block_name(sink));
+    netlist.create_pin(netlist.find_port(driver, "O"), 0, net, PinType::DRIVER, 0);
+    netlist.create_pin(netlist.find_port(sink, "I"), 0, net, PinType::SINK, 1);
+}
+
+TEST_CASE("test_coarsen_placement_netlist", "[vpr_place_multilevel]") {
+    t_physical_tile_type tile;
+    tile.num_pins = 2;
+
+    t_logical_block_type clb_type;
+    clb_type.name = "clb";
+    clb_type.index = 0;
+    clb_type.equivalent_tiles.push_back(&tile);
+
+    t_logical_block_type io_type;
+    io_type.name = "io";
+    io_type.index = 1;
+    io_type.equivalent_tiles.push_back(&tile);
+
+    t_pb pb;
+
+    // Two independent chains of clbs, each driven by an io
+    ClusteredNetlist netlist("test_netlist", "1");
+    std::vector<std::vector<ClusterBlockId>> chains(2);
+    std::vector<ClusterBlockId> ios;
+    for (int ichain = 0; ichain < 2; ichain++) {
+        ios.push_back(create_test_block(netlist, "io" + std::to_string(ichain), &pb, &io_type));
+        for (int iblk = 0; iblk < CHAIN_LENGTH; iblk++) {
+            chains[ichain].push_back(create_test_block(netlist, "clb" + std::to_string(ichain) + "_" + std::to_string(iblk), &pb, &clb_type));
+            create_test_net(netlist, iblk == 0 ? ios[ichain] : chains[ichain][iblk - 1], chains[ichain][iblk]);
+        }
+    }
+
+    vtr::vector_map<ClusterBlockId, bool> is_movable(netlist.blocks().size(), true);
+
+    SECTION("groups are connected blocks of the same type") {
+        const std::vector<t_place_coarse_level> levels = coarsen_placement_netlist(netlist, is_movable, 8);
+
+        // Pairs of groups are merged along the chains until each chain is a single group.
+        // The ios have no other io to merge with, and coarsening stops once nothing is merged.
+        REQUIRE(levels.size() == 4);
+        const std::vector<size_t> expected_num_groups = {18, 10, 6, 4};
+        for (size_t ilevel = 0; ilevel < levels.size(); ilevel++) {
+            REQUIRE(levels[ilevel].groups.size() == expected_num_groups[ilevel]);
+        }
+
+        for (size_t ilevel = 0; ilevel < levels.size(); ilevel++) {
+            const t_place_coarse_level& level = levels[ilevel];
+
+            // Every block belongs to exactly one group
+            size_t num_grouped_blocks = 0;
+            for (size_t igroup = 0; igroup < level.groups.size(); igroup++) {
+                const std::vector<ClusterBlockId>& group = level.groups[igroup];
+                REQUIRE(!group.empty());
+                for (ClusterBlockId blk : group) {
+                    REQUIRE(level.block_group[blk] == (int)igroup);
+                    REQUIRE(netlist.block_type(blk) == netlist.block_type(group[0]));
+                }
+                num_grouped_blocks += group.size();
+            }
+            REQUIRE(num_grouped_blocks == netlist.blocks().size());
+
+            // Groups never span both chains
+            for (ClusterBlockId blk0 : chains[0]) {
+                for (ClusterBlockId blk1 : chains[1]) {
+                    REQUIRE(level.block_group[blk0] != level.block_group[blk1]);
+                }
+            }
+
+            // Each group is made of whole groups of the previous level
+            if (ilevel > 0) {
+                const t_place_coarse_level& prev_level = levels[ilevel - 1];
+                for (const std::vector<ClusterBlockId>& prev_group : prev_level.groups) {
+                    for (ClusterBlockId blk : prev_group) {
+                        REQUIRE(level.block_group[blk] == level.block_group[prev_group[0]]);
+                    }
+                }
+            }
+        }
+
+        // The coarsest level has a single group for each chain
+        for (const std::vector<ClusterBlockId>& chain : chains) {
+            REQUIRE(levels.back().groups[levels.back().block_group[chain[0]]].size() == CHAIN_LENGTH);
+        }
+    }
+
+    SECTION("blocks which are not movable are not grouped") {
+        is_movable[chains[0][5]] = false;
+        is_movable[ios[1]] = false;
+
+        const std::vector<t_place_coarse_level> levels = coarsen_placement_netlist(netlist, is_movable, 8);
+        REQUIRE(!levels.empty());
+
+        for (const t_place_coarse_level& level : levels) {
+            REQUIRE(level.block_group[chains[0][5]] == UNDEFINED);
+            REQUIRE(level.block_group[ios[1]] == UNDEFINED);
+
+            for (const std::vector<ClusterBlockId>& group : level.groups) {
+                for (ClusterBlockId blk : group) {
+                    REQUIRE(is_movable[blk]);
+                }
+            }
+        }
+    }
+
+    SECTION("the number of levels is limited") {
+        REQUIRE(coarsen_placement_netlist(netlist, is_movable, 0).empty());
+        REQUIRE(coarsen_placement_netlist(netlist, is_movable, 2).size() == 2);
+    }
+}
+
+} // namespace
@@ -0,0 +1,200 @@
+/**
+ * @file
+ * @date    October 2026
+ * @brief   Unit tests for the batched Q-table updates and the saved state of
+ *          the placer's RL agents
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "globals.h"
+#include "simpleRL_move_generator.h"
+#include "vtr_random.h"
+
+namespace {
+
+/// @brief One line of an agent state written by KArmedBanditAgent::write_state.
+struct AgentStateEntry {
+    int move_type;
+    int blk_type;
+    float q;
+    size_t num_chosen;
+};
+
+std::vector<AgentStateEntry> parse_agent_state(const std::string& state) {
+    std::istringstream is(state);
+    size_t num_actions = 0;
+    is >> num_actions;
+
+    std::vector<AgentStateEntry> entries(num_actions);
+    for (AgentStateEntry& entry : entries) {
+        is >> entry.move_type >> entry.blk_type >> entry.q >> entry.num_chosen;
+    }
+    REQUIRE(is);
+    return entries;
+}
+
+std::string agent_state(KArmedBanditAgent& agent) {
+    std::ostringstream os;
+    agent.write_state(os);
+    return os.str();
+}
+
+/**
+ * @brief Proposes num_moves actions and rewards each of them. The rewards
+ *        only depend on the move number, so agents which propose the same
+ *        actions receive the same rewards.
+ */
+void run_moves(KArmedBanditAgent& agent, int first_move, int num_moves) {
+    for (int imove = first_move; imove < first_move + num_moves; imove++) {
+        agent.propose_action();
+        double reward = (imove % 7) * 0.25 - 0.5;
+        agent.process_outcome(reward, e_reward_function::BASIC);
+    }
+}
+
+TEST_CASE("test_rl_agent", "[vpr_place]") {
+    // The agents only need the logical block types: an empty type and two
+    // types with movable blocks.
+    auto& logical_block_types = g_vpr_ctx.mutable_device().logical_block_types;
+    logical_block_types.clear();
+    logical_block_types.resize(3);
+    for (size_t i = 0; i < logical_block_types.size(); i++) {
+        logical_block_types[i].index = i;
+    }
+    const std::vector<int> num_movable_blocks_per_type = {0, 30, 10};
+    const std::vector<e_move_type> available_moves = {e_move_type::UNIFORM,
+                                                      e_move_type::MEDIAN,
+                                                      e_move_type::CENTROID};
+
+    // With an epsilon of 1 the agents always explore, so the actions they
+    // propose only depend on the random numbers and not on the Q-table.
+    constexpr float epsilon = 1.f;
+    constexpr int batch_size = 8;
+    // Not a multiple of the batch size, so the last batch is still pending
+    // when the state is written.
+    constexpr int num_moves = 100;
+
+    vtr::RngContainer rng(1);
+    EpsilonGreedyAgent agent(available_moves, e_agent_space::MOVE_BLOCK_TYPE, epsilon, rng, num_movable_blocks_per_type);
+    run_moves(agent, 0, num_moves);
+
+    SECTION("Batched updates give the same Q-table as sequential updates") {
+        vtr::RngContainer batch_rng(1);
+        EpsilonGreedyAgent batch_agent(available_moves, e_agent_space::MOVE_BLOCK_TYPE, epsilon, batch_rng, num_movable_blocks_per_type);
+        batch_agent.set_batch_size(batch_size);
+        run_moves(batch_agent, 0, num_moves);
+
+        // The incremental average is exact under batching, up to rounding.
+        // Writing the state applies the rewards of the pending batch.
+        std::vector<AgentStateEntry> entries = parse_agent_state(agent_state(agent));
+        std::vector<AgentStateEntry> batch_entries = parse_agent_state(agent_state(batch_agent));
+        REQUIRE(entries.size() == available_moves.size() * 2);
+        REQUIRE(batch_entries.size() == entries.size());
+        size_t num_chosen = 0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            REQUIRE(batch_entries[i].move_type == entries[i].move_type);
+            REQUIRE(batch_entries[i].blk_type == entries[i].blk_type);
+            REQUIRE(batch_entries[i].num_chosen == entries[i].num_chosen);
+            REQUIRE(batch_entries[i].q == Catch::Approx(entries[i].q).margin(1e-6));
+            num_chosen += entries[i].num_chosen;
+        }
+        REQUIRE(num_chosen == num_moves);
+    }
+
+    SECTION("The agent state round-trips through write and read") {
+        std::string state = agent_state(agent);
+
+        vtr::RngContainer warm_rng(1);
+        EpsilonGreedyAgent warm_agent(available_moves, e_agent_space::MOVE_BLOCK_TYPE, epsilon, warm_rng, num_movable_blocks_per_type);
+        std::istringstream is(state);
+        REQUIRE(warm_agent.read_state(is));
+        REQUIRE(agent_state(warm_agent) == state);
+
+        // The warm-started agent continues exactly like the agent it was
+        // saved from.
+        rng.srandom(2);
+        warm_rng.srandom(2);
+        run_moves(agent, num_moves, num_moves);
+        run_moves(warm_agent, num_moves, num_moves);
+        REQUIRE(agent_state(warm_agent) == agent_state(agent));
+    }
+
+    SECTION("A state with different actions is not read") {
+        vtr::RngContainer other_rng(1);
+        EpsilonGreedyAgent other_agent(available_moves, e_agent_space::MOVE_TYPE, epsilon, other_rng, num_movable_blocks_per_type);
+        std::string other_state = agent_state(other_agent);
+
+        std::istringstream is(agent_state(agent));
+        REQUIRE(!other_agent.read_state(is));
+        REQUIRE(agent_state(other_agent) == other_state);
+    }
+
+    SECTION("The greedy action is updated after each batch") {
+        vtr::RngContainer greedy_rng(1);
+        EpsilonGreedyAgent greedy_agent(available_moves, e_agent_space::MOVE_BLOCK_TYPE, /*epsilon=*/0.f, greedy_rng, num_movable_blocks_per_type);
+        greedy_agent.set_batch_size(batch_size);
+
+        // Every move is penalized, so the greedy action changes after each
+        // batch to an action which has not been tried yet.
+        std::vector<size_t> greedy_actions;
+        for (int ibatch = 0; ibatch < 4; ibatch++) {
+            // At a batch boundary no rewards are pending, so this is the
+            // Q-table the greedy action is chosen from.
+            std::vector<AgentStateEntry> entries = parse_agent_state(agent_state(greedy_agent));
+            size_t greedy = 0;
+            for (size_t i = 1; i < entries.size(); i++) {
+                if (entries[i].q > entries[greedy].q) {
+                    greedy = i;
+                }
+            }
+            greedy_actions.push_back(greedy);
+
+            for (int imove = 0; imove < batch_size; imove++) {
+                t_propose_action action = greedy_agent.propose_action();
+                REQUIRE((int)action.move_type == entries[greedy].move_type);
+                REQUIRE(action.logical_blk_type_index == entries[greedy].blk_type);
+                greedy_agent.process_outcome(-1., e_reward_function::BASIC);
+            }
+        }
+        for (size_t i = 1; i < greedy_actions.size(); i++) {
+            REQUIRE(greedy_actions[i] != greedy_actions[i - 1]);
+        }
+    }
+
+    SECTION("The softmax action probabilities are updated after each batch") {
+        // The sequential agent recomputes its action probabilities from its
+        // Q-table on every proposal. It is not given any rewards, and is
+        // loaded with the Q-table of the batched agent instead, so both agents
+        // sample from the same probabilities when the batched agent's are up
+        // to date.
+        vtr::RngContainer batch_rng(1);
+        SoftmaxAgent batch_agent(available_moves, e_agent_space::MOVE_BLOCK_TYPE, batch_rng, num_movable_blocks_per_type);
+        batch_agent.set_batch_size(batch_size);
+        vtr::RngContainer sequential_rng(1);
+        SoftmaxAgent sequential_agent(available_moves, e_agent_space::MOVE_BLOCK_TYPE, sequential_rng, num_movable_blocks_per_type);
+
+        for (int ibatch = 0; ibatch < 4; ibatch++) {
+            std::istringstream is(agent_state(batch_agent));
+            REQUIRE(sequential_agent.read_state(is));
+
+            for (int imove = 0; imove < batch_size; imove++) {
+                t_propose_action action = batch_agent.propose_action();
+                t_propose_action sequential_action = sequential_agent.propose_action();
+                REQUIRE(action.move_type == sequential_action.move_type);
+                REQUIRE(action.logical_blk_type_index == sequential_action.logical_blk_type_index);
+
+                // Strongly favour one move type, so the probabilities change
+                double reward = action.move_type == e_move_type::MEDIAN ? 2. : -2.;
+                batch_agent.process_outcome(reward, e_reward_function::BASIC);
+            }
+        }
+    }
+
+    logical_block_types.clear();
+}
+
+} // namespace
@@ -4,11 +4,16 @@
 #include "read_xml_arch_file.h"
 #include "rr_metadata.h"
 #include "rr_graph_writer.h"
+#include "rr_graph_uxsdcxx.h"
+#include "rr_graph_uxsdcxx_serializer.h"
+#include "rr_graph.h"
 #include "arch_util.h"
 #include "vpr_api.h"
 #include "echo_files.h"
 #include <cstring>
+#include <fstream>
 #include <random>
+#include <sstream>
 #include <vector>
 
 namespace {
@@ -233,6 +238,130 @@ TEST_CASE("read_rr_graph_metadata", "[vpr]") {
     vpr_free_all(arch, vpr_setup);
 }
 
+static std::string read_file(const char* filename) {
+    std::ifstream is(filename);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    return ss.str();
+}
+
+static void write_device_rr_graph(const char* filename) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
+    write_rr_graph(&mutable_device_ctx.rr_graph_builder,
+                   &mutable_device_ctx.rr_graph,
+                   device_ctx.physical_tile_types,
+                   &mutable_device_ctx.rr_indexed_data,
+                   &mutable_device_ctx.rr_rc_data,
+                   device_ctx.grid,
+                   device_ctx.arch_switch_inf,
+                   device_ctx.arch,
+                   &mutable_device_ctx.chan_width,
+                   filename,
+                   /*echo_enabled=*/false,
+                   /*echo_file_name=*/nullptr,
+                   false);
+}
+
+// The streaming XML loader used by --read_rr_graph and the generated DOM
+// loader must build the same RR graph, and writing it back out must give
+// back the file that was read.
+TEST_CASE("read_rr_graph_xml_stream", "[vpr]") {
+    static constexpr const char kWrittenFile[] = "test_read_rr_graph_xml_stream.xml";
+    static constexpr const char kStreamFile[] = "test_read_rr_graph_xml_stream_stream.xml";
+    static constexpr const char kDomFile[] = "test_read_rr_graph_xml_stream_dom.xml";
+
+    {
+        t_vpr_setup vpr_setup;
+        t_arch arch;
+        t_options options;
+        const char* argv[] = {
+            "test_vpr",
+            kArchFile,
+            "wire.eblif",
+            "--route_chan_width",
+            "100"};
+        vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+                 &options, &vpr_setup, &arch);
+        vpr_create_device(vpr_setup, arch);
+        write_device_rr_graph(kWrittenFile);
+        vpr_free_all(arch, vpr_setup);
+    }
+
+    t_vpr_setup vpr_setup;
+    t_arch arch;
+    t_options options;
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width",
+        "100",
+        "--read_rr_graph",
+        kWrittenFile};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+    vpr_create_device(vpr_setup, arch);
+    write_device_rr_graph(kStreamFile);
+
+    const std::string written = read_file(kWrittenFile);
+    REQUIRE(!written.empty());
+    REQUIRE(read_file(kStreamFile) == written);
+
+    // Load the same file again through the DOM loader
+    free_rr_graph();
+    {
+        const auto& device_ctx = g_vpr_ctx.device();
+        auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
+        t_det_routing_arch& det_routing_arch = vpr_setup.RoutingArch;
+
+        e_graph_type graph_type = (det_routing_arch.directionality == BI_DIRECTIONAL ? e_graph_type::BIDIR : e_graph_type::UNIDIR);
+        if (det_routing_arch.directionality == UNI_DIRECTIONAL && det_routing_arch.tileable) {
+            graph_type = e_graph_type::UNIDIR_TILEABLE;
+        }
+
+        RRGraphBuilder& rr_graph_builder = mutable_device_ctx.rr_graph_builder;
+        for (const t_segment_inf& segment : vpr_setup.Segments) {
+            rr_graph_builder.add_rr_segment(segment);
+        }
+
+        RrGraphSerializer reader(
+            graph_type,
+            vpr_setup.RouterOpts.base_cost_type,
+            &det_routing_arch.wire_to_rr_ipin_switch,
+            &det_routing_arch.wire_to_arch_ipin_switch_between_dice,
+            /*do_check_rr_graph=*/true,
+            kWrittenFile,
+            &mutable_device_ctx.loaded_rr_graph_filename,
+            /*read_edge_metadata=*/true,
+            /*echo_enabled=*/false,
+            /*echo_file_name=*/nullptr,
+            &mutable_device_ctx.chan_width,
+            &rr_graph_builder.rr_nodes(),
+            &rr_graph_builder,
+            &mutable_device_ctx.rr_graph,
+            &rr_graph_builder.rr_switch(),
+            &mutable_device_ctx.rr_indexed_data,
+            &mutable_device_ctx.rr_rc_data,
+            device_ctx.arch_switch_inf,
+            device_ctx.rr_graph.rr_segments(),
+            device_ctx.physical_tile_types,
+            device_ctx.grid,
+            &rr_graph_builder.rr_node_metadata(),
+            &rr_graph_builder.rr_edge_metadata(),
+            &arch.strings,
+            /*is_flat=*/false);
+
+        std::ifstream is(kWrittenFile);
+        void* context;
+        uxsd::load_rr_graph_xml(reader, context, kWrittenFile, is);
+    }
+    write_device_rr_graph(kDomFile);
+    REQUIRE(read_file(kDomFile) == written);
+
+    vpr_free_all(arch, vpr_setup);
+}
+
 TEST_CASE("read_rr_edge_override", "[vpr]") {
 
     const std::string RR_GRAPH_NAME = "test_read_rr_edge_override";